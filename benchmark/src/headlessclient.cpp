@@ -0,0 +1,469 @@
+/**
+ * benchmark/src/headlessclient.cpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "headlessclient.hpp"
+#include <boost/asio/connect.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/websocket/rfc6455.hpp>
+#include <zlib.h>
+#include <traintastic/enum/interfaceitemtype.hpp>
+#include <traintastic/enum/propertyflags.hpp>
+
+namespace websocket = boost::beast::websocket;
+
+static std::unique_ptr<Message> uncompress(const Message::Header& header, const uint8_t* data)
+{
+  // 32 bit big endian uncompressed size + zlib data:
+  if(header.dataSize < 4)
+    return {};
+  const uint32_t size = (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) | (static_cast<uint32_t>(data[2]) << 8) | data[3];
+
+  Message::Header uncompressedHeader = header;
+  uncompressedHeader.flags.compressed = 0;
+  uncompressedHeader.dataSize = size;
+  auto message = std::make_unique<Message>(uncompressedHeader);
+  uLongf outSize = size;
+  if(::uncompress(static_cast<Bytef*>(message->data()), &outSize, data + 4, header.dataSize - 4) != Z_OK || outSize != size)
+    return {};
+  return message;
+}
+
+const HeadlessClient::Value* HeadlessClient::Object::value(std::string_view name) const
+{
+  if(auto it = itemIds.find(std::string(name)); it != itemIds.end())
+    if(auto v = values.find(it->second); v != values.end())
+      return &v->second;
+  return nullptr;
+}
+
+HeadlessClient::HeadlessClient(boost::asio::io_context& ioContext, bool compression, bool propertyIds)
+  : m_resolver{ioContext}
+  , m_ws{ioContext}
+  , m_compression{compression}
+  , m_propertyIds{propertyIds}
+{
+}
+
+void HeadlessClient::connect(const std::string& host, uint16_t port, std::function<void(const ObjectPtr&)> callback)
+{
+  m_resolver.async_resolve(host, std::to_string(port),
+    [this, self=shared_from_this(), host, callback=std::move(callback)](const boost::system::error_code& ec, boost::asio::ip::tcp::resolver::results_type results)
+    {
+      if(ec)
+      {
+        failed("resolve", ec);
+        return callback(nullptr);
+      }
+
+      boost::beast::get_lowest_layer(m_ws).async_connect(results,
+        [this, self, host, callback](const boost::system::error_code& ecConnect, const boost::asio::ip::tcp::endpoint& endpoint)
+        {
+          if(ecConnect)
+          {
+            failed("connect", ecConnect);
+            return callback(nullptr);
+          }
+
+          boost::beast::get_lowest_layer(m_ws).expires_never();
+          m_ws.set_option(websocket::stream_base::timeout::suggested(boost::beast::role_type::client));
+          m_ws.binary(true);
+          m_ws.async_handshake(host + ":" + std::to_string(endpoint.port()), "/client",
+            [this, self, callback](const boost::system::error_code& ecHandshake)
+            {
+              if(ecHandshake)
+              {
+                failed("handshake", ecHandshake);
+                return callback(nullptr);
+              }
+
+              doRead();
+
+              auto login = Message::newRequest(Message::Command::Login);
+              login->write<std::string_view>(""); // username
+              login->write<std::string_view>(""); // password
+              login->write(static_cast<Message::Capabilities>(
+                static_cast<uint32_t>(Message::Capabilities::MultiMessageFrame) |
+                static_cast<uint32_t>(Message::Capabilities::TileStates) | // tile data isn't decoded
+                (m_compression ? static_cast<uint32_t>(Message::Capabilities::CompressedMessages) : 0) |
+                (m_propertyIds ? static_cast<uint32_t>(Message::Capabilities::PropertyIds) : 0)));
+              send(std::move(login),
+                [this, callback](const Message& loginResponse)
+                {
+                  if(loginResponse.isError())
+                    return callback(nullptr);
+
+                  // older servers don't reply with the capabilities they use:
+                  const auto capabilities = loginResponse.endOfMessage() ? Message::Capabilities::None : loginResponse.read<Message::Capabilities>();
+                  m_propertyIds = (static_cast<uint32_t>(capabilities) & static_cast<uint32_t>(Message::Capabilities::PropertyIds)) != 0;
+
+                  send(Message::newRequest(Message::Command::NewSession),
+                    [this, callback](const Message& sessionResponse)
+                    {
+                      if(sessionResponse.isError())
+                        return callback(nullptr);
+
+                      sessionResponse.read<std::array<uint8_t, 16>>(); // session uuid
+                      callback(readObject(sessionResponse));
+                    });
+                });
+            });
+        });
+    });
+}
+
+void HeadlessClient::close()
+{
+  m_requests.clear();
+  m_closing = true;
+  if(m_writeQueue.empty() && m_writing.empty()) // else closed when all messages are written
+    doClose();
+}
+
+void HeadlessClient::doClose()
+{
+  if(m_ws.is_open())
+    m_ws.async_close(websocket::close_code::normal, [self=shared_from_this()](const boost::system::error_code&) {});
+}
+
+void HeadlessClient::send(std::unique_ptr<Message> message)
+{
+  if(m_closing)
+    return;
+  const bool wasEmpty = m_writeQueue.empty() && m_writing.empty();
+  m_writeQueue.emplace_back(std::move(message));
+  if(wasEmpty)
+    doWrite();
+}
+
+void HeadlessClient::send(std::unique_ptr<Message> request, ResponseCallback callback)
+{
+  assert(request->isRequest());
+  m_requests.emplace(request->requestId(), std::move(callback));
+  send(std::move(request));
+}
+
+void HeadlessClient::doRead()
+{
+  m_ws.async_read(m_readBuffer,
+    [this, self=shared_from_this()](const boost::system::error_code& ec, std::size_t bytesTransferred)
+    {
+      if(ec)
+      {
+        if(ec != boost::asio::error::operation_aborted && ec != websocket::error::closed)
+          failed("read", ec);
+        return;
+      }
+
+      m_statistics.framesReceived++;
+      m_statistics.bytesReceived += bytesTransferred;
+
+      // a frame contains one or more messages:
+      const auto* data = static_cast<const uint8_t*>(m_readBuffer.cdata().data());
+      const size_t size = m_readBuffer.size();
+      size_t offset = 0;
+      while(offset + sizeof(Message::Header) <= size)
+      {
+        Message::Header header;
+        std::memcpy(&header, data + offset, sizeof(header));
+        if(offset + sizeof(header) + header.dataSize > size)
+          break; // incomplete message
+
+        std::unique_ptr<Message> message;
+        if(header.flags.compressed)
+        {
+          message = uncompress(header, data + offset + sizeof(header));
+          if(!message)
+          {
+            failed("uncompress", {});
+            return;
+          }
+        }
+        else
+        {
+          message = std::make_unique<Message>(header);
+          if(header.dataSize != 0)
+            std::memcpy(message->data(), data + offset + sizeof(header), header.dataSize);
+        }
+        offset += sizeof(header) + header.dataSize;
+        m_statistics.messagesReceived++;
+        process(*message);
+      }
+      m_readBuffer.consume(size);
+
+      doRead();
+    });
+}
+
+void HeadlessClient::doWrite()
+{
+  assert(m_writing.empty());
+  m_writing.swap(m_writeQueue);
+  m_writeBuffers.clear();
+  for(const auto& message : m_writing)
+    m_writeBuffers.emplace_back(**message, message->size());
+
+  m_ws.async_write(m_writeBuffers,
+    [this, self=shared_from_this()](const boost::system::error_code& ec, std::size_t /*bytesTransferred*/)
+    {
+      m_writing.clear();
+      if(ec)
+      {
+        if(ec != boost::asio::error::operation_aborted)
+          failed("write", ec);
+        return;
+      }
+      if(!m_writeQueue.empty())
+        doWrite();
+      else if(m_closing)
+        doClose();
+    });
+}
+
+void HeadlessClient::failed(std::string_view what, const boost::system::error_code& ec)
+{
+  if(onError)
+    onError(std::string(what).append(ec ? ": " + ec.message() : std::string{}));
+}
+
+void HeadlessClient::process(const Message& message)
+{
+  if(message.isResponse())
+  {
+    if(auto it = m_requests.find(message.requestId()); it != m_requests.end())
+    {
+      auto callback = std::move(it->second);
+      m_requests.erase(it);
+      callback(message);
+    }
+  }
+  else if(message.isEvent())
+  {
+    m_statistics.eventsReceived++;
+    processEvent(message);
+  }
+}
+
+void HeadlessClient::processEvent(const Message& message)
+{
+  switch(message.command())
+  {
+    case Message::Command::ObjectPropertyChanged:
+    {
+      const auto handle = message.read<Handle>();
+      auto it = m_objects.find(handle);
+      if(it == m_objects.end())
+        break;
+
+      Object& object = *it->second;
+      const auto itemId = readItemId(message, object);
+      if(!itemId)
+        break;
+      const auto type = message.read<ValueType>();
+      if(std::find(object.vectorProperties.begin(), object.vectorProperties.end(), *itemId) == object.vectorProperties.end())
+        object.values[*itemId] = readValue(message, type);
+
+      m_statistics.propertyChanges++;
+      if(onPropertyChanged)
+        onPropertyChanged(object, *itemId);
+      break;
+    }
+    case Message::Command::ObjectDestroyed:
+      m_objects.erase(message.read<Handle>());
+      break;
+
+    default: // only counted
+      break;
+  }
+}
+
+HeadlessClient::Value HeadlessClient::readValue(const Message& message, ValueType type)
+{
+  switch(type)
+  {
+    case ValueType::Boolean:
+      return message.read<bool>();
+
+    case ValueType::Enum:
+    case ValueType::Integer:
+    case ValueType::Set:
+      return message.read<int64_t>();
+
+    case ValueType::Float:
+      return message.read<double>();
+
+    case ValueType::String:
+    case ValueType::Object: // object id
+      return message.read<std::string>();
+
+    case ValueType::Invalid:
+      break;
+  }
+  return {};
+}
+
+std::optional<uint16_t> HeadlessClient::readItemId(const Message& message, const Object& object) const
+{
+  if(m_propertyIds)
+    return message.read<uint16_t>();
+  if(auto it = object.itemIds.find(message.read<std::string>()); it != object.itemIds.end())
+    return it->second;
+  return std::nullopt;
+}
+
+HeadlessClient::ObjectPtr HeadlessClient::readObject(const Message& message)
+{
+  ObjectPtr object;
+
+  message.readBlock(); // object
+  const auto handle = message.read<Handle>();
+  if(auto it = m_objects.find(handle); it != m_objects.end())
+  {
+    object = it->second;
+  }
+  else
+  {
+    object = std::make_shared<Object>();
+    object->handle = handle;
+    message.read(object->classId);
+
+    message.readBlock(); // items
+    while(!message.endOfBlock())
+    {
+      message.readBlock(); // item
+      const auto name = message.read<std::string>();
+      const auto id = m_propertyIds ? message.read<uint16_t>() : static_cast<uint16_t>(object->itemIds.size());
+      const auto itemType = message.read<InterfaceItemType>();
+      if(itemType == InterfaceItemType::Property || itemType == InterfaceItemType::UnitProperty || itemType == InterfaceItemType::VectorProperty)
+      {
+        message.read<PropertyFlags>();
+        const auto type = message.read<ValueType>();
+        if(type == ValueType::Enum || type == ValueType::Set)
+          message.read<std::string_view>(); // enum/set name
+
+        if(itemType == InterfaceItemType::VectorProperty)
+          object->vectorProperties.push_back(id);
+        else
+          object->values.emplace(id, readValue(message, type));
+      }
+      object->itemIds.emplace(name, id);
+      object->itemNames.emplace(id, name);
+      message.readBlockEnd(); // end item, skips attributes
+    }
+    message.readBlockEnd(); // end items
+
+    m_objects.emplace(handle, object);
+  }
+  message.readBlockEnd(); // end object
+
+  return object;
+}
+
+void HeadlessClient::getObject(std::string_view id, std::function<void(const ObjectPtr&)> callback)
+{
+  auto request = Message::newRequest(Message::Command::GetObject);
+  request->write(id);
+  send(std::move(request),
+    [this, callback=std::move(callback)](const Message& response)
+    {
+      callback(response.isError() ? nullptr : readObject(response));
+    });
+}
+
+void HeadlessClient::getObjects(const Object& list, uint32_t startIndex, uint32_t endIndex, std::function<void(std::vector<ObjectPtr>)> callback)
+{
+  auto request = Message::newRequest(Message::Command::ObjectListGetObjects);
+  request->write(list.handle);
+  request->write(startIndex);
+  request->write(endIndex);
+  send(std::move(request),
+    [this, callback=std::move(callback)](const Message& response)
+    {
+      std::vector<ObjectPtr> objects;
+      if(!response.isError())
+        while(!response.endOfMessage())
+          objects.emplace_back(readObject(response));
+      callback(std::move(objects));
+    });
+}
+
+void HeadlessClient::getTableModel(const Object& object, std::function<void(Handle, uint32_t, uint32_t)> callback)
+{
+  auto request = Message::newRequest(Message::Command::GetTableModel);
+  request->write(object.handle);
+  send(std::move(request),
+    [callback=std::move(callback)](const Message& response)
+    {
+      if(response.isError())
+        return callback(0, 0, 0);
+
+      response.readBlock(); // model
+      const auto handle = response.read<Handle>();
+      response.read<std::string_view>(); // class id
+      const auto columnCount = response.read<uint32_t>();
+      for(uint32_t i = 0; i < columnCount; i++)
+        response.read<std::string_view>(); // column header
+      const auto rowCount = response.read<uint32_t>();
+      response.readBlockEnd(); // end model
+
+      callback(handle, columnCount, rowCount);
+    });
+}
+
+void HeadlessClient::setTableModelRegion(Handle model, uint32_t columnMin, uint32_t columnMax, uint32_t rowMin, uint32_t rowMax)
+{
+  auto event = Message::newEvent(Message::Command::TableModelSetRegion);
+  event->write(model);
+  event->write(columnMin);
+  event->write(columnMax);
+  event->write(rowMin);
+  event->write(rowMax);
+  send(std::move(event));
+}
+
+void HeadlessClient::getTileData(const Object& board, std::function<void(bool)> callback)
+{
+  auto request = Message::newRequest(Message::Command::BoardGetTileData);
+  request->write(board.handle);
+  send(std::move(request),
+    [callback=std::move(callback)](const Message& response)
+    {
+      callback(!response.isError()); // tile data isn't decoded, the benchmark only needs the load
+    });
+}
+
+bool HeadlessClient::setProperty(const Object& object, std::string_view name, std::string_view value)
+{
+  auto it = object.itemIds.find(std::string(name));
+  if(it == object.itemIds.end())
+    return false;
+
+  auto event = Message::newEvent(Message::Command::ObjectSetProperty);
+  event->write(object.handle);
+  if(m_propertyIds)
+    event->write(it->second);
+  else
+    event->write(name);
+  event->write(ValueType::String);
+  event->write(value);
+  send(std::move(event));
+  return true;
+}
@@ -0,0 +1,145 @@
+/**
+ * benchmark/src/headlessclient.hpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TRAINTASTIC_BENCHMARK_HEADLESSCLIENT_HPP
+#define TRAINTASTIC_BENCHMARK_HEADLESSCLIENT_HPP
+
+#include <memory>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/beast/websocket/stream.hpp>
+#include <traintastic/enum/valuetype.hpp>
+#include <traintastic/network/message.hpp>
+
+/**
+ * \brief Minimal client for the traintastic protocol, without Qt
+ *
+ * Speaks the same protocol as the Qt client, but only keeps what is needed
+ * to subscribe to objects and to observe changes: interface item ids and
+ * scalar property values. All callbacks are called in the IO context.
+ *
+ * If the server doesn't use Message::Capabilities::PropertyIds, interface
+ * items are referenced by name on the wire and the item ids are assigned by
+ * the client.
+ */
+class HeadlessClient : public std::enable_shared_from_this<HeadlessClient>
+{
+  public:
+    using Handle = uint32_t;
+    using Value = std::variant<std::monostate, bool, int64_t, double, std::string>;
+
+    struct Object
+    {
+      Handle handle;
+      std::string classId;
+      std::unordered_map<std::string, uint16_t> itemIds;
+      std::unordered_map<uint16_t, std::string> itemNames;
+      std::unordered_map<uint16_t, Value> values; //!< scalar properties only
+      std::vector<uint16_t> vectorProperties;
+
+      const Value* value(std::string_view name) const;
+    };
+
+    using ObjectPtr = std::shared_ptr<Object>;
+    using ResponseCallback = std::function<void(const Message& response)>;
+
+    struct Statistics
+    {
+      uint64_t framesReceived = 0;
+      uint64_t messagesReceived = 0;
+      uint64_t bytesReceived = 0; //!< WebSocket payload
+      uint64_t eventsReceived = 0;
+      uint64_t propertyChanges = 0;
+    };
+
+  private:
+    boost::asio::ip::tcp::resolver m_resolver;
+    boost::beast::websocket::stream<boost::beast::tcp_stream> m_ws;
+    boost::beast::flat_buffer m_readBuffer;
+    std::vector<std::shared_ptr<const Message>> m_writeQueue;
+    std::vector<std::shared_ptr<const Message>> m_writing;
+    std::vector<boost::asio::const_buffer> m_writeBuffers;
+    std::unordered_map<uint16_t, ResponseCallback> m_requests;
+    std::unordered_map<Handle, ObjectPtr> m_objects;
+    Statistics m_statistics;
+    bool m_compression;
+    bool m_propertyIds; //!< requested at login, cleared if the server doesn't use it
+    bool m_closing = false;
+
+    void doRead();
+    void doWrite();
+    void doClose();
+    void failed(std::string_view what, const boost::system::error_code& ec);
+
+    void process(const Message& message);
+    void processEvent(const Message& message);
+
+    static Value readValue(const Message& message, ValueType type);
+    std::optional<uint16_t> readItemId(const Message& message, const Object& object) const;
+
+  public:
+    std::function<void(std::string_view error)> onError;
+    std::function<void(Object& object, uint16_t itemId)> onPropertyChanged;
+
+    HeadlessClient(boost::asio::io_context& ioContext, bool compression, bool propertyIds = true);
+
+    const Statistics& statistics() const { return m_statistics; }
+    bool propertyIds() const { return m_propertyIds; }
+    void resetStatistics() { m_statistics = {}; }
+
+    /**
+     * \brief Connect, login and create a new session
+     * \param[in] callback Called with the traintastic object, or \c nullptr on failure
+     */
+    void connect(const std::string& host, uint16_t port, std::function<void(const ObjectPtr&)> callback);
+
+    /**
+     * \brief Close connection after all queued messages are written
+     */
+    void close();
+
+    void send(std::unique_ptr<Message> message);
+    void send(std::unique_ptr<Message> request, ResponseCallback callback);
+
+    /**
+     * \brief Read an object as written by Session::writeObject()
+     */
+    ObjectPtr readObject(const Message& message);
+
+    void getObject(std::string_view id, std::function<void(const ObjectPtr&)> callback);
+    void getObjects(const Object& list, uint32_t startIndex, uint32_t endIndex, std::function<void(std::vector<ObjectPtr>)> callback);
+    void getTableModel(const Object& object, std::function<void(Handle model, uint32_t columnCount, uint32_t rowCount)> callback);
+    void setTableModelRegion(Handle model, uint32_t columnMin, uint32_t columnMax, uint32_t rowMin, uint32_t rowMax);
+    void getTileData(const Object& board, std::function<void(bool success)> callback);
+    bool setProperty(const Object& object, std::string_view name, std::string_view value);
+};
+
+#endif
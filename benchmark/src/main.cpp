@@ -0,0 +1,388 @@
+/**
+ * benchmark/src/main.cpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#ifdef __linux__
+  #include <fstream>
+  #include <sstream>
+  #include <unistd.h>
+#endif
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include "options.hpp"
+#include "headlessclient.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr std::string_view probePrefix = "benchmark-";
+static constexpr auto connectTimeout = std::chrono::seconds(60);
+static constexpr auto probeGracePeriod = std::chrono::milliseconds(500); //!< wait for in flight probes
+
+//! World name changes sent by the first client, received by all clients.
+class LatencyProbes
+{
+  private:
+    mutable std::mutex m_mutex;
+    std::vector<Clock::time_point> m_sent;
+    std::vector<double> m_latencies; //!< milliseconds
+
+  public:
+    uint32_t send()
+    {
+      std::lock_guard lock(m_mutex);
+      m_sent.emplace_back(Clock::now());
+      return static_cast<uint32_t>(m_sent.size() - 1);
+    }
+
+    void received(std::string_view name)
+    {
+      const auto now = Clock::now();
+      if(name.substr(0, probePrefix.size()) != probePrefix)
+        return;
+      const uint32_t seq = std::strtoul(std::string(name.substr(probePrefix.size())).c_str(), nullptr, 10);
+
+      std::lock_guard lock(m_mutex);
+      if(seq < m_sent.size())
+        m_latencies.emplace_back(std::chrono::duration<double, std::milli>(now - m_sent[seq]).count());
+    }
+
+    size_t sentCount() const
+    {
+      std::lock_guard lock(m_mutex);
+      return m_sent.size();
+    }
+
+    std::vector<double> latencies() const
+    {
+      std::lock_guard lock(m_mutex);
+      std::vector<double> r{m_latencies};
+      std::sort(r.begin(), r.end());
+      return r;
+    }
+};
+
+static double percentile(const std::vector<double>& sorted, double p)
+{
+  const size_t index = std::min(sorted.size() - 1, static_cast<size_t>(p / 100 * static_cast<double>(sorted.size())));
+  return sorted[index];
+}
+
+//! \return Process CPU time in seconds, or a negative value if unavailable
+static double processCpuTime([[maybe_unused]] int pid)
+{
+#ifdef __linux__
+  std::ifstream file("/proc/" + std::to_string(pid) + "/stat");
+  std::string line;
+  if(pid > 0 && std::getline(file, line))
+  {
+    // skip pid and (comm), comm may contain spaces:
+    const auto pos = line.rfind(')');
+    if(pos != std::string::npos)
+    {
+      std::istringstream fields(line.substr(pos + 2));
+      std::string field;
+      for(int i = 3; i < 14; i++) // field 3 (state) ... 13
+        fields >> field;
+      unsigned long long utime = 0;
+      unsigned long long stime = 0;
+      if(fields >> utime >> stime)
+        return static_cast<double>(utime + stime) / static_cast<double>(sysconf(_SC_CLK_TCK));
+    }
+  }
+#endif
+  return -1;
+}
+
+//! Subscribe to the lists a typical operator station shows: boards, trains and inputs.
+static void subscribe(const std::shared_ptr<HeadlessClient>& client, uint32_t objectsMax, std::function<void()> done)
+{
+  static constexpr std::array<std::string_view, 3> lists{{"boards", "trains", "inputs"}};
+
+  auto pending = std::make_shared<size_t>(lists.size());
+  auto finished =
+    [pending, done=std::move(done)]()
+    {
+      if(--*pending == 0)
+        done();
+    };
+
+  for(auto name : lists)
+  {
+    const bool isBoardList = (name == "boards");
+    client->getObject(std::string("traintastic.world.").append(name),
+      [client, objectsMax, isBoardList, pending, finished](const HeadlessClient::ObjectPtr& list)
+      {
+        if(!list)
+          return finished();
+
+        client->getTableModel(*list,
+          [client](HeadlessClient::Handle model, uint32_t columnCount, uint32_t rowCount)
+          {
+            if(model != 0 && columnCount != 0 && rowCount != 0)
+              client->setTableModelRegion(model, 0, columnCount - 1, 0, rowCount - 1);
+          });
+
+        const auto* length = list->value("length");
+        const uint32_t count = (length && std::holds_alternative<int64_t>(*length)) ? std::min<uint32_t>(static_cast<uint32_t>(std::get<int64_t>(*length)), objectsMax) : 0;
+        if(count == 0)
+          return finished();
+
+        client->getObjects(*list, 0, count - 1,
+          [client, isBoardList, pending, finished](std::vector<HeadlessClient::ObjectPtr> objects)
+          {
+            if(isBoardList)
+            {
+              for(const auto& board : objects)
+              {
+                (*pending)++;
+                client->getTileData(*board, [finished](bool /*success*/) { finished(); });
+              }
+            }
+            finished();
+          });
+      });
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  // parse command line options:
+  const Options options(argc, argv);
+
+  std::vector<std::unique_ptr<boost::asio::io_context>> ioContexts;
+  std::vector<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> workGuards;
+  for(unsigned int i = 0; i < options.threads; i++)
+  {
+    ioContexts.emplace_back(std::make_unique<boost::asio::io_context>(1));
+    workGuards.emplace_back(ioContexts.back()->get_executor());
+  }
+
+  std::mutex mutex;
+  std::condition_variable connectedChanged;
+  unsigned int connected = 0;
+  unsigned int failed = 0;
+  LatencyProbes probes;
+  HeadlessClient::ObjectPtr world; //!< world object of first client
+  std::string worldName;
+
+  // connect all clients, the first one sends the probes:
+  std::vector<std::shared_ptr<HeadlessClient>> clients;
+  for(unsigned int i = 0; i < options.clients; i++)
+  {
+    auto& ioContext = *ioContexts[i % ioContexts.size()];
+    auto client = std::make_shared<HeadlessClient>(ioContext, options.compression, !options.propertyNames);
+    client->onError =
+      [&mutex, i](std::string_view error)
+      {
+        std::lock_guard lock(mutex);
+        std::cerr << "client " << i << ": " << error << std::endl;
+      };
+
+    auto connectFailed =
+      [&]()
+      {
+        std::lock_guard lock(mutex);
+        failed++;
+        connectedChanged.notify_all();
+      };
+
+    boost::asio::post(ioContext,
+      [&, client, i, connectFailed]()
+      {
+        client->connect(options.host, options.port,
+          [&, client, i, connectFailed](const HeadlessClient::ObjectPtr& traintastic)
+          {
+            if(!traintastic)
+              return connectFailed();
+
+            client->getObject("traintastic.world",
+              [&, client, i, connectFailed](const HeadlessClient::ObjectPtr& clientWorld)
+              {
+                if(!clientWorld || !clientWorld->itemIds.count("name"))
+                {
+                  std::lock_guard lock(mutex);
+                  std::cerr << "client " << i << ": no world loaded" << std::endl;
+                  failed++;
+                  connectedChanged.notify_all();
+                  return;
+                }
+
+                client->onPropertyChanged =
+                  [&probes, handle=clientWorld->handle, nameId=clientWorld->itemIds.at("name")](HeadlessClient::Object& object, uint16_t itemId)
+                  {
+                    if(object.handle != handle || itemId != nameId)
+                      return;
+                    if(const auto* name = std::get_if<std::string>(&object.values[itemId]))
+                      probes.received(*name);
+                  };
+
+                subscribe(client, options.objectsMax,
+                  [&, clientWorld, i]()
+                  {
+                    std::lock_guard lock(mutex);
+                    if(i == 0)
+                    {
+                      world = clientWorld;
+                      if(const auto* name = std::get_if<std::string>(clientWorld->value("name")))
+                        worldName = *name;
+                    }
+                    connected++;
+                    connectedChanged.notify_all();
+                  });
+              });
+          });
+      });
+
+    clients.emplace_back(std::move(client));
+  }
+
+  std::vector<std::thread> threads;
+  for(auto& ioContext : ioContexts)
+    threads.emplace_back([&ioContext]() { ioContext->run(); });
+
+  auto stopThreads =
+    [&]()
+    {
+      for(size_t i = 0; i < clients.size(); i++)
+        boost::asio::post(*ioContexts[i % ioContexts.size()], [client=clients[i]]() { client->close(); });
+      workGuards.clear();
+      for(auto& thread : threads)
+        thread.join();
+    };
+
+  {
+    std::unique_lock lock(mutex);
+    const bool done = connectedChanged.wait_for(lock, connectTimeout, [&]() { return connected + failed == options.clients; });
+    if(!done || failed != 0)
+    {
+      std::cerr << "Error: " << connected << " of " << options.clients << " clients connected." << std::endl;
+      lock.unlock();
+      for(auto& ioContext : ioContexts)
+        ioContext->stop();
+      for(auto& thread : threads)
+        thread.join();
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << options.clients << " clients connected, measuring for " << options.duration << " seconds..." << std::endl;
+
+  // start measurement:
+  for(size_t i = 0; i < clients.size(); i++)
+    boost::asio::post(*ioContexts[i % ioContexts.size()], [client=clients[i]]() { client->resetStatistics(); });
+  const double cpuStart = processCpuTime(options.serverPid);
+  const auto start = Clock::now();
+
+  boost::asio::steady_timer probeTimer{*ioContexts[0]};
+  std::function<void()> probe =
+    [&]()
+    {
+      probeTimer.expires_after(std::chrono::milliseconds(options.probeInterval));
+      probeTimer.async_wait(
+        [&](const boost::system::error_code& ec)
+        {
+          if(ec)
+            return;
+          clients[0]->setProperty(*world, "name", std::string(probePrefix).append(std::to_string(probes.send())));
+          probe();
+        });
+    };
+  boost::asio::post(*ioContexts[0], probe);
+
+  std::this_thread::sleep_for(std::chrono::seconds(options.duration));
+  boost::asio::post(*ioContexts[0], [&]() { probeTimer.cancel(); });
+  std::this_thread::sleep_for(probeGracePeriod);
+
+  // collect statistics, each client in its own thread:
+  HeadlessClient::Statistics total;
+  unsigned int collected = 0;
+  for(size_t i = 0; i < clients.size(); i++)
+  {
+    boost::asio::post(*ioContexts[i % ioContexts.size()],
+      [&, client=clients[i]]()
+      {
+        const auto& statistics = client->statistics();
+        std::lock_guard lock(mutex);
+        total.framesReceived += statistics.framesReceived;
+        total.messagesReceived += statistics.messagesReceived;
+        total.bytesReceived += statistics.bytesReceived;
+        total.eventsReceived += statistics.eventsReceived;
+        total.propertyChanges += statistics.propertyChanges;
+        collected++;
+        connectedChanged.notify_all();
+      });
+  }
+  {
+    std::unique_lock lock(mutex);
+    connectedChanged.wait(lock, [&]() { return collected == clients.size(); });
+  }
+  const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  const double cpuEnd = processCpuTime(options.serverPid);
+
+  // restore world name and disconnect:
+  boost::asio::post(*ioContexts[0], [&]() { clients[0]->setProperty(*world, "name", worldName); });
+  stopThreads();
+
+  // report:
+  const auto latencies = probes.latencies();
+  const size_t probesExpected = probes.sentCount() * clients.size();
+  const double n = static_cast<double>(clients.size());
+
+  std::cout << std::fixed << std::setprecision(1)
+    << "clients:      " << clients.size() << " (" << options.threads << " threads)" << std::endl
+    << "duration:     " << elapsed << " s" << std::endl
+    << "messages:     " << static_cast<double>(total.messagesReceived) / elapsed << " /s (" << static_cast<double>(total.messagesReceived) / elapsed / n << " /s per client)" << std::endl
+    << "frames:       " << static_cast<double>(total.framesReceived) / elapsed << " /s" << std::endl
+    << "bytes:        " << static_cast<double>(total.bytesReceived) / elapsed / 1024 << " KiB/s (" << static_cast<double>(total.bytesReceived) / elapsed / 1024 / n << " KiB/s per client)" << std::endl
+    << "events:       " << static_cast<double>(total.eventsReceived) / elapsed << " /s (" << total.propertyChanges << " property changes)" << std::endl;
+
+  std::cout << std::setprecision(2) << "latency:      ";
+  if(!latencies.empty())
+  {
+    double sum = 0;
+    for(double latency : latencies)
+      sum += latency;
+    std::cout
+      << "min " << latencies.front()
+      << ", avg " << sum / static_cast<double>(latencies.size())
+      << ", p50 " << percentile(latencies, 50)
+      << ", p95 " << percentile(latencies, 95)
+      << ", p99 " << percentile(latencies, 99)
+      << ", max " << latencies.back() << " ms" << std::endl;
+  }
+  else
+    std::cout << "-" << std::endl;
+  std::cout << "probes:       " << probes.sentCount() << " sent, " << latencies.size() << " of " << probesExpected << " received"
+    << " (missing probes are coalesced by the server or lost)" << std::endl;
+
+  if(cpuStart >= 0 && cpuEnd >= 0)
+    std::cout << std::setprecision(1) << "server CPU:   " << (cpuEnd - cpuStart) / elapsed * 100 << " %" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+/**
+ * benchmark/src/options.hpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TRAINTASTIC_BENCHMARK_OPTIONS_HPP
+#define TRAINTASTIC_BENCHMARK_OPTIONS_HPP
+
+#include <iostream>
+#include <boost/program_options.hpp>
+#include <version.hpp>
+
+struct Options
+{
+  std::string host;
+  uint16_t port;
+  unsigned int clients;
+  unsigned int threads;
+  unsigned int duration; //!< seconds
+  unsigned int probeInterval; //!< milliseconds
+  unsigned int objectsMax; //!< per list
+  bool compression;
+  bool propertyNames;
+  int serverPid;
+
+  Options(int argc , char* argv[])
+  {
+    boost::program_options::options_description desc{"Options for traintastic-benchmark"};
+    desc.add_options()
+      ("help,h", "display this help text and exit")
+      ("version,v", "output version information and exit")
+      ("host,H", boost::program_options::value<std::string>(&host)->value_name("HOST")->default_value("localhost"), "server host")
+      ("port,p", boost::program_options::value<uint16_t>(&port)->value_name("PORT")->default_value(5740), "server port")
+      ("clients,c", boost::program_options::value<unsigned int>(&clients)->value_name("N")->default_value(10), "number of client sessions")
+      ("threads,t", boost::program_options::value<unsigned int>(&threads)->value_name("N")->default_value(1), "number of client threads")
+      ("duration,d", boost::program_options::value<unsigned int>(&duration)->value_name("SECONDS")->default_value(30), "measurement duration")
+      ("probe-interval,i", boost::program_options::value<unsigned int>(&probeInterval)->value_name("MILLISECONDS")->default_value(100), "event latency probe interval")
+      ("objects-max", boost::program_options::value<unsigned int>(&objectsMax)->value_name("N")->default_value(1000), "maximum number of objects to subscribe to per list")
+      ("compression", "request compressed messages")
+      ("property-names", "reference properties by name instead of id, like older clients")
+      ("server-pid", boost::program_options::value<int>(&serverPid)->value_name("PID")->default_value(0), "measure CPU usage of server process (Linux only)")
+      ;
+
+    boost::program_options::variables_map vm;
+
+    try
+    {
+      boost::program_options::store(parse_command_line(argc, argv, desc), vm);
+
+      if(vm.count("help"))
+      {
+        std::cout
+          << desc << std::endl
+          << "NOTES:"<< std::endl
+          << "1. Event latency is probed by renaming the world, use a scratch world! The original name is restored at exit." << std::endl
+          << "2. Start the server with --simulate --online --power --run to benchmark a running world."
+          << std::endl
+          ;
+        exit(EXIT_SUCCESS);
+      }
+
+      if(vm.count("version"))
+      {
+        std::cout << TRAINTASTIC_VERSION_FULL << std::endl;
+        exit(EXIT_SUCCESS);
+      }
+
+      compression = vm.count("compression");
+      propertyNames = vm.count("property-names");
+
+      boost::program_options::notify(vm);
+
+      if(clients == 0 || threads == 0 || duration == 0 || probeInterval == 0)
+      {
+        std::cerr << "Error: --clients, --threads, --duration and --probe-interval must be greater than zero." << std::endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+    catch(const boost::program_options::error& e)
+    {
+      std::cerr << e.what() << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+};
+
+#endif
@@ -217,6 +217,10 @@ void ConnectDialog::stateChanged()
       m_status->setText(Locale::tr("qtapp.connect_dialog:fetching_world"));
       break;
 
+    case Connection::State::Reconnecting:
+      m_status->setText(Locale::tr("qtapp.connect_dialog:reconnecting"));
+      break;
+
     case Connection::State::SocketError:
       m_status->setText(m_connection->errorString());
       setControlsEnabled(true);
@@ -159,6 +159,19 @@ void Board::processMessage(const Message& message)
       emit tileDataChanged();
       break;
     }
+    case Message::Command::BoardTileStatesChanged:
+    {
+      const auto count = message.read<uint32_t>();
+      for(uint32_t i = 0; i < count; i++)
+      {
+        const auto l = message.read<TileLocation>();
+        const auto state = message.read<uint8_t>();
+        if(auto it = m_tileData.find(l); it != m_tileData.end())
+          it->second.state = state;
+      }
+      emit tileDataChanged();
+      break;
+    }
     default:
       Object::processMessage(message);
       break;
@@ -136,6 +136,14 @@ Connection::Connection() :
   m_worldRequestId{invalidRequestId}
   , m_serverLogTableModel{nullptr}
 {
+  m_reconnectTimer.setSingleShot(true);
+  m_reconnectTimer.setInterval(reconnectInterval);
+  connect(&m_reconnectTimer, &QTimer::timeout, this,
+    [this]()
+    {
+      m_socket->open(m_url);
+    });
+
   connect(m_socket, &QWebSocket::connected, this, &Connection::socketConnected);
   connect(m_socket, &QWebSocket::disconnected, this, &Connection::socketDisconnected);
 #if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
@@ -147,19 +155,45 @@ Connection::Connection() :
   connect(m_socket, &QWebSocket::binaryMessageReceived,
     [this](const QByteArray& data)
     {
-      const Message::Header& header = *reinterpret_cast<const Message::Header*>(data.data());
-      auto message = std::make_shared<Message>(header);
-      if(header.dataSize != 0)
+      // a frame can contain multiple messages, see Message::Capabilities::MultiMessageFrame
+      const size_t size = static_cast<size_t>(data.size());
+      size_t offset = 0;
+      while(size - offset >= sizeof(Message::Header))
       {
-        std::memcpy(message->data(), data.data() + sizeof(header), message->dataSize());
+        const Message::Header& header = *reinterpret_cast<const Message::Header*>(data.data() + offset);
+        if(size - offset < sizeof(header) + header.dataSize) /*[[unlikely]]*/
+          break; // incomplete message
+        std::shared_ptr<Message> message;
+        if(header.flags.compressed)
+        {
+          // 32 bit big endian uncompressed size + zlib data, same format as qUncompress uses
+          const QByteArray uncompressed = qUncompress(reinterpret_cast<const uchar*>(data.data() + offset + sizeof(header)), static_cast<int>(header.dataSize));
+          Message::Header uncompressedHeader = header;
+          uncompressedHeader.flags.compressed = 0;
+          uncompressedHeader.dataSize = static_cast<uint32_t>(uncompressed.size());
+          message = std::make_shared<Message>(uncompressedHeader);
+          if(!uncompressed.isEmpty())
+          {
+            std::memcpy(message->data(), uncompressed.data(), message->dataSize());
+          }
+        }
+        else
+        {
+          message = std::make_shared<Message>(header);
+          if(header.dataSize != 0)
+          {
+            std::memcpy(message->data(), data.data() + offset + sizeof(header), message->dataSize());
+          }
+        }
+        offset += sizeof(header) + header.dataSize;
+        processMessage(message);
       }
-      processMessage(message);
     });
 }
 
 bool Connection::isDisconnected() const
 {
-  return m_state != State::Connected && m_state != State::Connecting && m_state != State::Disconnecting;
+  return m_state != State::Connected && m_state != State::Connecting && m_state != State::Disconnecting && m_state != State::Reconnecting;
 }
 
 Connection::SocketError Connection::error() const
@@ -184,6 +218,7 @@ quint16 Connection::peerPort() const
 
 void Connection::connectToHost(const QUrl& url, const QString& username, const QString& password)
 {
+  m_url = url;
   m_username = username;
   if(password.isEmpty())
     m_password.clear();
@@ -195,6 +230,12 @@ void Connection::connectToHost(const QUrl& url, const QString& username, const Q
 
 void Connection::disconnectFromHost()
 {
+  m_sessionUUID = QUuid(); // don't resume
+  if(m_state == State::Reconnecting)
+  {
+    m_reconnectTimer.stop();
+    setState(State::Disconnected);
+  }
   m_socket->close();
 }
 
@@ -208,6 +249,14 @@ void Connection::cancelRequest(int requestId)
     m_requestCallback.erase(it);
 }
 
+void Connection::writeInterfaceItem(Message& message, const InterfaceItem& item) const
+{
+  if(m_propertyIds)
+    message.write(item.id());
+  else
+    message.write(item.name().toLatin1());
+}
+
 QString Connection::worldUUID() const
 {
   if(!m_world)
@@ -505,8 +554,7 @@ int Connection::getTileData(Board& object)
 void Connection::send(std::unique_ptr<Message>& message)
 {
   Q_ASSERT(!message->isRequest());
-  QByteArray bytes(static_cast<const char*>(**message), message->size()); // Deep copy :(
-  m_socket->sendBinaryMessage(bytes); // sendBinaryMessage only supports QByteArray
+  write(*message);
 }
 
 void Connection::send(std::unique_ptr<Message>& message, std::function<void(const std::shared_ptr<Message>&)> callback)
@@ -514,8 +562,29 @@ void Connection::send(std::unique_ptr<Message>& message, std::function<void(cons
   Q_ASSERT(message->isRequest());
   Q_ASSERT(!m_requestCallback.contains(message->requestId()));
   m_requestCallback[message->requestId()] = callback;
-  QByteArray bytes(static_cast<const char*>(**message), message->size()); // Deep copy :(
-  m_socket->sendBinaryMessage(bytes); // sendBinaryMessage only supports QByteArray
+  write(*message);
+}
+
+void Connection::write(const Message& message)
+{
+  QByteArray bytes(static_cast<const char*>(*message), message.size()); // Deep copy :(
+
+  const bool sessionMessage = !m_sessionUUID.isNull() && message.command() != Message::Command::Login && message.command() != Message::Command::ResumeSession;
+  if(sessionMessage)
+  {
+    // keep the last sent messages, they are resent if the server didn't receive them:
+    m_sendCount++;
+    m_sendJournal.emplace_back(bytes); // implicitly shared, no copy
+    m_sendJournalSize += static_cast<size_t>(bytes.size());
+    while(m_sendJournalSize > sendJournalSizeMax && m_sendJournal.size() > 1)
+    {
+      m_sendJournalSize -= static_cast<size_t>(m_sendJournal.front().size());
+      m_sendJournal.pop_front();
+    }
+  }
+
+  if(!sessionMessage || m_state != State::Reconnecting) // while reconnecting they are sent after the session is resumed
+    m_socket->sendBinaryMessage(bytes); // sendBinaryMessage only supports QByteArray
 }
 
 ObjectPtr Connection::readObject(const Message& message)
@@ -568,6 +637,7 @@ ObjectPtr Connection::readObject(const Message& message)
       message.readBlock(); // item
       InterfaceItem* item = nullptr;
       const QString name = QString::fromLatin1(message.read<QByteArray>());
+      const quint16 id = m_propertyIds ? message.read<quint16>() : 0;
       const InterfaceItemType type = message.read<InterfaceItemType>();
       switch(type)
       {
@@ -713,6 +783,7 @@ ObjectPtr Connection::readObject(const Message& message)
         }
         message.readBlockEnd(); // end attributes
 
+        item->m_id = id;
         obj->m_interfaceItems.add(*item);
       }
       message.readBlockEnd(); // end item
@@ -729,6 +800,13 @@ ObjectPtr Connection::readObject(const Message& message)
   return obj;
 }
 
+InterfaceItem* Connection::readInterfaceItem(const Message& message, Object& object) const
+{
+  if(m_propertyIds)
+    return object.interfaceItems().findById(message.read<quint16>());
+  return object.getInterfaceItem(QString::fromLatin1(message.read<QByteArray>()));
+}
+
 TableModelPtr Connection::readTableModel(const Message& message)
 {
   message.readBlock(); // model
@@ -783,6 +861,9 @@ void Connection::setState(State state)
 
 void Connection::processMessage(const std::shared_ptr<Message> message)
 {
+  if(message->command() != Message::Command::Login)
+    m_receiveCount++; // NewSession response resets it
+
   if(message->isResponse())
   {
     auto it = m_requestCallback.find(message->requestId());
@@ -811,10 +892,10 @@ void Connection::processMessage(const std::shared_ptr<Message> message)
       case Message::Command::ObjectPropertyChanged:
         if(ObjectPtr object = m_objects.value(message->read<Handle>()).lock())
         {
-          const QString name = QString::fromLatin1(message->read<QByteArray>());
+          InterfaceItem* item = readInterfaceItem(*message, *object);
           const ValueType valueType = message->read<ValueType>();
 
-          if(AbstractProperty* property = object->getProperty(name))
+          if(auto* property = dynamic_cast<AbstractProperty*>(item))
           {
             switch(valueType)
             {
@@ -887,7 +968,7 @@ void Connection::processMessage(const std::shared_ptr<Message> message)
                 break;
             }
           }
-          else if(AbstractVectorProperty* vectorProperty = object->getVectorProperty(name))
+          else if(auto* vectorProperty = dynamic_cast<AbstractVectorProperty*>(item))
           {
             const int length = message->read<int>(); // read uint32_t as int, Qt uses int for length
 
@@ -904,7 +985,7 @@ void Connection::processMessage(const std::shared_ptr<Message> message)
       case Message::Command::ObjectAttributeChanged:
         if(ObjectPtr object = m_objects.value(message->read<Handle>()).lock())
         {
-          if(InterfaceItem* item = object->getInterfaceItem(QString::fromLatin1(message->read<QByteArray>())))
+          if(InterfaceItem* item = readInterfaceItem(*message, *object))
           {
             AttributeName attributeName = message->read<AttributeName>();
             const ValueType type = message->read<ValueType>();
@@ -1048,6 +1129,7 @@ void Connection::processMessage(const std::shared_ptr<Message> message)
 
       case Message::Command::ObjectEventFired:
       case Message::Command::BoardTileDataChanged:
+      case Message::Command::BoardTileStatesChanged:
       {
         const auto handle = message->read<Handle>();
         if(auto object = m_objects.value(handle).lock())
@@ -1066,14 +1148,31 @@ void Connection::processMessage(const std::shared_ptr<Message> message)
 
 void Connection::socketConnected()
 {
-  setState(State::Authenticating);
+  if(m_state != State::Reconnecting)
+    setState(State::Authenticating);
   std::unique_ptr<Message> loginRequest{Message::newRequest(Message::Command::Login)};
   loginRequest->write(m_username.toUtf8());
   loginRequest->write(m_password);
+  loginRequest->write(static_cast<Message::Capabilities>(
+    static_cast<uint32_t>(Message::Capabilities::MultiMessageFrame) |
+    static_cast<uint32_t>(Message::Capabilities::CompressedMessages) |
+    static_cast<uint32_t>(Message::Capabilities::PropertyIds) |
+    static_cast<uint32_t>(Message::Capabilities::TileStates)));
   send(loginRequest,
     [this](const std::shared_ptr<Message> loginResponse)
     {
       if(loginResponse && loginResponse->isResponse() && !loginResponse->isError())
+      {
+        // older servers don't reply with the capabilities they use:
+        const auto capabilities = loginResponse->endOfMessage() ? Message::Capabilities::None : loginResponse->read<Message::Capabilities>();
+        m_propertyIds = (static_cast<uint32_t>(capabilities) & static_cast<uint32_t>(Message::Capabilities::PropertyIds)) != 0;
+      }
+
+      if(loginResponse && loginResponse->isResponse() && !loginResponse->isError() && m_state == State::Reconnecting)
+      {
+        resumeSession();
+      }
+      else if(loginResponse && loginResponse->isResponse() && !loginResponse->isError())
       {
         setState(State::CreatingSession);
         std::unique_ptr<Message> newSessionRequest{Message::newRequest(Message::Command::NewSession)};
@@ -1083,6 +1182,10 @@ void Connection::socketConnected()
             if(newSessionResonse && newSessionResonse->isResponse() && !newSessionResonse->isError())
             {
               newSessionResonse->read(m_sessionUUID);
+              m_sendCount = 0;
+              m_receiveCount = 1; // this response
+              m_sendJournal.clear();
+              m_sendJournalSize = 0;
               m_traintastic = readObject(*newSessionResonse);
               m_worldProperty = dynamic_cast<ObjectProperty*>(m_traintastic->getProperty("world"));
               connect(m_worldProperty, &ObjectProperty::valueChanged, this,
@@ -1134,6 +1237,7 @@ void Connection::socketConnected()
       }
       else
       {
+        m_sessionUUID = QUuid(); // don't resume
         setState(State::ErrorAuthenticationFailed);
         m_socket->close();
       }
@@ -1142,10 +1246,65 @@ void Connection::socketConnected()
 
 void Connection::socketDisconnected()
 {
+  if(reconnect())
+    return;
   setState(State::Disconnected);
 }
 
 void Connection::socketError(QAbstractSocket::SocketError)
 {
+  if(reconnect())
+    return;
   setState(State::SocketError);
 }
+
+bool Connection::reconnect()
+{
+  if(m_sessionUUID.isNull())
+    return false;
+
+  if(m_state != State::Reconnecting)
+  {
+    m_reconnectAttempts = 0;
+    setState(State::Reconnecting);
+  }
+
+  if(!m_reconnectTimer.isActive())
+  {
+    if(m_reconnectAttempts >= reconnectAttemptsMax)
+    {
+      m_sessionUUID = QUuid(); // give up
+      return false;
+    }
+    m_reconnectAttempts++;
+    m_reconnectTimer.start();
+  }
+  return true;
+}
+
+void Connection::resumeSession()
+{
+  std::unique_ptr<Message> request{Message::newRequest(Message::Command::ResumeSession)};
+  request->write(m_sessionUUID);
+  request->write(m_receiveCount);
+  send(request,
+    [this](const std::shared_ptr<Message> response)
+    {
+      // the server has resent the messages we didn't receive before this response
+      if(response->isResponse() && !response->isError())
+      {
+        const uint32_t count = m_sendCount - response->read<uint32_t>(); // number of messages the server didn't receive
+        if(count <= m_sendJournal.size())
+        {
+          for(auto it = m_sendJournal.end() - count; it != m_sendJournal.end(); ++it)
+            m_socket->sendBinaryMessage(*it);
+          setState(State::Connected);
+          return;
+        }
+      }
+
+      // session can't be resumed, objects are out of sync:
+      m_sessionUUID = QUuid();
+      m_socket->close();
+    });
+}
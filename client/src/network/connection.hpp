@@ -25,11 +25,14 @@
 
 #include <QObject>
 #include <memory>
+#include <deque>
 #include <unordered_map>
 #include <optional>
 #include <QAbstractSocket>
 #include <QHostAddress>
 #include <QMap>
+#include <QTimer>
+#include <QUrl>
 #include <QUuid>
 #include <traintastic/network/message.hpp>
 #include "handle.hpp"
@@ -38,6 +41,7 @@
 
 class QWebSocket;
 class ServerLogTableModel;
+class InterfaceItem;
 class Property;
 class ObjectProperty;
 class ObjectVectorProperty;
@@ -66,6 +70,7 @@ class Connection : public QObject, public std::enable_shared_from_this<Connectio
       Authenticating,
       CreatingSession,
       FetchingWorld,
+      Reconnecting,
       SocketError,
       ErrorAuthenticationFailed,
       ErrorNewSessionFailed,
@@ -74,10 +79,17 @@ class Connection : public QObject, public std::enable_shared_from_this<Connectio
     using SocketError = QAbstractSocket::SocketError;
 
   protected:
+    static constexpr int reconnectInterval = 1000; //!< ms
+    static constexpr int reconnectAttemptsMax = 30; //!< must fit in the server's session resume timeout
+    static constexpr size_t sendJournalSizeMax = 256 * 1024; //!< bytes
+
     QWebSocket* m_socket;
     State m_state;
+    QUrl m_url;
     QString m_username;
     QByteArray m_password;
+    QTimer m_reconnectTimer;
+    int m_reconnectAttempts = 0;
     struct
     {
       qint64 offset = 0;
@@ -86,6 +98,11 @@ class Connection : public QObject, public std::enable_shared_from_this<Connectio
     } m_readBuffer;
     QMap<uint16_t, std::function<void(const std::shared_ptr<Message>&)>> m_requestCallback;
     QUuid m_sessionUUID;
+    bool m_propertyIds = false; //!< server uses interface item ids, see Message::Capabilities::PropertyIds
+    uint32_t m_sendCount = 0; //!< number of session messages sent to the server
+    uint32_t m_receiveCount = 0; //!< number of session messages received from the server
+    std::deque<QByteArray> m_sendJournal; //!< last sent session messages, for resuming the session
+    size_t m_sendJournalSize = 0;
     ObjectPtr m_traintastic;
     ObjectProperty* m_worldProperty;
     int m_worldRequestId;
@@ -98,8 +115,13 @@ class Connection : public QObject, public std::enable_shared_from_this<Connectio
 
     void setState(State state);
     void processMessage(const std::shared_ptr<Message> message);
+    void write(const Message& message);
+
+    bool reconnect();
+    void resumeSession();
 
     ObjectPtr readObject(const Message &message);
+    InterfaceItem* readInterfaceItem(const Message& message, Object& object) const;
     TableModelPtr readTableModel(const Message& message);
 
     void getWorld();
@@ -133,6 +155,9 @@ class Connection : public QObject, public std::enable_shared_from_this<Connectio
 
     void cancelRequest(int requestId);
 
+    //! Writes the id or name of \a item, depending on Message::Capabilities::PropertyIds
+    void writeInterfaceItem(Message& message, const InterfaceItem& item) const;
+
     const ObjectPtr& traintastic() const { return m_traintastic; }
     const ObjectPtr& world() const { return m_world; }
     QString worldUUID() const;
@@ -38,6 +38,7 @@ class InterfaceItem : public QObject
 
   protected:
     const QString m_name;
+    quint16 m_id = 0;
     QMap<AttributeName, QVariant> m_attributes;
 
   public:
@@ -46,6 +47,7 @@ class InterfaceItem : public QObject
     const Object& object() const;
     Object& object();
     const QString& name() const { return m_name; }
+    quint16 id() const { return m_id; } //!< server assigned id, used on the wire instead of the name
     QString displayName() const;
     QString helpText() const;
 
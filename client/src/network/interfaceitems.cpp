@@ -71,4 +71,7 @@ void InterfaceItems::add(InterfaceItem& item)
 {
   m_items.insert(item.name(), &item);
   m_itemOrder.append(item.name());
+  if(item.id() >= m_itemsById.size())
+    m_itemsById.resize(item.id() + 1, nullptr);
+  m_itemsById[item.id()] = &item;
 }
@@ -23,6 +23,7 @@
 #ifndef TRAINTASTIC_CLIENT_NETWORK_INTERFACEITEMS_HPP
 #define TRAINTASTIC_CLIENT_NETWORK_INTERFACEITEMS_HPP
 
+#include <vector>
 #include <QMap>
 #include <QStringList>
 
@@ -33,6 +34,7 @@ class InterfaceItems
   protected:
     QMap<QString, InterfaceItem*> m_items;
     QStringList m_itemOrder;
+    std::vector<InterfaceItem*> m_itemsById;
 
   public:
     const QStringList& names() const { return m_itemOrder; }
@@ -43,6 +45,7 @@ class InterfaceItems
     std::vector<InterfaceItem*> items(const QString& category) const;
 
     inline InterfaceItem* find(const QString& name) const { return m_items.value(name, nullptr); }
+    inline InterfaceItem* findById(quint16 id) const { return id < m_itemsById.size() ? m_itemsById[id] : nullptr; }
 
     void add(InterfaceItem& item);
 };
@@ -30,7 +30,7 @@ static void setPropertyValue(Property& property, const T& value)
 {
   auto event = Message::newEvent(Message::Command::ObjectSetProperty);
   event->write(static_cast<Object*>(property.parent())->handle());
-  event->write(property.name().toLatin1());
+  property.object().connection()->writeInterfaceItem(*event, property);
 
   if constexpr(std::is_same_v<T, bool>)
   {
@@ -63,7 +63,7 @@ template<class T>
 {
   auto request = Message::newRequest(Message::Command::ObjectSetProperty);
   request->write(static_cast<Object*>(property.parent())->handle());
-  request->write(property.name().toLatin1());
+  property.object().connection()->writeInterfaceItem(*request, property);
 
   if constexpr(std::is_same_v<T, bool>)
   {
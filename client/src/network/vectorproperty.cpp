@@ -29,7 +29,7 @@ static void setVectorPropertyValue(VectorProperty& property, int index, const T&
 {
   auto event = Message::newEvent(Message::Command::ObjectSetVectorProperty);
   event->write(static_cast<Object*>(property.parent())->handle());
-  event->write(property.name().toLatin1());
+  property.object().connection()->writeInterfaceItem(*event, property);
   event->write<uint32_t>(index);
 
   if constexpr(std::is_same_v<T, bool>)
@@ -59,6 +59,7 @@
 #include <traintastic/enum/turnoutposition.hpp>
 #include <traintastic/enum/volumeunit.hpp>
 #include <traintastic/enum/weightunit.hpp>
+#include <traintastic/enum/worldcompression.hpp>
 #include <traintastic/enum/worldscale.hpp>
 #include <traintastic/enum/xpressnetcommandstation.hpp>
 #include <traintastic/enum/xpressnetinterfacetype.hpp>
@@ -132,6 +133,7 @@ QString translateEnum(const QString& enumName, qint64 value)
   TRANSLATE_ENUM(TurnoutPosition)
   TRANSLATE_ENUM(VolumeUnit)
   TRANSLATE_ENUM(WeightUnit)
+  TRANSLATE_ENUM(WorldCompression)
   TRANSLATE_ENUM(WorldScale)
   TRANSLATE_ENUM(XpressNetCommandStation)
   TRANSLATE_ENUM(XpressNetInterfaceType)
@@ -0,0 +1,255 @@
+/**
+ * server/benchmark/main.cpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include "options.hpp"
+#include "worldgenerator.hpp"
+#include "../src/core/eventloop.hpp"
+#include "../src/core/method.tpp"
+#include "../src/core/objectproperty.tpp"
+#include "../src/board/board.hpp"
+#include "../src/board/boardlist.hpp"
+#include "../src/board/list/blockrailtilelist.hpp"
+#include "../src/board/map/blockpath.hpp"
+#include "../src/board/tile/rail/blockrailtile.hpp"
+#include "../src/board/tile/rail/straightrailtile.hpp"
+#include "../src/enum/worldcompression.hpp"
+#include "../src/hardware/decoder/list/decoderlist.hpp"
+#include "../src/hardware/input/list/inputlist.hpp"
+#include "../src/hardware/interface/interfacelist.hpp"
+#include "../src/hardware/output/list/outputlist.hpp"
+#include "../src/lua/scriptlist.hpp"
+#include "../src/traintastic/startupprofiler.hpp"
+#include "../src/train/trainlist.hpp"
+#include "../src/world/world.hpp"
+#include "../src/world/worldjournal.hpp"
+#include "../src/world/worldloader.hpp"
+#include "../src/world/worldsaver.hpp"
+
+using SteadyClock = std::chrono::steady_clock;
+
+//! Times in milliseconds of all iterations of a measurement.
+class Timings
+{
+  private:
+    std::vector<double> m_values;
+
+  public:
+    void add(SteadyClock::duration duration)
+    {
+      m_values.emplace_back(std::chrono::duration<double, std::milli>(duration).count());
+    }
+
+    double min() const
+    {
+      return *std::min_element(m_values.begin(), m_values.end());
+    }
+
+    double median() const
+    {
+      std::vector<double> sorted{m_values};
+      std::sort(sorted.begin(), sorted.end());
+      return sorted[sorted.size() / 2];
+    }
+
+    double max() const
+    {
+      return *std::max_element(m_values.begin(), m_values.end());
+    }
+};
+
+static std::ostream& operator <<(std::ostream& os, const Timings& timings)
+{
+  return os << std::fixed << std::setprecision(1) << std::setw(9) << timings.median() << " ms (" << timings.min() << " .. " << timings.max() << ")";
+}
+
+//! Run handlers posted to the event loop, e.g. deferred deletes of a destroyed world.
+static void processEvents()
+{
+  EventLoop::ioContext.restart();
+  EventLoop::ioContext.poll();
+}
+
+static std::string_view formatName(WorldSaver::Format format)
+{
+  switch(format)
+  {
+    case WorldSaver::Format::JSON:
+      return "json";
+
+    case WorldSaver::Format::Binary:
+      return "binary";
+  }
+  return {};
+}
+
+int main(int argc, char* argv[])
+{
+  // parse command line options:
+  const Options options(argc, argv);
+
+  const std::filesystem::path directory = options.directory.empty() ? std::filesystem::temp_directory_path() / "traintastic-server-benchmark" : std::filesystem::path(options.directory);
+  std::filesystem::create_directories(directory);
+
+  // generate world:
+  std::shared_ptr<World> world;
+  {
+    const auto start = SteadyClock::now();
+    try
+    {
+      world = WorldGenerator::generate(options.world);
+    }
+    catch(const std::invalid_argument& e)
+    {
+      std::cerr << "Error: " << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+    Timings timings;
+    timings.add(SteadyClock::now() - start);
+
+    std::cout
+      << "world:        "
+      << world->boards->length.value() << " boards, "
+      << WorldGenerator::tileCount(options.world) << " tiles, "
+      << world->blockRailTiles->length.value() << " blocks, "
+      << WorldGenerator::turnoutCount(options.world) << " turnouts, "
+      << world->trains->length.value() << " trains, "
+      << world->decoders->length.value() << " decoders, "
+      << world->interfaces->length.value() << " interfaces, "
+      << world->inputs->length.value() << " inputs, "
+      << world->outputs->length.value() << " outputs, "
+      << world->luaScripts->length.value() << " scripts" << std::endl
+      << "generate:     " << timings << std::endl;
+  }
+
+  // board links, the same as leaving edit mode after changing a board:
+  {
+    auto& board = *(*world->boards)[0];
+    const auto x = static_cast<int16_t>(options.world.columns * WorldGenerator::cellWidth + 1);
+
+    Timings timings;
+    for(unsigned int i = 0; i < options.iterations; i++)
+    {
+      world->edit = true;
+      if(i % 2 == 0)
+        board.addTile(x, 0, TileRotate::Deg0, StraightRailTile::classId, false);
+      else
+        board.deleteTile(x, 0);
+
+      const auto start = SteadyClock::now();
+      world->edit = false;
+      timings.add(SteadyClock::now() - start);
+    }
+    std::cout << "board links:  " << timings << std::endl;
+  }
+
+  // path discovery:
+  {
+    auto& blocks = *world->blockRailTiles;
+    size_t paths = 0;
+
+    Timings timings;
+    for(unsigned int i = 0; i < options.iterations; i++)
+    {
+      paths = 0;
+      const auto start = SteadyClock::now();
+      for(uint32_t j = 0; j < blocks.length; j++)
+        paths += BlockPath::find(*blocks[j]).size();
+      timings.add(SteadyClock::now() - start);
+    }
+    std::cout << "block paths:  " << timings << ", " << paths << " paths" << std::endl;
+  }
+
+  // save and load:
+  std::cout << std::endl << "format         snapshot                  write                     size        load" << std::endl;
+  for(auto format : {WorldSaver::Format::JSON, WorldSaver::Format::Binary})
+  {
+    for(auto compression : worldCompressionValues)
+    {
+      const std::string name = std::string(formatName(format)).append("/").append(EnumValues<WorldCompression>::value.at(compression));
+      const auto filename = directory / std::string("benchmark-").append(formatName(format)).append("-").append(EnumValues<WorldCompression>::value.at(compression)).append(World::dotCTW);
+
+      Timings snapshot;
+      Timings write;
+      for(unsigned int i = 0; i < options.iterations; i++)
+      {
+        const auto start = SteadyClock::now();
+        WorldSaver saver(*world);
+        const auto written = SteadyClock::now();
+        snapshot.add(written - start);
+        saver.write(filename, format, compression);
+        write.add(SteadyClock::now() - written);
+      }
+
+      Timings load;
+      StartupProfiler::Report report;
+      for(unsigned int i = 0; i < options.iterations; i++)
+      {
+        std::shared_ptr<World> loaded;
+        StartupProfiler::start();
+        const auto start = SteadyClock::now();
+        {
+          WorldLoader loader(filename);
+          loaded = loader.world();
+        }
+        load.add(SteadyClock::now() - start);
+        report = StartupProfiler::stop();
+
+        if(!loaded || loaded->blockRailTiles->length.value() != world->blockRailTiles->length.value())
+        {
+          std::cerr << "Error: " << filename.string() << " loaded incomplete." << std::endl;
+          return EXIT_FAILURE;
+        }
+        loaded.reset();
+        processEvents();
+        std::filesystem::remove(WorldJournal::path(filename)); // created by the loader, next load must start without it
+      }
+
+      std::cout
+        << std::left << std::setw(13) << name << std::right
+        << snapshot << write
+        << std::setw(9) << std::filesystem::file_size(filename) / 1024 << " KiB"
+        << load << std::endl;
+
+      std::cout << "             ";
+      for(size_t i = 0; i < StartupProfiler::phaseCount; i++)
+      {
+        const auto& phase = report.phases[i];
+        if(phase.count != 0)
+          std::cout << " " << StartupProfiler::name(static_cast<StartupProfiler::Phase>(i)) << " " << std::chrono::duration<double, std::milli>(phase.duration).count() << " ms";
+      }
+      std::cout << ", " << report.allocations << " allocations" << std::endl;
+
+      if(!options.keep)
+        std::filesystem::remove(filename);
+    }
+  }
+
+  world.reset();
+  processEvents();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+/**
+ * server/benchmark/options.hpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef TRAINTASTIC_SERVER_BENCHMARK_OPTIONS_HPP
+#define TRAINTASTIC_SERVER_BENCHMARK_OPTIONS_HPP
+
+#include <iostream>
+#include <boost/program_options.hpp>
+#include <version.hpp>
+#include "worldgenerator.hpp"
+
+struct Options
+{
+  WorldGenerator::Parameters world;
+  unsigned int iterations;
+  std::string directory;
+  bool keep;
+
+  Options(int argc , char* argv[])
+  {
+    boost::program_options::options_description desc{"Options for traintastic-server-benchmark"};
+    desc.add_options()
+      ("help,h", "display this help text and exit")
+      ("version,v", "output version information and exit")
+      ("boards,b", boost::program_options::value<uint32_t>(&world.boards)->value_name("N")->default_value(world.boards), "number of boards")
+      ("rows,r", boost::program_options::value<uint32_t>(&world.rows)->value_name("N")->default_value(world.rows), "number of track pairs per board")
+      ("columns,c", boost::program_options::value<uint32_t>(&world.columns)->value_name("N")->default_value(world.columns), "number of cells per track pair")
+      ("trains,t", boost::program_options::value<uint32_t>(&world.trains)->value_name("N")->default_value(world.trains), "number of trains")
+      ("interfaces,i", boost::program_options::value<uint32_t>(&world.interfaces)->value_name("N")->default_value(world.interfaces), "number of interfaces")
+      ("inputs-per-block", boost::program_options::value<uint32_t>(&world.inputsPerBlock)->value_name("N")->default_value(world.inputsPerBlock), "number of inputs per block")
+      ("scripts,s", boost::program_options::value<uint32_t>(&world.scripts)->value_name("N")->default_value(world.scripts), "number of Lua scripts")
+      ("iterations,n", boost::program_options::value<unsigned int>(&iterations)->value_name("N")->default_value(3), "number of iterations per measurement")
+      ("dir,d", boost::program_options::value<std::string>(&directory)->value_name("PATH"), "directory for the world files, default: temporary directory")
+      ("keep", "don't remove the world files")
+      ;
+
+    boost::program_options::variables_map vm;
+
+    try
+    {
+      boost::program_options::store(parse_command_line(argc, argv, desc), vm);
+
+      if(vm.count("help"))
+      {
+        std::cout
+          << desc << std::endl
+          << "NOTES:"<< std::endl
+          << "1. A cell has two blocks, four turnouts and a bridge, 13 tiles in total." << std::endl
+          << "2. Each board fits at most 166 columns and 250 rows."
+          << std::endl
+          ;
+        exit(EXIT_SUCCESS);
+      }
+
+      if(vm.count("version"))
+      {
+        std::cout << TRAINTASTIC_VERSION_FULL << std::endl;
+        exit(EXIT_SUCCESS);
+      }
+
+      keep = vm.count("keep");
+
+      boost::program_options::notify(vm);
+
+      if(iterations == 0)
+      {
+        std::cerr << "Error: --iterations must be greater than zero." << std::endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+    catch(const boost::program_options::error& e)
+    {
+      std::cerr << e.what() << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+};
+
+#endif
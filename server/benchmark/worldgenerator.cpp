@@ -0,0 +1,206 @@
+/**
+ * server/benchmark/worldgenerator.cpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "worldgenerator.hpp"
+#include <array>
+#include <stdexcept>
+#include "../src/core/method.tpp"
+#include "../src/core/objectproperty.tpp"
+#include "../src/world/world.hpp"
+#include "../src/board/board.hpp"
+#include "../src/board/boardlist.hpp"
+#include "../src/board/list/blockrailtilelist.hpp"
+#include "../src/board/tile/rail/blockrailtile.hpp"
+#include "../src/board/tile/rail/bridge90railtile.hpp"
+#include "../src/board/tile/rail/nxbuttonrailtile.hpp"
+#include "../src/board/tile/rail/straightrailtile.hpp"
+#include "../src/board/tile/rail/turnout/turnoutleft45railtile.hpp"
+#include "../src/board/tile/rail/turnout/turnoutright45railtile.hpp"
+#include "../src/hardware/decoder/decoder.hpp"
+#include "../src/hardware/input/map/blockinputmap.hpp"
+#include "../src/hardware/input/map/blockinputmapitem.hpp"
+#include "../src/hardware/interface/interfacelist.hpp"
+#include "../src/hardware/interface/dccexinterface.hpp"
+#include "../src/hardware/interface/ecosinterface.hpp"
+#include "../src/hardware/interface/loconetinterface.hpp"
+#include "../src/hardware/interface/xpressnetinterface.hpp"
+#include "../src/hardware/interface/z21interface.hpp"
+#include "../src/hardware/output/map/outputmap.hpp"
+#include "../src/lua/scriptlist.hpp"
+#include "../src/train/train.hpp"
+#include "../src/train/trainlist.hpp"
+#include "../src/train/trainvehiclelist.hpp"
+#include "../src/vehicle/rail/locomotive.hpp"
+#include "../src/vehicle/rail/railvehiclelist.hpp"
+
+//! Interface types that are a decoder, input and output controller.
+static constexpr std::array<std::string_view, 5> interfaceClassIds{{
+  LocoNetInterface::classId,
+  XpressNetInterface::classId,
+  Z21Interface::classId,
+  ECoSInterface::classId,
+  DCCEXInterface::classId,
+}};
+
+template<class T>
+static std::shared_ptr<T> addTile(Board& board, uint32_t x, uint32_t y, TileRotate rotate)
+{
+  if(!board.addTile(static_cast<int16_t>(x), static_cast<int16_t>(y), rotate, T::classId, false))
+    throw std::invalid_argument("can't add tile");
+  return std::dynamic_pointer_cast<T>(board.getTile({static_cast<int16_t>(x), static_cast<int16_t>(y)}));
+}
+
+static void addCell(Board& board, uint32_t x, uint32_t y, std::vector<std::shared_ptr<TurnoutRailTile>>& turnouts)
+{
+  addTile<BlockRailTile>(board, x, y, TileRotate::Deg90);
+  addTile<NXButtonRailTile>(board, x + 1, y, TileRotate::Deg90);
+  turnouts.emplace_back(addTile<TurnoutRight45RailTile>(board, x + 2, y, TileRotate::Deg90));
+  addTile<StraightRailTile>(board, x + 3, y, TileRotate::Deg90);
+  turnouts.emplace_back(addTile<TurnoutLeft45RailTile>(board, x + 4, y, TileRotate::Deg270));
+  addTile<NXButtonRailTile>(board, x + 5, y, TileRotate::Deg90);
+
+  addTile<Bridge90RailTile>(board, x + 3, y + 1, TileRotate::Deg45);
+
+  addTile<BlockRailTile>(board, x, y + 2, TileRotate::Deg90);
+  addTile<NXButtonRailTile>(board, x + 1, y + 2, TileRotate::Deg90);
+  turnouts.emplace_back(addTile<TurnoutLeft45RailTile>(board, x + 2, y + 2, TileRotate::Deg90));
+  addTile<StraightRailTile>(board, x + 3, y + 2, TileRotate::Deg90);
+  turnouts.emplace_back(addTile<TurnoutRight45RailTile>(board, x + 4, y + 2, TileRotate::Deg270));
+  addTile<NXButtonRailTile>(board, x + 5, y + 2, TileRotate::Deg90);
+}
+
+static std::string scriptCode(World& world, uint32_t index, uint32_t count)
+{
+  std::string code;
+  code
+    .append("-- generated by traintastic-server-benchmark\n")
+    .append("local entered = 0\n")
+    .append("\n")
+    .append("function world_event(state)\n")
+    .append("  if world.state.contains(set.world_state.RUN) then\n")
+    .append("    log.info('script ").append(std::to_string(index + 1)).append(": running, ' .. entered .. ' trains entered')\n")
+    .append("  end\n")
+    .append("end\n")
+    .append("\n")
+    .append("world.on_event(world_event)\n");
+
+  auto& blocks = *world.blockRailTiles;
+  for(uint32_t i = index; i < blocks.length; i += count)
+  {
+    code
+      .append("\n")
+      .append("world.get_object('").append(blocks[i]->id.value()).append("').on_train_entered(\n")
+      .append("  function (train, block, direction)\n")
+      .append("    entered = entered + 1\n")
+      .append("    log.debug(train.name .. ' entered ' .. block.name)\n")
+      .append("  end)\n");
+  }
+  return code;
+}
+
+std::shared_ptr<World> WorldGenerator::generate(const Parameters& parameters)
+{
+  if(parameters.columns == 0 || parameters.columns * cellWidth >= static_cast<uint32_t>(Board::sizeMax) ||
+      parameters.rows == 0 || parameters.rows * rowHeight > static_cast<uint32_t>(Board::sizeMax))
+    throw std::invalid_argument("board size out of range");
+  if(parameters.trains > blockCount(parameters))
+    throw std::invalid_argument("more trains than blocks");
+  if(parameters.interfaces == 0)
+    throw std::invalid_argument("at least one interface is required");
+
+  auto world = World::create();
+  world->name = "Benchmark";
+
+  std::vector<std::shared_ptr<Interface>> interfaces;
+  for(uint32_t i = 0; i < parameters.interfaces; i++)
+    interfaces.emplace_back(world->interfaces->create(interfaceClassIds[i % interfaceClassIds.size()]));
+
+  // boards:
+  std::vector<std::shared_ptr<TurnoutRailTile>> turnouts;
+  turnouts.reserve(turnoutCount(parameters));
+  for(uint32_t b = 0; b < parameters.boards; b++)
+  {
+    auto board = world->boards->create();
+    board->name = "Board " + std::to_string(b + 1);
+
+    for(uint32_t r = 0; r < parameters.rows; r++)
+    {
+      const uint32_t y = r * rowHeight;
+      for(uint32_t c = 0; c < parameters.columns; c++)
+        addCell(*board, c * cellWidth, y, turnouts);
+
+      addTile<BlockRailTile>(*board, parameters.columns * cellWidth, y, TileRotate::Deg90);
+      addTile<BlockRailTile>(*board, parameters.columns * cellWidth, y + 2, TileRotate::Deg90);
+    }
+  }
+
+  // outputs:
+  for(size_t i = 0; i < turnouts.size(); i++)
+    turnouts[i]->outputMap->interface = std::dynamic_pointer_cast<OutputController>(interfaces[i % interfaces.size()]);
+
+  // inputs:
+  auto& blocks = *world->blockRailTiles;
+  size_t inputIndex = 0;
+  for(uint32_t i = 0; i < blocks.length; i++)
+  {
+    auto& inputMap = *blocks[i]->inputMap;
+    for(uint32_t j = 0; j < parameters.inputsPerBlock; j++)
+    {
+      inputMap.create();
+      auto& item = *inputMap.items.back();
+      auto inputController = std::dynamic_pointer_cast<InputController>(interfaces[inputIndex++ % interfaces.size()]);
+      item.interface = inputController;
+      if(auto address = inputController->getUnusedInputAddress(item.channel))
+        item.address = *address;
+    }
+  }
+
+  // trains:
+  for(uint32_t i = 0; i < parameters.trains; i++)
+  {
+    auto locomotive = world->railVehicles->create(Locomotive::classId);
+    locomotive->name = "Locomotive " + std::to_string(i + 1);
+
+    auto& decoder = *locomotive->decoder;
+    auto decoderController = std::dynamic_pointer_cast<DecoderController>(interfaces[i % interfaces.size()]);
+    decoder.interface = decoderController;
+    const auto range = decoderController->decoderAddressMinMax(decoder.protocol);
+    decoder.address = static_cast<uint16_t>(range.first + (i / interfaces.size()) % (range.second - range.first + 1u));
+
+    auto train = world->trains->create();
+    train->name = "Train " + std::to_string(i + 1);
+    train->vehicles->add(locomotive);
+
+    blocks[static_cast<uint32_t>(static_cast<uint64_t>(i) * blocks.length / parameters.trains)]->assignTrain(train);
+  }
+
+  // scripts:
+  for(uint32_t i = 0; i < parameters.scripts; i++)
+  {
+    auto script = world->luaScripts->create();
+    script->name = "Script " + std::to_string(i + 1);
+    script->code = scriptCode(*world, i, parameters.scripts);
+  }
+
+  return world;
+}
@@ -0,0 +1,95 @@
+/**
+ * server/benchmark/worldgenerator.hpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef TRAINTASTIC_SERVER_BENCHMARK_WORLDGENERATOR_HPP
+#define TRAINTASTIC_SERVER_BENCHMARK_WORLDGENERATOR_HPP
+
+#include <cstdint>
+#include <memory>
+
+class World;
+
+/**
+ * \brief Generates parametric worlds for benchmarking
+ *
+ * Each board contains \c rows track pairs of \c columns cells, a cell is:
+ *
+ * \code
+ * +-------+                     +-------
+ * | block |--(nx)-\---/-(nx)----| block ...
+ * +-------+        \ /          +-------
+ *                   X <- bridge
+ * +-------+        / \          +-------
+ * | block |--(nx)-/---\-(nx)----| block ...
+ * +-------+                     +-------
+ * \endcode
+ *
+ * so every block has paths to the two blocks of the next cell. Each track
+ * pair ends with two blocks. Turnouts are mapped to outputs and blocks to
+ * inputs, spread round robin over interfaces of different types. Trains
+ * consist of a single locomotive, its decoder is assigned to an interface,
+ * and are spread evenly over the blocks. Lua scripts are added but not run.
+ */
+class WorldGenerator
+{
+  public:
+    struct Parameters
+    {
+      uint32_t boards = 10;
+      uint32_t rows = 5; //!< track pairs per board
+      uint32_t columns = 10; //!< cells per track pair
+      uint32_t trains = 100;
+      uint32_t interfaces = 4;
+      uint32_t inputsPerBlock = 2;
+      uint32_t scripts = 10;
+    };
+
+    static constexpr uint32_t cellWidth = 6;
+    static constexpr uint32_t rowHeight = 4;
+    static constexpr uint32_t tilesPerCell = 13;
+    static constexpr uint32_t turnoutsPerCell = 4;
+
+    static uint32_t tileCount(const Parameters& parameters)
+    {
+      return parameters.boards * parameters.rows * (parameters.columns * tilesPerCell + 2);
+    }
+
+    static uint32_t blockCount(const Parameters& parameters)
+    {
+      return parameters.boards * parameters.rows * (parameters.columns + 1) * 2;
+    }
+
+    static uint32_t turnoutCount(const Parameters& parameters)
+    {
+      return parameters.boards * parameters.rows * parameters.columns * turnoutsPerCell;
+    }
+
+    /**
+     * \brief Generate a world
+     *
+     * \throws std::invalid_argument if the boards don't fit or there are more trains than blocks
+     */
+    static std::shared_ptr<World> generate(const Parameters& parameters);
+};
+
+#endif
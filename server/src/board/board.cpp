@@ -25,6 +25,7 @@
 #include "boardlisttablemodel.hpp"
 #include "map/link.hpp"
 #include "tile/tiles.hpp"
+#include "tile/rail/linkrailtile.hpp"
 #include "tile/hidden/hiddencrossoverrailtile.hpp"
 #include "../core/method.tpp"
 #include "../core/objectproperty.tpp"
@@ -32,6 +33,7 @@
 #include "../world/worldloader.hpp"
 #include "../core/attributes.hpp"
 #include "../utils/displayname.hpp"
+#include "../traintastic/startupprofiler.hpp"
 #include <cassert>
 
 #include "../log/log.hpp"
@@ -112,7 +114,7 @@ Board::Board(World& world, std::string_view _id) :
 
       tileDataChanged(*this, tile->location(), tile->data());
       updateSize();
-      m_modified = true;
+      markModified(*tile);
       return true;
     }},
   moveTile{*this, "move_tile",
@@ -164,6 +166,7 @@ Board::Board(World& world, std::string_view _id) :
           }
 
       // remove tile at tile origin
+      markModified(*tile);
       removeTile(tile->location().x, tile->location().y);
 
       // set new params
@@ -184,7 +187,7 @@ Board::Board(World& world, std::string_view _id) :
       tileDataChanged(*this, tile->location(), tile->data());
 
       updateSize();
-      m_modified = true;
+      markModified(*tile);
       return true;
     }},
   resizeTile{*this, "resize_tile",
@@ -226,10 +229,13 @@ Board::Board(World& world, std::string_view _id) :
 
         for(int16_t xx = x; xx < x2; xx++)
           for(int16_t yy = y; yy < y2; yy++)
+          {
             if(xx < xNew && yy < yNew)
               m_tiles[{xx, yy}] = tile;
             else
               m_tiles.erase({xx, yy});
+            m_modifiedLocations.emplace(TileLocation{xx, yy});
+          }
       }
 
       tileDataChanged(*this, tile->location(), tile->data());
@@ -242,10 +248,10 @@ Board::Board(World& world, std::string_view _id) :
       auto tile = getTile({x, y});
       if(tile)
       {
+        markModified(*tile);
         removeTile(x, y);
         tile->destroy();
         updateSize();
-        m_modified = true;
       }
       return true;
     }},
@@ -368,6 +374,7 @@ void Board::loaded()
   IdObject::loaded();
 
   m_modified = true;
+  m_modifiedLocations.clear();
   modified();
 }
 
@@ -376,6 +383,8 @@ void Board::modified()
   if(!m_modified)
     return;
 
+  StartupProfiler::Scope scope(StartupProfiler::Phase::BoardLinks);
+
   auto updateLink =
     [this](const std::shared_ptr<Tile>& startTile, const Connector& startConnector)
     {
@@ -450,23 +459,89 @@ void Board::modified()
       startTile->node()->get().disconnect(startConnector);
     };
 
-  // check/rebuild links:
+  const bool rebuildAll = m_modifiedLocations.empty();
+  std::vector<std::shared_ptr<Tile>> nodeTiles; // tiles with a node that must be relinked
+  std::unordered_set<const Tile*> isNodeTile;
+
+  if(rebuildAll)
+  {
+    for(auto& [l, tile] : m_tiles)
+      if(tile->node() && l == tile->location())
+        nodeTiles.emplace_back(tile);
+  }
+  else // only nodes with a link that ends at or passes a modified location
   {
+    std::unordered_set<const Tile*> checked;
     std::vector<Connector> connectors;
+    std::vector<Connector> trackConnectors;
 
-    for(auto& [l, tile] : m_tiles)
-    {
-      if(auto node = tile->node(); node && l == tile->location())
+    auto addNodeTile =
+      [&nodeTiles, &isNodeTile](const std::shared_ptr<Tile>& tile)
       {
-        connectors.clear();
-
-        tile->getConnectors(connectors);
+        if(isNodeTile.emplace(tile.get()).second)
+          nodeTiles.emplace_back(tile);
+      };
 
-        assert(!connectors.empty());
-        for(const auto connector : connectors)
+    for(auto location : m_modifiedLocations)
+      for(int16_t dx = -1; dx <= 1; dx++)
+        for(int16_t dy = -1; dy <= 1; dy++) // neighbours included, a crossover spans 2x2 tiles
         {
-          updateLink(tile, connector);
+          auto tile = getTile(location.adjusted(dx, dy));
+          if(!tile || !checked.emplace(tile.get()).second)
+            continue;
+
+          if(tile->node())
+          {
+            addNodeTile(tile);
+            continue;
+          }
+
+          // follow the track in both directions up to the next node:
+          connectors.clear();
+          tile->getConnectors(connectors);
+          for(const auto& start : connectors)
+          {
+            Connector connector{start.opposite()};
+            while(auto nextTile = getTile(connector.location))
+            {
+              if(nextTile == tile) // loop without nodes
+                break;
+
+              if(nextTile->node())
+              {
+                addNodeTile(nextTile);
+                break;
+              }
+
+              trackConnectors.clear();
+              nextTile->getConnectors(trackConnectors);
+              if(trackConnectors.size() != 2)
+                break;
+              if(trackConnectors[0] == connector)
+                connector = trackConnectors[1].opposite();
+              else if(trackConnectors[1] == connector)
+                connector = trackConnectors[0].opposite();
+              else // not connected
+                break;
+            }
+          }
         }
+  }
+
+  // check/rebuild links:
+  {
+    std::vector<Connector> connectors;
+
+    for(const auto& tile : nodeTiles)
+    {
+      connectors.clear();
+
+      tile->getConnectors(connectors);
+
+      assert(!connectors.empty());
+      for(const auto connector : connectors)
+      {
+        updateLink(tile, connector);
       }
     }
 
@@ -496,13 +571,84 @@ void Board::modified()
   }
 
   // notify board changed:
-  for(auto& [l, tile] : m_tiles)
-    if(l == tile->location()) // check origin to notify each tile once
+  if(rebuildAll)
+  {
+    for(auto& [l, tile] : m_tiles)
+      if(l == tile->location()) // check origin to notify each tile once
+        tile->boardModified();
+  }
+  else // only tiles that depend on the relinked nodes
+  {
+    // Block paths end at the next block, signals look up to two blocks ahead,
+    // so the network is followed up to the second block from a relinked node.
+    constexpr uint8_t blocksPassedMax = 1;
+
+    std::unordered_map<Node*, uint8_t> blocksPassed;
+    std::vector<std::pair<Node*, uint8_t>> todo;
+    std::unordered_set<Tile*> tiles;
+
+    auto visit =
+      [&blocksPassed, &todo](Node& node, uint8_t passed)
+      {
+        auto [it, inserted] = blocksPassed.try_emplace(&node, passed);
+        if(inserted || passed < it->second)
+        {
+          it->second = passed;
+          todo.emplace_back(&node, passed);
+        }
+      };
+
+    for(const auto& tile : nodeTiles)
+      visit(*tile->node(), 0);
+
+    while(!todo.empty())
+    {
+      auto [node, passed] = todo.back();
+      todo.pop_back();
+
+      Tile& tile = node->tile();
+      if(tile.dying())
+        continue;
+
+      if(tile.tileId == TileId::RailBlock && !isNodeTile.count(&tile))
+      {
+        if(passed == 0) // block paths end at the next block, so only blocks reached directly need new paths
+          tiles.emplace(&tile);
+        if(passed == blocksPassedMax)
+          continue;
+        passed++;
+      }
+      else
+        tiles.emplace(&tile);
+
+      for(const auto& link : node->links())
+        if(link)
+          visit(link->getNext(*node), passed);
+
+      if(tile.tileId == TileId::RailLink) // continue on the linked board
+        if(const auto& link = static_cast<LinkRailTile&>(tile).link.value())
+          visit(*link->node(), passed);
+    }
+
+    for(auto* tile : tiles)
       tile->boardModified();
+  }
 
+  m_modifiedLocations.clear();
   m_modified = false;
 }
 
+void Board::markModified(const Tile& tile)
+{
+  const auto l = tile.location();
+  const int16_t x2 = l.x + tile.width;
+  const int16_t y2 = l.y + tile.height;
+  for(int16_t x = l.x; x < x2; x++)
+    for(int16_t y = l.y; y < y2; y++)
+      m_modifiedLocations.emplace(TileLocation{x, y});
+  m_modified = true;
+}
+
 void Board::removeTile(const int16_t x, const int16_t y)
 {
   auto tile = getTile({x, y});
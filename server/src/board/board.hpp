@@ -25,6 +25,7 @@
 
 #include "../core/idobject.hpp"
 #include <unordered_map>
+#include <unordered_set>
 #include "../core/method.hpp"
 #include <traintastic/board/tilelocation.hpp>
 #include <traintastic/enum/tilerotate.hpp>
@@ -42,9 +43,11 @@ class Board : public IdObject
 
   private:
     bool m_modified = false;
+    std::unordered_set<TileLocation, TileLocationHash> m_modifiedLocations; //!< locations of added/moved/resized/deleted tiles, empty: rebuild all
     std::unordered_map<TileLocation, std::shared_ptr<HiddenCrossOverRailTile>, TileLocationHash> m_railCrossOver;
 
     void modified();
+    void markModified(const Tile& tile);
     void removeTile(int16_t x, int16_t y);
     void updateSize(bool allowShrink = false);
 
@@ -77,6 +80,7 @@ class Board : public IdObject
     Method<void()> resizeToContents;
 
     boost::signals2::signal<void (Board&, const TileLocation&, const TileData&)> tileDataChanged;
+    boost::signals2::signal<void (Board&, const TileLocation&, uint8_t)> tileStateChanged; //!< only TileData::state changed
 
     Board(World& world, std::string_view _id);
 
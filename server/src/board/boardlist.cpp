@@ -23,6 +23,7 @@
 #include "board.hpp"
 #include "boardlist.hpp"
 #include "boardlisttablemodel.hpp"
+#include "tile/tile.hpp"
 #include "../core/method.tpp"
 #include "../world/getworld.hpp"
 #include "../core/attributes.hpp"
@@ -73,25 +74,10 @@ void BoardList::worldEvent(WorldState state, WorldEvent event)
     const auto start = std::chrono::steady_clock::now();
 #endif
 
-    // due to link tile a change on one board might require an update on another board.
-    // for now update all board if one board is changed (should be improved!)
-    bool boardModified = false;
+    // a change on one board can affect another board due to link tiles,
+    // Board::modified() follows the network across link tiles.
     for(auto& board : m_items)
-    {
-      if(board->m_modified)
-      {
-        boardModified = true;
-        break;
-      }
-    }
-    if(boardModified)
-    {
-      for(auto& board : m_items)
-      {
-        board->m_modified = true;
-        board->modified();
-      }
-    }
+      board->modified();
 
 #ifdef ENABLE_LOG_DEBUG
   const auto duration = std::chrono::steady_clock::now() - start;
@@ -100,6 +86,18 @@ void BoardList::worldEvent(WorldState state, WorldEvent event)
   }
 }
 
+void BoardList::tileModified(const Tile& tile)
+{
+  for(auto& board : m_items)
+  {
+    if(board->getTile(tile.location()).get() == &tile)
+    {
+      board->markModified(tile);
+      break;
+    }
+  }
+}
+
 bool BoardList::isListedProperty(std::string_view name)
 {
   return BoardListTableModel::isListedProperty(name);
@@ -27,6 +27,7 @@
 #include "../core/method.hpp"
 
 class Board;
+class Tile;
 
 class BoardList : public ObjectList<Board>
 {
@@ -43,6 +44,9 @@ class BoardList : public ObjectList<Board>
     BoardList(Object& _parent, std::string_view parentPropertyName);
 
     TableModelPtr getModel() final;
+
+    //! \brief Mark the board containing \a tile as modified, e.g. when a tile property changes the network
+    void tileModified(const Tile& tile);
 };
 
 #endif
@@ -21,6 +21,7 @@
  */
 
 #include "blockpath.hpp"
+#include <limits>
 #include <queue>
 #include <traintastic/enum/crossstate.hpp>
 #include "node.hpp"
@@ -38,17 +39,7 @@
 #include "../../core/eventloop.hpp"
 #include "../../core/objectproperty.tpp"
 #include "../../enum/bridgepath.hpp"
-
-template<class T1, typename T2>
-static bool contains(const std::vector<std::pair<std::weak_ptr<T1>, T2>>& values, const std::shared_ptr<T1>& value)
-{
-  const auto it = std::find_if(values.begin(), values.end(),
-    [&value](const auto& item)
-    {
-      return item.first.lock() == value;
-    });
-  return it != values.end();
-}
+#include "../../traintastic/startupprofiler.hpp"
 
 template <typename T>
 static inline bool operator ==(const std::weak_ptr<T>& a, const std::weak_ptr<T>& b)
@@ -58,6 +49,8 @@ static inline bool operator ==(const std::weak_ptr<T>& a, const std::weak_ptr<T>
 
 std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBlock)
 {
+  StartupProfiler::Scope scope(StartupProfiler::Phase::PathDiscovery);
+
   const auto& node = startBlock.node()->get();
   const auto& linkA = node.getLink(0);
   const auto& linkB = node.getLink(1);
@@ -67,23 +60,130 @@ std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBloc
     return {};
   }
 
+  // A path isn't copied when it forks at a turnout, each step refers to the
+  // previous step so forks share the common part. Only for a path that
+  // reaches a block a BlockPath is created.
+  struct Step
+  {
+    enum class Type : uint8_t
+    {
+      Link, //!< passive tiles of a link
+      Tile, //!< passive tile
+      Turnout,
+      DirectionControl,
+      Crossing,
+      CrossOver,
+      Bridge,
+      Signal,
+      NXButtonFrom,
+    };
+
+    size_t previous;
+    Type type;
+    uint8_t state; //!< TurnoutPosition, DirectionControlState, CrossState or BridgePath
+    Tile* tile;
+    const Link* link;
+  };
+
+  constexpr size_t noStep = std::numeric_limits<size_t>::max();
+
   struct Position
   {
-    std::shared_ptr<BlockPath> path;
+    BlockSide side;
+    size_t step; //!< last step, noStep if none
     const Node* node;
     const Link* link;
   };
 
+  std::vector<Step> steps;
   std::vector<std::shared_ptr<BlockPath>> paths;
 
+  auto addStep =
+    [&steps](Position& position, Step::Type type, Tile* tile, uint8_t state = 0, const Link* link = nullptr)
+    {
+      steps.emplace_back(Step{position.step, type, state, tile, link});
+      position.step = steps.size() - 1;
+    };
+
+  auto hasStep =
+    [&steps](const Position& position, Step::Type type, const Tile& tile)
+    {
+      for(size_t i = position.step; i != noStep; i = steps[i].previous)
+      {
+        if(steps[i].type == type && steps[i].tile == &tile)
+        {
+          return true;
+        }
+      }
+      return false;
+    };
+
+  auto createPath =
+    [&steps, &startBlock](const Position& position)
+    {
+      std::vector<size_t> trail;
+      for(size_t i = position.step; i != noStep; i = steps[i].previous)
+      {
+        trail.emplace_back(i);
+      }
+
+      auto path = std::make_shared<BlockPath>(startBlock, position.side);
+      for(auto it = trail.rbegin(); it != trail.rend(); ++it)
+      {
+        const auto& step = steps[*it];
+        switch(step.type)
+        {
+          case Step::Type::Link:
+            for(const auto& tile : step.link->tiles())
+            {
+              path->m_tiles.emplace_back(std::static_pointer_cast<RailTile>(tile));
+            }
+            break;
+
+          case Step::Type::Tile:
+            path->m_tiles.emplace_back(step.tile->shared_ptr<RailTile>());
+            break;
+
+          case Step::Type::Turnout:
+            path->m_turnouts.emplace_back(step.tile->shared_ptr<TurnoutRailTile>(), static_cast<TurnoutPosition>(step.state));
+            break;
+
+          case Step::Type::DirectionControl:
+            path->m_directionControls.emplace_back(step.tile->shared_ptr<DirectionControlRailTile>(), static_cast<DirectionControlState>(step.state));
+            break;
+
+          case Step::Type::Crossing:
+            path->m_crossings.emplace_back(step.tile->shared_ptr<CrossRailTile>(), static_cast<CrossState>(step.state));
+            break;
+
+          case Step::Type::CrossOver:
+            path->m_crossOvers.emplace_back(step.tile->shared_ptr<HiddenCrossOverRailTile>(), static_cast<CrossState>(step.state));
+            break;
+
+          case Step::Type::Bridge:
+            path->m_bridges.emplace_back(step.tile->shared_ptr<BridgeRailTile>(), static_cast<BridgePath>(step.state));
+            break;
+
+          case Step::Type::Signal:
+            path->m_signals.emplace_back(step.tile->shared_ptr<SignalRailTile>());
+            break;
+
+          case Step::Type::NXButtonFrom:
+            path->m_nxButtonFrom = step.tile->shared_ptr<NXButtonRailTile>();
+            break;
+        }
+      }
+      return path;
+    };
+
   std::queue<Position> todo;
   if(linkA)
   {
-    todo.emplace(Position{std::make_shared<BlockPath>(startBlock, BlockSide::A), &node, linkA.get()});
+    todo.emplace(Position{BlockSide::A, noStep, &node, linkA.get()});
   }
   if(linkB)
   {
-    todo.emplace(Position{std::make_shared<BlockPath>(startBlock, BlockSide::B), &node, linkB.get()});
+    todo.emplace(Position{BlockSide::B, noStep, &node, linkB.get()});
   }
 
   while(!todo.empty())
@@ -95,9 +195,9 @@ std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBloc
       continue;
     }
 
-    for(const auto& tile : current.link->tiles()) // add passive tiles to reserve
+    if(!current.link->tiles().empty()) // add passive tiles to reserve
     {
-      current.path->m_tiles.emplace_back(std::static_pointer_cast<RailTile>(tile));
+      addStep(current, Step::Type::Link, nullptr, 0, current.link);
     }
 
     assert(current.node);
@@ -108,15 +208,17 @@ std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBloc
     {
       case TileId::RailBlock:
       {
+        auto path = createPath(current);
+
         if(current.node->tile().tileId == TileId::RailNXButton)
         {
-          current.path->m_nxButtonTo = current.node->tile().shared_ptr<NXButtonRailTile>();
+          path->m_nxButtonTo = current.node->tile().shared_ptr<NXButtonRailTile>();
         }
 
         auto& block = static_cast<BlockRailTile&>(tile);
-        current.path->m_toBlock = block.shared_ptr<BlockRailTile>();
-        current.path->m_toSide = nextNode.getLink(0).get() == current.link ? BlockSide::A : BlockSide::B;
-        paths.emplace_back(std::move(current.path));
+        path->m_toBlock = block.shared_ptr<BlockRailTile>();
+        path->m_toSide = nextNode.getLink(0).get() == current.link ? BlockSide::A : BlockSide::B;
+        paths.emplace_back(std::move(path));
         todo.pop(); // complete
         break;
       }
@@ -131,28 +233,27 @@ std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBloc
       case TileId::RailTurnoutSingleSlip:
       case TileId::RailTurnoutDoubleSlip:
       {
-        auto turnout = tile.shared_ptr<TurnoutRailTile>();
-        if(contains(current.path->m_turnouts, turnout))
+        if(hasStep(current, Step::Type::Turnout, tile))
         {
           todo.pop(); // drop it, can't pass turnout twice
           break;
         }
-        auto links = getTurnoutLinks(*turnout, *current.link);
+        auto links = getTurnoutLinks(static_cast<TurnoutRailTile&>(tile), *current.link);
         assert(!links.empty());
 
         if(links.size() > 1)
         {
           for(size_t i = 1; i < links.size(); ++i)
           {
-            auto path = std::make_shared<BlockPath>(*current.path); // "fork" path
-            path->m_turnouts.emplace_back(turnout, links[i].turnoutPosition);
-            todo.emplace(Position{std::move(path), &nextNode, nextNode.getLink(links[i].linkIndex).get()});
+            Position fork{current.side, current.step, &nextNode, nextNode.getLink(links[i].linkIndex).get()};
+            addStep(fork, Step::Type::Turnout, &tile, static_cast<uint8_t>(links[i].turnoutPosition));
+            todo.emplace(fork);
           }
         }
 
         current.node = &nextNode;
         current.link = nextNode.getLink(links[0].linkIndex).get();
-        current.path->m_turnouts.emplace_back(turnout, links[0].turnoutPosition);
+        addStep(current, Step::Type::Turnout, &tile, static_cast<uint8_t>(links[0].turnoutPosition));
         break;
       }
       case TileId::RailOneWay:
@@ -163,7 +264,7 @@ std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBloc
         //  0
         if(nextNode.getLink(0).get() == current.link) // 0 -> 1 = allowed
         {
-          current.path->m_tiles.emplace_back(tile.shared_ptr<RailTile>());
+          addStep(current, Step::Type::Tile, &tile);
           current.node = &nextNode;
           current.link = nextNode.getLink(1).get();
         }
@@ -183,7 +284,7 @@ std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBloc
         const bool sideA = nextNode.getLink(0).get() == current.link;
         current.node = &nextNode;
         current.link = nextNode.getLink(sideA ? 1 : 0).get();
-        current.path->m_directionControls.emplace_back(tile.shared_ptr<DirectionControlRailTile>(), sideA ? DirectionControlState::AtoB : DirectionControlState::BtoA);
+        addStep(current, Step::Type::DirectionControl, &tile, static_cast<uint8_t>(sideA ? DirectionControlState::AtoB : DirectionControlState::BtoA));
         break;
       }
       case TileId::RailBridge45Left:
@@ -200,7 +301,7 @@ std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBloc
           {
             current.node = &nextNode;
             current.link = nextNode.getLink((i + 2) % 4).get(); // opposite
-            current.path->m_bridges.emplace_back(tile.shared_ptr<BridgeRailTile>(), i % 2 == 0 ? BridgePath::AC : BridgePath::BD);
+            addStep(current, Step::Type::Bridge, &tile, static_cast<uint8_t>(i % 2 == 0 ? BridgePath::AC : BridgePath::BD));
             break;
           }
         }
@@ -214,8 +315,7 @@ std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBloc
         // 1 --+-- 3    |
         //     |       /|
         //     0      1 0
-        auto cross = tile.shared_ptr<CrossRailTile>();
-        if(contains(current.path->m_crossings, cross))
+        if(hasStep(current, Step::Type::Crossing, tile))
         {
           todo.pop(); // drop it, can't pass crossing twice
           break;
@@ -227,7 +327,7 @@ std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBloc
           {
             current.node = &nextNode;
             current.link = nextNode.getLink((i + 2) % 4).get(); // opposite
-            current.path->m_crossings.emplace_back(cross, i % 2 == 0 ? CrossState::AC : CrossState::BD);
+            addStep(current, Step::Type::Crossing, &tile, static_cast<uint8_t>(i % 2 == 0 ? CrossState::AC : CrossState::BD));
             break;
           }
         }
@@ -238,8 +338,8 @@ std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBloc
         auto& linkTile = static_cast<LinkRailTile&>(tile);
         if(linkTile.link) // is connected to another link
         {
-          current.path->m_tiles.emplace_back(linkTile.shared_ptr<RailTile>());
-          current.path->m_tiles.emplace_back(linkTile.link->shared_ptr<RailTile>());
+          addStep(current, Step::Type::Tile, &linkTile);
+          addStep(current, Step::Type::Tile, linkTile.link.value().get());
           assert(linkTile.link->node());
           auto& linkNode = linkTile.link->node()->get();
           current.node = &linkNode;
@@ -257,17 +357,17 @@ std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBloc
         if(nextNode.getLink(0).get() == current.link) // 0 -> 1 = frontside of signal
         {
           current.link = nextNode.getLink(1).get();
-          current.path->m_signals.emplace_back(tile.shared_ptr<SignalRailTile>());
+          addStep(current, Step::Type::Signal, &tile);
         }
         else // 1 -> 0 = backside of signal, just pass
         {
           current.link = nextNode.getLink(0).get();
-          current.path->m_tiles.emplace_back(tile.shared_ptr<RailTile>());
+          addStep(current, Step::Type::Tile, &tile);
         }
         break;
 
       case TileId::RailDecoupler:
-        current.path->m_tiles.emplace_back(tile.shared_ptr<RailTile>());
+        addStep(current, Step::Type::Tile, &tile);
         current.node = &nextNode;
         current.link = otherLink(nextNode, *current.link).get();
         break;
@@ -275,11 +375,11 @@ std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBloc
       case TileId::RailNXButton:
         if(&current.node->tile() == &startBlock)
         {
-          current.path->m_nxButtonFrom = tile.shared_ptr<NXButtonRailTile>();
+          addStep(current, Step::Type::NXButtonFrom, &tile);
         }
         else
         {
-          current.path->m_tiles.emplace_back(tile.shared_ptr<RailTile>());
+          addStep(current, Step::Type::Tile, &tile);
         }
         current.node = &nextNode;
         current.link = otherLink(nextNode, *current.link).get();
@@ -290,8 +390,7 @@ std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBloc
         // 1 2
         //  X
         // 0 3
-        auto crossOver = tile.shared_ptr<HiddenCrossOverRailTile>();
-        if(contains(current.path->m_crossOvers, crossOver))
+        if(hasStep(current, Step::Type::CrossOver, tile))
         {
           todo.pop(); // drop it, can't pass crossover twice
           break;
@@ -303,7 +402,7 @@ std::vector<std::shared_ptr<BlockPath>> BlockPath::find(BlockRailTile& startBloc
           {
             current.node = &nextNode;
             current.link = nextNode.getLink((i + 2) % 4).get(); // opposite
-            current.path->m_crossOvers.emplace_back(crossOver, i % 2 == 0 ? CrossState::AC : CrossState::BD);
+            addStep(current, Step::Type::CrossOver, &tile, static_cast<uint8_t>(i % 2 == 0 ? CrossState::AC : CrossState::BD));
             break;
           }
         }
@@ -330,28 +429,6 @@ BlockPath::BlockPath(BlockRailTile& block, BlockSide side)
 {
 }
 
-BlockPath::BlockPath(const BlockPath &other)
-  : Path(other)
-  , std::enable_shared_from_this<BlockPath>() // NOLINT(readability-redundant-member-init) -Wextra requires this
-  , m_fromBlock(other.m_fromBlock)
-  , m_fromSide(other.m_fromSide)
-  , m_toBlock(other.m_toBlock)
-  , m_toSide(other.m_toSide)
-  , m_tiles(other.m_tiles)
-  , m_turnouts(other.m_turnouts)
-  , m_directionControls(other.m_directionControls)
-  , m_crossings(other.m_crossings)
-  , m_bridges(other.m_bridges)
-  , m_signals(other.m_signals)
-  , m_nxButtonFrom(other.m_nxButtonFrom)
-  , m_nxButtonTo(other.m_nxButtonTo)
-  , m_delayReleaseTimer{EventLoop::ioContext}
-  , m_isReserved(false)
-  , m_delayedReleaseScheduled(false)
-{
-
-}
-
 bool BlockPath::operator ==(const BlockPath& other) const noexcept
 {
   return
@@ -363,6 +440,7 @@ bool BlockPath::operator ==(const BlockPath& other) const noexcept
     (m_turnouts == other.m_turnouts) &&
     (m_directionControls == other.m_directionControls) &&
     (m_crossings == other.m_crossings) &&
+    (m_crossOvers == other.m_crossOvers) &&
     (m_bridges == other.m_bridges) &&
     (m_signals == other.m_signals) &&
     (m_nxButtonFrom == other.m_nxButtonFrom) &&
@@ -75,7 +75,6 @@ class BlockPath : public Path, public std::enable_shared_from_this<BlockPath>
     static std::vector<std::shared_ptr<BlockPath>> find(BlockRailTile& block);
 
     BlockPath(BlockRailTile& block, BlockSide side);
-    BlockPath(const BlockPath& other);
 
     bool operator ==(const BlockPath& other) const noexcept;
 
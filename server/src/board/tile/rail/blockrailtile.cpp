@@ -583,6 +583,15 @@ void BlockRailTile::destroying()
   {
     zones->back()->blocks->remove(self);
   }
+  for(const auto& path : m_paths) // remove paths from this block
+  {
+    if(auto toBlock = path->toBlock())
+    {
+      auto& pathsIn = toBlock->m_pathsIn;
+      pathsIn.erase(std::remove(pathsIn.begin(), pathsIn.end(), path), pathsIn.end());
+    }
+  }
+  m_paths.clear();
   m_world.blockRailTiles->removeObject(self);
   RailTile::destroying();
 }
@@ -643,28 +652,26 @@ void BlockRailTile::updatePaths()
   m_paths.clear(); // make sure it is empty, it problably is after the move
   auto found = BlockPath::find(*this);
 
-  while(!current.empty()) // handle existing paths
+  for(auto& path : current) // handle existing paths
   {
     auto it = std::find_if(found.begin(), found.end(),
-      [&currentPath=*current.front()](const auto& foundPath)
+      [&currentPath=*path](const auto& foundPath)
       {
         return currentPath == *foundPath;
       });
 
-    if(it != found.end())
+    if(it != found.end()) // still exists, keep it
     {
       found.erase(it);
-      m_paths.emplace_back(std::move(current.front()));
+      m_paths.emplace_back(std::move(path));
     }
-    current.erase(current.begin());
-  }
-
-  for(auto& path : current) // no longer existing paths
-  {
-    auto& pathsIn = path->toBlock()->m_pathsIn;
-    if(auto it = std::find(pathsIn.begin(), pathsIn.end(), path); it != pathsIn.end())
+    else if(auto toBlock = path->toBlock()) // no longer existing path
     {
-      pathsIn.erase(it);
+      auto& pathsIn = toBlock->m_pathsIn;
+      if(auto itIn = std::find(pathsIn.begin(), pathsIn.end(), path); itIn != pathsIn.end())
+      {
+        pathsIn.erase(itIn);
+      }
     }
   }
 
@@ -111,6 +111,13 @@ class BlockRailTile : public RailTile
       return m_paths;
     }
 
+#ifdef TRAINTASTIC_TEST
+    const std::vector<std::shared_ptr<BlockPath>>& pathsIn() const
+    {
+      return m_pathsIn;
+    }
+#endif
+
     void inputItemValueChanged(BlockInputMapItem& item);
     void identificationEvent(BlockInputMapItem& item, IdentificationEventType eventType, uint16_t identifier, Direction direction, uint8_t category);
 
@@ -21,6 +21,7 @@
  */
 
 #include "linkrailtile.hpp"
+#include "../../boardlist.hpp"
 #include "../../list/linkrailtilelist.hpp"
 #include "../../../core/attributes.hpp"
 #include "../../../core/objectlisttablemodel.hpp"
@@ -38,10 +39,13 @@ LinkRailTile::LinkRailTile(World& world, std::string_view _id)
         if(newValue.get() == this)
           return false;
 
+        m_world.boards->tileModified(*this);
+
         if(link)
         {
           assert(link->link.value().get() == this);
           link->link.setValueInternal(nullptr);
+          m_world.boards->tileModified(*link);
         }
 
         if(newValue)
@@ -50,8 +54,10 @@ LinkRailTile::LinkRailTile(World& world, std::string_view _id)
           {
             assert(newValue->link->link.value() == newValue);
             newValue->link->link.setValueInternal(nullptr);
+            m_world.boards->tileModified(*newValue->link);
           }
           newValue->link.setValueInternal(shared_ptr<LinkRailTile>());
+          m_world.boards->tileModified(*newValue);
         }
 
         return true;
@@ -34,6 +34,6 @@ void RailTile::setReservedState(uint8_t value)
   {
     m_reservedState = value;
     auto& board = getBoard();
-    board.tileDataChanged(board, location(), data());
+    board.tileStateChanged(board, location(), m_reservedState);
   }
 }
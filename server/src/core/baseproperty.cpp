@@ -26,5 +26,9 @@
 void BaseProperty::changed()
 {
   if(!m_object.dying())
+  {
     m_object.propertyChanged(*this);
+    if(isStateStoreable())
+      m_object.stateChanged(m_object);
+  }
 }
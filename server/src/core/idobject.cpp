@@ -62,6 +62,11 @@ void IdObject::addToWorld()
   m_world.m_objects.emplace(id, weak_from_this());
 }
 
+void IdObject::stateChanged(Object& object)
+{
+  m_world.stateChanged(object);
+}
+
 void IdObject::worldEvent(WorldState state, WorldEvent event)
 {
   Object::worldEvent(state, event);
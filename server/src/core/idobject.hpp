@@ -70,6 +70,8 @@ class IdObject : public Object
 
     std::string getObjectId() const final { return id.value(); }
     World& world() const { return m_world; }
+
+    void stateChanged(Object& object) override;
 };
 
 #endif
@@ -37,6 +37,7 @@ class AbstractValuesAttribute;
 class InterfaceItem
 {
   friend struct Attributes;
+  friend class InterfaceItems;
 
   public:
     using Attributes = std::unordered_map<AttributeName, std::unique_ptr<AbstractAttribute>>;
@@ -44,6 +45,7 @@ class InterfaceItem
   protected:
     Object& m_object;
     std::string_view m_name;
+    uint16_t m_id = 0; //!< set by InterfaceItems
     Attributes m_attributes;
 
     template<typename T>
@@ -132,6 +134,12 @@ class InterfaceItem
       return m_name;
     }
 
+    //! Item id, unique within the object, used on the wire instead of the name
+    uint16_t id() const
+    {
+      return m_id;
+    }
+
     const Attributes& attributes() const
     {
       return m_attributes;
@@ -23,6 +23,8 @@
 #include "interfaceitems.hpp"
 #include "interfaceitem.hpp"
 #include <algorithm>
+#include <cassert>
+#include <limits>
 
 #ifndef NDEBUG
 #include "abstractproperty.hpp"
@@ -50,6 +52,7 @@ void InterfaceItems::add(InterfaceItem& item)
 #endif
   m_items.emplace(item.name(), item);
   m_itemOrder.push_back(item.name());
+  addId(item);
 }
 
 void InterfaceItems::insertBefore(InterfaceItem& item, const InterfaceItem& before)
@@ -59,4 +62,12 @@ void InterfaceItems::insertBefore(InterfaceItem& item, const InterfaceItem& befo
 #endif
   m_items.emplace(item.name(), item);
   m_itemOrder.insert(std::find(m_itemOrder.begin(), m_itemOrder.end(), before.name()), item.name());
+  addId(item);
+}
+
+void InterfaceItems::addId(InterfaceItem& item)
+{
+  assert(m_itemsById.size() <= std::numeric_limits<uint16_t>::max());
+  item.m_id = static_cast<uint16_t>(m_itemsById.size());
+  m_itemsById.push_back(&item);
 }
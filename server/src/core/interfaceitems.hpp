@@ -25,7 +25,9 @@
 
 #include <unordered_map>
 #include <list>
+#include <vector>
 #include <string_view>
+#include <cstdint>
 
 class InterfaceItem;
 
@@ -34,6 +36,9 @@ class InterfaceItems
   protected:
     std::unordered_map<std::string_view, InterfaceItem&> m_items;
     std::list<std::string_view> m_itemOrder;
+    std::vector<InterfaceItem*> m_itemsById;
+
+    void addId(InterfaceItem& item);
 
   public:
     using const_iterator = std::unordered_map<std::string_view, InterfaceItem&>::const_iterator;
@@ -45,6 +50,11 @@ class InterfaceItems
 
     InterfaceItem* find(std::string_view name) const;
 
+    inline InterfaceItem* findById(uint16_t id) const
+    {
+      return id < m_itemsById.size() ? m_itemsById[id] : nullptr;
+    }
+
     void add(InterfaceItem& item);
     void insertBefore(InterfaceItem& item, const InterfaceItem& before);
 
@@ -132,13 +132,27 @@ void Object::save(WorldSaver& saver, nlohmann::json& data, nlohmann::json& state
       {
         data[std::string{baseProperty->name()}] = toJSON(saver, *baseProperty);
       }
-      else if(baseProperty->isStateStoreable())
+    }
+
+  saveState(saver, state);
+}
+
+void Object::saveState(WorldSaver& saver, nlohmann::json& state) const
+{
+  for(const auto& item : interfaceItems())
+    if(BaseProperty* baseProperty = dynamic_cast<BaseProperty*>(&item.second))
+    {
+      if(baseProperty->isStateStoreable())
       {
         state[std::string{baseProperty->name()}] = toJSON(saver, *baseProperty);
       }
     }
 }
 
+void Object::stateChanged(Object& /*object*/)
+{
+}
+
 void Object::loaded()
 {
   for(const auto& it : m_interfaceItems)
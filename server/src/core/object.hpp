@@ -24,6 +24,7 @@
 #define TRAINTASTIC_SERVER_CORE_OBJECT_HPP
 
 #include "objectptr.hpp"
+#include <vector>
 #include <boost/signals2/signal.hpp>
 #include <nlohmann/json.hpp>
 #include "interfaceitems.hpp"
@@ -46,18 +47,21 @@ class AbstractAttribute;
 class AbstractEvent;
 class WorldLoader;
 class WorldSaver;
+template<typename Thandle, typename Titem> class HandleList;
 
 class Object : public std::enable_shared_from_this<Object>
 {
   friend class World;
   friend class WorldLoader;
   friend class WorldSaver;
+  template<typename Thandle, typename Titem> friend class HandleList;
 
   private:
     static nlohmann::json toJSON(WorldSaver& saver, const BaseProperty& baseProperty);
     static void loadJSON(WorldLoader& loader, BaseProperty& baseProperty, const nlohmann::json& value);
 
     bool m_dying; // TODO: atomic??
+    std::vector<std::pair<const void*, uint32_t>> m_sessionHandles; //!< handle list + handle, one per session that has a handle for this object
 
   protected:
     InterfaceItems m_interfaceItems;
@@ -89,6 +93,7 @@ class Object : public std::enable_shared_from_this<Object>
     virtual void destroying() {}
     virtual void load(WorldLoader& loader, const nlohmann::json& data);
     virtual void save(WorldSaver& saver, nlohmann::json& data, nlohmann::json& state) const;
+    virtual void saveState(WorldSaver& saver, nlohmann::json& state) const;
     virtual void loaded();
     virtual void worldEvent(WorldState state, WorldEvent event);
 
@@ -107,6 +112,13 @@ class Object : public std::enable_shared_from_this<Object>
     inline bool dying() const noexcept { return m_dying; }
     void destroy();
 
+    /**
+     * \brief Called when the state of \a object has changed
+     *
+     * \a object is this object or one of its sub objects, it is passed up to the world which records it in the state journal.
+     */
+    virtual void stateChanged(Object& object);
+
     template <typename Derived>
     inline std::shared_ptr<const Derived> shared_ptr_c() const
     {
@@ -26,11 +26,14 @@
 void StateObject::addToWorld(World& world, StateObject& object)
 {
   world.m_objects.emplace(object.getObjectId(), object.weak_from_this());
+  object.m_world = &world;
+  world.stateChanged(object);
 }
 
 void StateObject::removeFromWorld(World& world, StateObject& object)
 {
   world.m_objects.erase(object.m_id);
+  world.stateChanged(object);
 }
 
 StateObject::StateObject(std::string id)
@@ -39,6 +42,12 @@ StateObject::StateObject(std::string id)
   assert(!m_id.empty());
 }
 
+void StateObject::stateChanged(Object& object)
+{
+  if(m_world) // not yet added to the world while being created
+    m_world->stateChanged(object);
+}
+
 void StateObject::save(WorldSaver& saver, nlohmann::json& data, nlohmann::json& state) const
 {
 #ifndef NDEBUG
@@ -35,6 +35,7 @@ class StateObject : public Object
 {
 private:
   std::string m_id;
+  World* m_world = nullptr;
 
 protected:
   static void removeFromWorld(World& world, StateObject& object);
@@ -50,6 +51,8 @@ public:
   {
     return m_id;
   }
+
+  void stateChanged(Object& object) final;
 };
 
 #endif
@@ -35,3 +35,8 @@ std::string SubObject::getObjectId() const
   value += m_parentPropertyName;
   return value;
 }
+
+void SubObject::stateChanged(Object& object)
+{
+  m_parent.stateChanged(object);
+}
@@ -36,6 +36,8 @@ class SubObject : public Object
 
     Object& parent() const { return m_parent; }
     std::string getObjectId() const final;
+
+    void stateChanged(Object& object) override;
 };
 
 #endif
@@ -56,6 +56,8 @@ class DecoderFunction : public Object
 
     std::string getObjectId() const final;
 
+    void stateChanged(Object& object) final;
+
     const Decoder& decoder() const { return m_decoder; }
     Decoder& decoder() { return m_decoder; }
 };
@@ -0,0 +1,84 @@
+/**
+ * server/src/hardware/input/inputvalues.cpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "inputvalues.hpp"
+#include <algorithm>
+#include <bit>
+
+void InputValues::resize(size_t size)
+{
+  m_size = size;
+  m_values.assign((size + wordBits - 1) / wordBits, 0);
+  m_known.assign(m_values.size(), 0);
+}
+
+void InputValues::reset()
+{
+  std::fill(m_known.begin(), m_known.end(), 0);
+}
+
+bool InputValues::set(size_t index, bool value)
+{
+  assert(index < m_size);
+  const size_t word = index / wordBits;
+  const Word mask = Word(1) << (index % wordBits);
+  const Word bit = value ? mask : 0;
+  if((m_known[word] & mask) && (m_values[word] & mask) == bit)
+    return false;
+  m_values[word] = (m_values[word] & ~mask) | bit;
+  m_known[word] |= mask;
+  return true;
+}
+
+void InputValues::update(size_t index, uint64_t bits, size_t count, Changes& changes)
+{
+  assert(count <= wordBits);
+  assert(index + count <= m_size);
+
+  while(count != 0)
+  {
+    const size_t word = index / wordBits;
+    const size_t shift = index % wordBits;
+    const size_t n = std::min(count, wordBits - shift);
+    const Word mask = (n == wordBits ? ~Word(0) : ((Word(1) << n) - 1)) << shift;
+    const Word values = (bits << shift) & mask;
+
+    Word diff = ((m_values[word] ^ values) | ~m_known[word]) & mask;
+    if(diff != 0)
+    {
+      m_values[word] = (m_values[word] & ~mask) | values;
+      m_known[word] |= mask;
+
+      do
+      {
+        const auto bit = static_cast<size_t>(std::countr_zero(diff));
+        changes.push_back({static_cast<uint32_t>(word * wordBits + bit), (values >> bit) & 1 ? TriState::True : TriState::False});
+        diff &= diff - 1;
+      }
+      while(diff != 0);
+    }
+
+    bits = n == wordBits ? 0 : bits >> n;
+    index += n;
+    count -= n;
+  }
+}
@@ -0,0 +1,105 @@
+/**
+ * server/src/hardware/input/inputvalues.hpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TRAINTASTIC_SERVER_HARDWARE_INPUT_INPUTVALUES_HPP
+#define TRAINTASTIC_SERVER_HARDWARE_INPUT_INPUTVALUES_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <vector>
+#include <traintastic/enum/tristate.hpp>
+
+/**
+ * @brief Packed input state storage for protocol kernels
+ *
+ * Stores a value and a known bit per input, so an input is
+ * \c TriState::Undefined until its value is set. Multiple inputs can be
+ * updated at once, changes are detected per 64 bit word.
+ */
+class InputValues
+{
+  public:
+    struct Change
+    {
+      uint32_t index;
+      TriState value;
+    };
+
+    using Changes = std::vector<Change>;
+
+  private:
+    using Word = uint64_t;
+    static constexpr size_t wordBits = 64;
+
+    std::vector<Word> m_values;
+    std::vector<Word> m_known;
+    size_t m_size = 0;
+
+  public:
+    explicit InputValues(size_t size = 0)
+    {
+      resize(size);
+    }
+
+    size_t size() const
+    {
+      return m_size;
+    }
+
+    //! Resize and set all inputs to \c TriState::Undefined
+    void resize(size_t size);
+
+    //! Set all inputs to \c TriState::Undefined
+    void reset();
+
+    TriState operator [](size_t index) const
+    {
+      assert(index < m_size);
+      const Word mask = Word(1) << (index % wordBits);
+      if(!(m_known[index / wordBits] & mask))
+        return TriState::Undefined;
+      return (m_values[index / wordBits] & mask) ? TriState::True : TriState::False;
+    }
+
+    /**
+     * @brief Set input value
+     * @param[in] index Input index
+     * @param[in] value Input value
+     * @return \c true if the value changed, \c false otherwise
+     */
+    bool set(size_t index, bool value);
+
+    /**
+     * @brief Set multiple input values
+     *
+     * Bit \c n of \a bits is the value of input \a index + \c n.
+     *
+     * @param[in] index Index of the first input
+     * @param[in] bits Input values
+     * @param[in] count Number of inputs, max. 64
+     * @param[out] changes Changed inputs are appended, in index order
+     */
+    void update(size_t index, uint64_t bits, size_t count, Changes& changes);
+};
+
+#endif
@@ -309,32 +309,32 @@ void HSI88Interface::receive(std::string_view message)
     case 'i':
     {
       const uint8_t moduleCount = message[1];
+      InputValues::Changes changes;
       for(uint8_t i = 0; i < moduleCount; i++)
       {
         const uint8_t module = message[2 + 3 * i];
+        if(module == 0 || module * inputsPerModule > m_inputValues.size()) /*[[unlikely]]*/
+          continue;
         const uint16_t bits = static_cast<uint16_t>(message[3 + 3 * i]) << 8 | message[4 + 3 * i];
-        for(uint8_t j = 0; j < inputsPerModule; j++)
-        {
-          const TriState value = (bits & (static_cast<uint16_t>(1) << j)) ? TriState::True : TriState::False;
-          const uint32_t index = (module - 1) * inputsPerModule + j;
+        m_inputValues.update((module - 1) * inputsPerModule, bits, inputsPerModule, changes);
+      }
 
-          if(m_inputValues[index] != value)
+      if(!changes.empty())
+      {
+        EventLoop::call(
+          [this, changes=std::move(changes)]()
           {
-            m_inputValues[index] = value;
-
-            EventLoop::call(
-              [this, index, value]()
-              {
-                const auto moduleIndex = index / inputsPerModule;
-                if(moduleIndex < modulesLeft.value())
-                  updateInputValue(InputChannel::S88_Left, inputAddressMin + index, value);
-                else if(moduleIndex < (modulesLeft.value() + modulesMiddle.value()))
-                  updateInputValue(InputChannel::S88_Middle, inputAddressMin + index - modulesLeft.value() * inputsPerModule, value);
-                else
-                  updateInputValue(InputChannel::S88_Right, inputAddressMin + index - (modulesLeft.value() + modulesMiddle.value()) * inputsPerModule, value);
-              });
-          }
-        }
+            for(const auto& change : changes)
+            {
+              const auto moduleIndex = change.index / inputsPerModule;
+              if(moduleIndex < modulesLeft.value())
+                updateInputValue(InputChannel::S88_Left, inputAddressMin + change.index, change.value);
+              else if(moduleIndex < (modulesLeft.value() + modulesMiddle.value()))
+                updateInputValue(InputChannel::S88_Middle, inputAddressMin + change.index - modulesLeft.value() * inputsPerModule, change.value);
+              else
+                updateInputValue(InputChannel::S88_Right, inputAddressMin + change.index - (modulesLeft.value() + modulesMiddle.value()) * inputsPerModule, change.value);
+            }
+          });
       }
       break;
     }
@@ -346,7 +346,6 @@ void HSI88Interface::receive(std::string_view message)
         sendNext();
       }
       m_inputValues.resize(message[1] * inputsPerModule);
-      std::fill(m_inputValues.begin(), m_inputValues.end(), TriState::Undefined);
       break;
 
     case 't':
@@ -32,6 +32,7 @@
 #include <boost/asio/serial_port.hpp>
 #include "../../core/serialdeviceproperty.hpp"
 #include "../input/inputcontroller.hpp"
+#include "../input/inputvalues.hpp"
 
 /**
  * \brief HSI-88 hardware interface
@@ -65,7 +66,7 @@ class HSI88Interface final
     size_t m_writeBufferOffset = 0;
     bool m_waitingForReply = false;
     bool m_simulation = false;
-    std::vector<TriState> m_inputValues;
+    InputValues m_inputValues;
     std::atomic<bool> m_debugLogRXTX;
 
 #ifndef NDEBUG
@@ -229,8 +229,10 @@ bool MarklinCANInterface::setOnline(bool& value, bool simulation)
       m_kernel->setOnLocomotiveListChanged(
         [this](const std::shared_ptr<MarklinCAN::LocomotiveList>& list)
         {
+          m_locomotiveList = list;
           marklinCANLocomotiveList->setData(list);
         });
+      m_kernel->setLocomotiveList(m_locomotiveList);
 
       m_kernel->setDecoderController(this);
       m_kernel->setInputController(this);
@@ -52,6 +52,7 @@ class MarklinCANInterface final
 
   private:
     std::unique_ptr<MarklinCAN::Kernel> m_kernel;
+    std::shared_ptr<MarklinCAN::LocomotiveList> m_locomotiveList; //!< kept when offline, to skip unchanged list download
     boost::signals2::connection m_marklinCANPropertyChanged;
 
     void addToWorld() final;
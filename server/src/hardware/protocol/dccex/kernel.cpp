@@ -36,9 +36,17 @@
 #include "../../../utils/inrange.hpp"
 #include "../../../utils/fromchars.hpp"
 #include "../../../utils/displayname.hpp"
+#include "../../../utils/tokenizer.hpp"
 
 namespace DCCEX {
 
+template<class T>
+static bool nextNumber(Tokenizer& tokens, T& value)
+{
+  std::string_view token;
+  return tokens.next(token) && fromChars(token, value).ec == std::errc();
+}
+
 Kernel::Kernel(std::string logId_, const Config& config, bool simulation)
   : KernelBase(std::move(logId_))
   , m_simulation{simulation}
@@ -140,112 +148,115 @@ void Kernel::receive(std::string_view message)
         Log::log(logId, LogMessage::D2002_RX_X, msg);
       });
 
-  if(message.size() > 1 && message[0] == '<')
+  // <opcode arguments...>
+  message = rtrim(message, {'\r', '\n'});
+  if(message.size() < 3 || message.front() != '<' || message.back() != '>')
+    return;
+
+  Tokenizer tokens(message.substr(1, message.size() - 2), ' ');
+  std::string_view opcode;
+  if(!tokens.next(opcode))
+    return;
+
+  switch(opcode[0])
   {
-    switch(message[1])
+    case 'H': // Turnout response
     {
-      case 'H': // Turnout response
+      uint16_t id;
+      std::string_view state;
+      if(opcode.size() == 1 && nextNumber(tokens, id) && tokens.next(state))
       {
-        uint16_t id;
-        if(auto r = fromChars(message.substr(3), id); r.ec == std::errc())
-        {
-          const char state = *(r.ptr + 1);
-          TriState value = TriState::Undefined;
+        TriState value = TriState::Undefined;
 
-          if(state == '0' || state == 'C')
-            value = TriState::False;
-          else if(state == '1' || state == 'T')
-            value = TriState::True;
+        if(state == "0" || state == "C")
+          value = TriState::False;
+        else if(state == "1" || state == "T")
+          value = TriState::True;
 
-          if(value != TriState::Undefined)
-          {
+        if(value != TriState::Undefined)
+        {
+          EventLoop::call(
+            [this, id, value]()
+            {
+              m_outputController->updateOutputValue(OutputChannel::Turnout, id, value);
+            });
+        }
+      }
+      break;
+    }
+    case 'p': // Power on/off response
+      if(opcode == "p0")
+      {
+        if(m_powerOn != TriState::False)
+        {
+          m_powerOn = TriState::False;
+
+          if(m_onPowerOnChanged)
             EventLoop::call(
-              [this, id, value]()
+              [this]()
               {
-                m_outputController->updateOutputValue(OutputChannel::Turnout, id, value);
+                m_onPowerOnChanged(false);
               });
-          }
         }
-        break;
       }
-      case 'p': // Power on/off response
-        if(message[2] == '0')
-        {
-          if(m_powerOn != TriState::False)
-          {
-            m_powerOn = TriState::False;
-
-            if(m_onPowerOnChanged)
-              EventLoop::call(
-                [this]()
-                {
-                  m_onPowerOnChanged(false);
-                });
-          }
-        }
-        else if(message[2] == '1')
+      else if(opcode == "p1")
+      {
+        if(m_powerOn != TriState::True)
         {
-          if(m_powerOn != TriState::True)
-          {
-            m_powerOn = TriState::True;
-
-            if(m_onPowerOnChanged)
-              EventLoop::call(
-                [this]()
-                {
-                  m_onPowerOnChanged(true);
-                });
-          }
+          m_powerOn = TriState::True;
+
+          if(m_onPowerOnChanged)
+            EventLoop::call(
+              [this]()
+              {
+                m_onPowerOnChanged(true);
+              });
         }
-        break;
+      }
+      break;
 
-      case 'q': // Sensor/Input: ACTIVE to INACTIVE
-      case 'Q': // Sensor/Input: INACTIVE to ACTIVE
-        if(m_inputController && message[2] == ' ')
+    case 'q': // Sensor/Input: ACTIVE to INACTIVE
+    case 'Q': // Sensor/Input: INACTIVE to ACTIVE
+      if(uint32_t id; m_inputController && opcode.size() == 1 && nextNumber(tokens, id) && tokens.remaining().empty() && id <= idMax)
+      {
+        const bool value = opcode[0] == 'Q';
+        auto it = m_inputValues.find(id);
+        if(it == m_inputValues.end() || it->second != value)
         {
-          uint32_t id;
-          if(auto r = fromChars(message.substr(3), id); r.ec == std::errc() && *r.ptr == '>' && id <= idMax)
-          {
-            const bool value = message[1] == 'Q';
-            auto it = m_inputValues.find(id);
-            if(it == m_inputValues.end() || it->second != value)
+          m_inputValues[id] = value;
+
+          EventLoop::call(
+            [this, id, value]()
             {
-              m_inputValues[id] = value;
-
-              EventLoop::call(
-                [this, id, value]()
-                {
-                  m_inputController->updateInputValue(InputChannel::Input, id, toTriState(value));
-                });
-            }
-          }
+              m_inputController->updateInputValue(InputChannel::Input, id, toTriState(value));
+            });
         }
-        break;
+      }
+      break;
 
-      case 'Y': // Output response
+    case 'Y': // Output response
+    {
+      uint16_t id;
+      std::string_view state;
+      if(opcode.size() == 1 && nextNumber(tokens, id) && tokens.next(state))
       {
-        uint16_t id;
-        if(auto r = fromChars(message.substr(3), id); r.ec == std::errc())
-        {
-          const char state = *(r.ptr + 1);
-          TriState value = TriState::Undefined;
+        TriState value = TriState::Undefined;
 
-          if(state == '0')
-            value = TriState::False;
-          else if(state == '1')
-            value = TriState::True;
+        if(state == "0")
+          value = TriState::False;
+        else if(state == "1")
+          value = TriState::True;
 
-          if(value != TriState::Undefined)
-          {
-            EventLoop::call(
-              [this, id, value]()
-              {
-                m_outputController->updateOutputValue(OutputChannel::Output, id, value);
-              });
-          }
+        if(value != TriState::Undefined)
+        {
+          EventLoop::call(
+            [this, id, value]()
+            {
+              m_outputController->updateOutputValue(OutputChannel::Output, id, value);
+            });
         }
-        break;
       }
+      break;
     }
   }
 }
@@ -71,7 +71,8 @@ class Kernel : public ::KernelBase
 
     void setIOHandler(std::unique_ptr<IOHandler> handler);
 
-    void postSend(const std::string& message)
+    template<class T>
+    void postSend(const T& message)
     {
       m_ioContext.post(
         [this, message]()
@@ -23,16 +23,20 @@
 #ifndef TRAINTASTIC_SERVER_HARDWARE_PROTOCOL_DCCEX_MESSAGES_HPP
 #define TRAINTASTIC_SERVER_HARDWARE_PROTOCOL_DCCEX_MESSAGES_HPP
 
+#include <cassert>
 #include <string_view>
 #include <span>
 #include <traintastic/enum/direction.hpp>
-#include "../../../utils/tohex.hpp"
+#include "../../../utils/stringbuilder.hpp"
 
 namespace DCCEX {
 
 namespace Messages {
   // see: https://dcc-ex.com/reference/software/command-reference.html
 
+  //! Command buffer, large enough for the longest DCC-EX command
+  using Buffer = StringBuilder<32>;
+
   enum class Track {
     Main,
     Programming,
@@ -182,17 +186,19 @@ namespace Messages {
     return "<!>\n";
   }
 
-  inline std::string setLocoSpeedAndDirection(uint16_t address, uint8_t speed, bool emergencyStop, Direction direction)
+  inline Buffer setLocoSpeedAndDirection(uint16_t address, uint8_t speed, bool emergencyStop, Direction direction)
   {
     assert(address <= 10293);
     assert(speed <= 126);
 
-    return std::string("<t 1 ")
-      .append(std::to_string(address))
-      .append(" ")
-      .append(emergencyStop ? "-1" : std::to_string(speed))
-      .append(direction == Direction::Forward ? " 1" : " 0")
-      .append(">\n");
+    Buffer s("<t 1 ");
+    s.append(address).append(' ');
+    if(emergencyStop)
+      s.append("-1");
+    else
+      s.append(speed);
+    s.append(direction == Direction::Forward ? " 1" : " 0").append(">\n");
+    return s;
   }
 
   constexpr std::string_view forgetLocos()
@@ -200,99 +206,99 @@ namespace Messages {
     return "<->\n";
   }
 
-  inline std::string forgetLoco(uint16_t address)
+  inline Buffer forgetLoco(uint16_t address)
   {
     assert(address <= 10293);
 
-    return std::string("<- ")
-      .append(std::to_string(address))
+    return Buffer("<- ")
+      .append(address)
       .append(">\n");
   }
 
-  inline std::string setLocoFunction(uint16_t address, uint8_t function, bool value)
+  inline Buffer setLocoFunction(uint16_t address, uint8_t function, bool value)
   {
     assert(address <= 10293);
     assert(function <= 68);
 
-    return std::string("<F ")
-      .append(std::to_string(address))
-      .append(" ")
-      .append(std::to_string(function))
+    return Buffer("<F ")
+      .append(address)
+      .append(' ')
+      .append(function)
       .append(value ? " 1" : " 0")
       .append(">\n");
   }
 
-  inline std::string setAccessory(uint16_t linearAddress, bool activate)
+  inline Buffer setAccessory(uint16_t linearAddress, bool activate)
   {
     assert(linearAddress >= 1 && linearAddress <= 2044);
 
-    return std::string("<a ")
-      .append(std::to_string(linearAddress))
+    return Buffer("<a ")
+      .append(linearAddress)
       .append(activate ? " 1" : " 0")
       .append(">\n");
   }
 
-  inline std::string setAccessory(uint16_t address, uint8_t subAddress, bool activate)
+  inline Buffer setAccessory(uint16_t address, uint8_t subAddress, bool activate)
   {
     assert(address <= 511);
     assert(subAddress <= 3);
 
-    return std::string("<a ")
-      .append(std::to_string(address))
-      .append(" ")
-      .append(std::to_string(subAddress))
+    return Buffer("<a ")
+      .append(address)
+      .append(' ')
+      .append(subAddress)
       .append(activate ? " 1" : " 0")
       .append(">\n");
   }
 
-  inline std::string setTurnout(uint16_t id, bool throw_)
+  inline Buffer setTurnout(uint16_t id, bool throw_)
   {
     assert(id <= 32767);
 
-    return std::string("<T ")
-      .append(std::to_string(id))
+    return Buffer("<T ")
+      .append(id)
       .append(throw_ ? " 1" : " 0")
       .append(">\n");
   }
 
-  inline std::string setTurnoutResponse(uint16_t id, bool state)
+  inline Buffer setTurnoutResponse(uint16_t id, bool state)
   {
     assert(id <= 32767);
 
-    return std::string("<H ")
-      .append(std::to_string(id))
+    return Buffer("<H ")
+      .append(id)
       .append(state ? " 1" : " 0")
       .append(">\n");
   }
 
-  inline std::string setOutput(uint16_t id, bool state)
+  inline Buffer setOutput(uint16_t id, bool state)
   {
     assert(id <= 32767);
 
-    return std::string("<Z ")
-      .append(std::to_string(id))
+    return Buffer("<Z ")
+      .append(id)
       .append(state ? " 1" : " 0")
       .append(">\n");
   }
 
-  inline std::string setOutputResponse(uint16_t id, bool state)
+  inline Buffer setOutputResponse(uint16_t id, bool state)
   {
     assert(id <= 32767);
 
-    return std::string("<Y ")
-      .append(std::to_string(id))
+    return Buffer("<Y ")
+      .append(id)
       .append(state ? " 1" : " 0")
       .append(">\n");
   }
 
-  inline std::string sensorTransition(uint16_t id, bool active)
+  inline Buffer sensorTransition(uint16_t id, bool active)
   {
     assert(id <= 32767);
 
     if(active)
-      return std::string("<Q ").append(std::to_string(id)).append(">\n");
+      return Buffer("<Q ").append(id).append(">\n");
     else
-      return std::string("<q ").append(std::to_string(id)).append(">\n");
+      return Buffer("<q ").append(id).append(">\n");
   }
 
   inline std::string_view setSpeedSteps(uint8_t value)
@@ -307,19 +313,20 @@ namespace Messages {
     return "";
   }
 
-  inline std::string dccPacket(std::span<const uint8_t> packet, Track track = Track::Main)
+  inline Buffer dccPacket(std::span<const uint8_t> packet, Track track = Track::Main)
   {
     assert(packet.size() <= 5);
     assert(track == Track::Main || track == Track::Programming);
-    std::string command(track == Track::Programming ? "<P" : "<M");
-    command.append(" 0 "); // register 0
-    command.append(toHex(packet.data(), packet.size(), true));
+    Buffer command(track == Track::Programming ? "<P" : "<M");
+    command.append(" 0"); // register 0
+    for(uint8_t byte : packet)
+      command.append(' ').appendHex(byte);
     command.append(">\n");
     return command;
   }
 
   template<class T, std::enable_if_t<std::is_trivially_copyable_v<T> && sizeof(T) <= 5, bool> = true>
-  inline std::string dccPacket(const T& packet, Track track = Track::Main)
+  inline Buffer dccPacket(const T& packet, Track track = Track::Main)
   {
     return dccPacket(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&packet), sizeof(T)), track);
   }
@@ -26,201 +26,110 @@
 #include "../../../utils/startswith.hpp"
 #include "../../../utils/fromchars.hpp"
 #include "../../../utils/rtrim.hpp"
+#include "../../../utils/tokenizer.hpp"
 
 namespace ECoS {
 
 static const std::string_view startDelimiterReply = "<REPLY ";
+static const std::string_view startDelimiterEvent = "<EVENT ";
 static const std::string_view endDelimiter = "<END ";
 
-bool parseRequest(std::string_view message, Request& request)
+//! Split command(objectId, options) into its parts
+static bool parseCommand(std::string_view text, std::string_view& command, uint16_t& objectId, std::string_view& options)
 {
-  // read command:
-  size_t pos;
-  if((pos = message.find('(')) == std::string_view::npos)
+  const size_t pos = text.find('(');
+  if(pos == std::string_view::npos || text.back() != ')')
     return false;
-  request.command = message.substr(0, pos);
+  command = text.substr(0, pos);
 
-  // read objectId:
-  auto r = fromChars(message.substr(pos + 1), request.objectId);
-  if(r.ec != std::errc())
+  Tokenizer arguments(text.substr(pos + 1, text.size() - pos - 2), ',', true);
+  std::string_view id;
+  if(!arguments.next(id) || fromChars(id, objectId).ec != std::errc())
     return false;
-
-  // read arguments
-  size_t n = r.ptr - message.data();
-  while((pos = std::min(std::min(message.find(',', n), message.find(')', n)), message.find('[', n))) != std::string_view::npos)
-  {
-    if(message[pos] == '[')
-    {
-      if((pos = message.find(']', pos)) == std::string_view::npos)
-        return false;
-      if((pos = std::min(message.find(',', pos), message.find(')', pos))) == std::string_view::npos)
-        return false;
-    }
-    while(message[n] == ' ' && n < pos)
-      n++;
-    if(pos > n)
-      request.options.emplace_back(&message[n], pos - n);
-    if(message[pos] == ')')
-      break;
-    n = pos + 1;
-  }
-
+  options = arguments.remaining();
   return true;
 }
 
-bool isReply(std::string_view message)
-{
-  return startsWith(message, startDelimiterReply);
-}
-
-bool parseReply(std::string_view message, Reply& reply)
+//! Read the lines and \<END status (message)\> of a reply or event
+template<class T>
+static bool parseBody(std::string_view text, T& message)
 {
-  if(!isReply(message))
-    return false;
-
-  size_t n = startDelimiterReply.size();
-  size_t pos;
-  if((pos = message.find('(', n)) == std::string_view::npos)
-    return false;
-
-  // read command:
-  reply.command = message.substr(n, pos - n);
-  n = pos + 1;
-
-  // read objectId
-  auto r = std::from_chars(&message[n], &message[message.size() - 1], reply.objectId);
-  if(r.ec != std::errc())
-    return false;
-
-  // read arguments
-  n = r.ptr - message.data();
-  while((pos = std::min(std::min(message.find(',', n), message.find(')', n)), message.find('[', n))) != std::string_view::npos)
-  {
-    if(message[pos] == '[')
-    {
-      if((pos = message.find(']', pos)) == std::string_view::npos)
-        return false;
-      if((pos = std::min(message.find(',', pos), message.find(')', pos))) == std::string_view::npos)
-        return false;
-    }
-    while(message[n] == ' ' && n < pos)
-      n++;
-    if(pos > n)
-      reply.options.emplace_back(&message[n], pos - n);
-    if(message[pos] == ')')
-      break;
-    n = pos + 1;
-  }
-  if(pos == std::string_view::npos || pos + 1 >= message.size() || message[pos + 1] != '>')
-    return false;
-
-  // advance to next line
-  n = pos + 2;
-  while((message[n] == '\n' || message[n] == '\r') && n < message.size())
-    n++;
-  if(n >= message.size())
-    return false;
-
-  // find end
   size_t end;
-  if((end = message.find(endDelimiter, n)) == std::string_view::npos)
+  if((end = text.find(endDelimiter)) == std::string_view::npos)
     return false;
-
-  // read lines
-  if(end > n)
-  {
-    while((pos = message.find('\n', n)) < end)
-    {
-      reply.lines.emplace_back(rtrim({&message[n], pos - n}, '\r'));
-      n = pos + 1;
-    }
-  }
+  message.lines = text.substr(0, end);
 
   // read status code
+  text.remove_prefix(end + endDelimiter.size());
   std::underlying_type_t<Status> status;
-  r = std::from_chars(&message[end + endDelimiter.size()], &message[message.size() - 1], status);
+  auto r = fromChars(text, status);
   if(r.ec != std::errc())
     return false;
-  reply.status = static_cast<Status>(status);
-  n = r.ptr - message.data();
+  message.status = static_cast<Status>(status);
 
   // read status message
-  while(message[n] != '(' && message[n] != '\n' && message[n] != '\r' && n < message.size())
-    n++;
-  if(n >= message.size() || message[n] != '(')
+  text.remove_prefix(r.ptr - text.data());
+  size_t pos;
+  if((pos = text.find_first_of("(\r\n")) == std::string_view::npos || text[pos] != '(')
+    return false;
+  text.remove_prefix(pos + 1);
+  if((pos = text.find_first_of(")\r\n")) == std::string_view::npos || text[pos] != ')')
     return false;
+  message.statusMessage = text.substr(0, pos);
+
+  return true;
+}
 
-  pos = ++n;
-  while(message[pos] != ')' && message[pos] != '\n' && message[pos] != '\r' && n < message.size())
-    pos++;
-  if(pos >= message.size() || message[pos] != ')')
+bool parseRequest(std::string_view message, Request& request)
+{
+  std::string_view options;
+  if(!parseCommand(rtrim(message, {'\r', '\n'}), request.command, request.objectId, options))
     return false;
 
-  reply.statusMessage = message.substr(n, pos - n);
+  for(auto option : Tokenizer(options, ',', true))
+    request.options.emplace_back(option);
 
   return true;
 }
 
-bool parseEvent(std::string_view message, Event& event)
+bool isReply(std::string_view message)
 {
-  static const std::string_view startDelimiter = "<EVENT ";
+  return startsWith(message, startDelimiterReply);
+}
 
-  if(!startsWith(message, startDelimiter))
+bool parseReply(std::string_view message, Reply& reply)
+{
+  if(!isReply(message))
     return false;
 
-  size_t n = startDelimiter.size();
-  size_t pos;
-
-  // read objectId
-  auto r = std::from_chars(&message[n], &message[message.size() - 1], event.objectId);
-  if(r.ec != std::errc())
+  // header: <REPLY command(objectId, options)>
+  const size_t eol = message.find('\n');
+  if(eol == std::string_view::npos)
     return false;
-
-  // advance to next line
-  n = r.ptr - message.data() + 1;
-  while((message[n] == '\n' || message[n] == '\r') && n < message.size())
-    n++;
-  if(n >= message.size())
+  const auto header = rtrim(message.substr(0, eol), '\r');
+  if(header.size() < startDelimiterReply.size() + 1 || header.back() != '>')
     return false;
-
-  // find end
-  size_t end;
-  if((end = message.find(endDelimiter, n)) == std::string_view::npos)
+  if(!parseCommand(header.substr(startDelimiterReply.size(), header.size() - startDelimiterReply.size() - 1), reply.command, reply.objectId, reply.options))
     return false;
 
-  // read lines
-  if(end > n)
-  {
-    while((pos = message.find('\n', n)) < end)
-    {
-      event.lines.emplace_back(rtrim({&message[n], pos - n}, '\r'));
-      n = pos + 1;
-    }
-  }
+  return parseBody(message.substr(eol + 1), reply);
+}
 
-  // read status code
-  std::underlying_type_t<Status> status;
-  r = std::from_chars(&message[end + endDelimiter.size()], &message[message.size() - 1], status);
-  if(r.ec != std::errc())
+bool parseEvent(std::string_view message, Event& event)
+{
+  if(!startsWith(message, startDelimiterEvent))
     return false;
-  event.status = static_cast<Status>(status);
-  n = r.ptr - message.data();
 
-  // read status message
-  while(message[n] != '(' && message[n] != '\n' && message[n] != '\r' && n < message.size())
-    n++;
-  if(n >= message.size() || message[n] != '(')
+  // header: <EVENT objectId>
+  auto r = fromChars(message.substr(startDelimiterEvent.size()), event.objectId);
+  if(r.ec != std::errc() || r.ptr == message.data() + message.size() || *r.ptr != '>')
     return false;
 
-  pos = ++n;
-  while(message[pos] != ')' && message[pos] != '\n' && message[pos] != '\r' && n < message.size())
-    pos++;
-  if(pos >= message.size() || message[pos] != ')')
+  const size_t eol = message.find('\n', r.ptr - message.data());
+  if(eol == std::string_view::npos)
     return false;
 
-  event.statusMessage = message.substr(n, pos - n);
-
-  return true;
+  return parseBody(message.substr(eol + 1), event);
 }
 
 bool parseId(std::string_view line, uint16_t& id)
@@ -235,38 +144,19 @@ bool parseLine(std::string_view text, Line& line)
   if(r.ec != std::errc())
     return false;
 
-  assert(line.values.empty());
-
-  size_t n = r.ptr - text.data();
-  while(n < text.size())
-  {
-    while(text[n] == ' ' && n < text.size())
-      n++;
-
-    if(n < text.size())
-    {
-      size_t pos = text.find('[', n);
-      if(pos != std::string_view::npos)
-      {
-        std::string_view key{text.data() + n, pos - n};
-        n = pos + 1;
-        if(n >= text.size())
-          return false;
-        const bool quoted = (text[n] == '"');
-        pos = quoted ? text.find("\"]", ++n) : text.find(']', n);
-        if(pos == std::string_view::npos)
-          return false;
-        line.values.emplace(key, std::string_view{text.data() + n, pos - n});
-        n = pos + (quoted ? 2 : 1);
-      }
-      else
-        n = pos;
-    }
-  }
-
+  line.values = text.substr(r.ptr - text.data());
   return true;
 }
 
+bool Line::find(std::string_view option, std::string_view& value) const
+{
+  std::string_view key;
+  for(auto item : Tokenizer(values, ' ', true))
+    if(parseOptionValue(item, key, value) && key == option)
+      return true;
+  return false;
+}
+
 bool parseOptionValue(std::string_view text, std::string_view& option, std::string_view& value)
 {
   auto n = text.find('[');
@@ -274,6 +164,8 @@ bool parseOptionValue(std::string_view text, std::string_view& option, std::stri
     return false;
   option = text.substr(0, n);
   value = text.substr(n + 1, text.size() - (n + 2));
+  if(value.size() >= 2 && value.front() == '"' && value.back() == '"')
+    value = value.substr(1, value.size() - 2);
   return true;
 }
 
@@ -25,8 +25,8 @@
 
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include <cstdint>
+#include "../../../utils/stringbuilder.hpp"
 
 namespace ECoS {
 
@@ -119,8 +119,8 @@ struct Reply
 {
   std::string_view command;
   uint16_t objectId;
-  std::vector<std::string_view> options;
-  std::vector<std::string_view> lines;
+  std::string_view options; //!< comma separated options, use Tokenizer with bracket grouping to split
+  std::string_view lines; //!< reply lines, use Tokenizer to split
   Status status;
   std::string_view statusMessage;
 };
@@ -128,7 +128,7 @@ struct Reply
 struct Event
 {
   uint16_t objectId;
-  std::vector<std::string_view> lines;
+  std::string_view lines; //!< event lines, use Tokenizer to split
   Status status;
   std::string_view statusMessage;
 };
@@ -136,88 +136,99 @@ struct Event
 struct Line
 {
   uint16_t objectId;
-  std::unordered_map<std::string_view, std::string_view> values;
+  std::string_view values; //!< space separated option[value] pairs
+
+  /**
+   * @brief Find the value of an option
+   * @param[in] option Option name
+   * @param[out] value Option value, without quotes
+   * @return \c true if found, \c false otherwise
+   */
+  bool find(std::string_view option, std::string_view& value) const;
 };
 
-inline std::string buildCommand(std::string_view command, uint16_t objectId, std::initializer_list<std::string_view> options)
+//! Command buffer, large enough for the longest command sent by the kernel
+using CommandBuffer = StringBuilder<256>;
+
+inline CommandBuffer buildCommand(std::string_view command, uint16_t objectId, std::initializer_list<std::string_view> options)
 {
-  std::string s(command);
-  s.append("(").append(std::to_string(objectId));
+  CommandBuffer s(command);
+  s.append('(').append(objectId);
   for(auto option : options)
     s.append(", ").append(option);
   s.append(")\n");
   return s;
 }
 
-inline std::string queryObjects(uint16_t objectId, std::initializer_list<std::string_view> options = {})
+inline CommandBuffer queryObjects(uint16_t objectId, std::initializer_list<std::string_view> options = {})
 {
   return buildCommand(Command::queryObjects, objectId, options);
 }
 
-inline std::string set(uint16_t objectId, std::initializer_list<std::string_view> options)
+inline CommandBuffer set(uint16_t objectId, std::initializer_list<std::string_view> options)
 {
   return buildCommand(Command::set, objectId, options);
 }
 
 template<class T>
-inline std::string set(uint16_t objectId, std::string_view option, T value)
+inline CommandBuffer set(uint16_t objectId, std::string_view option, T value)
 {
-  std::string s(Command::set);
-  s.append("(").append(std::to_string(objectId));
+  CommandBuffer s(Command::set);
+  s.append('(').append(objectId);
   s.append(", ").append(option);
-  s.append("[");
-  if constexpr(std::is_same_v<T, std::string>)
-    s.append(value);
+  s.append('[');
+  if constexpr(std::is_convertible_v<T, std::string_view>)
+    s.append(std::string_view{value});
   else
-    s.append(std::to_string(value));
-  s.append("]");
+    s.append(value);
+  s.append(']');
   s.append(")\n");
   return s;
 }
 
 template<class T1, class T2>
-inline std::string set(uint16_t objectId, std::string_view option, T1 value1, T2 value2)
+inline CommandBuffer set(uint16_t objectId, std::string_view option, T1 value1, T2 value2)
 {
-  std::string s(Command::set);
-  s.append("(").append(std::to_string(objectId));
+  CommandBuffer s(Command::set);
+  s.append('(').append(objectId);
   s.append(", ").append(option);
-  s.append("[").append(std::to_string(value1)).append(",").append(std::to_string(value2)).append("]");
+  s.append('[').append(value1).append(',').append(value2).append(']');
   s.append(")\n");
   return s;
 }
 
-inline std::string get(uint16_t objectId, std::initializer_list<std::string_view> options)
+inline CommandBuffer get(uint16_t objectId, std::initializer_list<std::string_view> options)
 {
   return buildCommand(Command::get, objectId, options);
 }
 
 template<class T>
-inline std::string get(uint16_t objectId, std::string_view option, T value)
+inline CommandBuffer get(uint16_t objectId, std::string_view option, T value)
 {
-  std::string s(Command::get);
-  s.append("(").append(std::to_string(objectId));
+  CommandBuffer s(Command::get);
+  s.append('(').append(objectId);
   s.append(", ").append(option);
-  s.append("[").append(std::to_string(value)).append("]");
+  s.append('[').append(value).append(']');
   s.append(")\n");
   return s;
 }
 
-inline std::string create(uint16_t objectId, std::initializer_list<std::string_view> options)
+inline CommandBuffer create(uint16_t objectId, std::initializer_list<std::string_view> options)
 {
   return buildCommand(Command::create, objectId, options);
 }
 
-inline std::string delete_(uint16_t objectId, std::initializer_list<std::string_view> options)
+inline CommandBuffer delete_(uint16_t objectId, std::initializer_list<std::string_view> options)
 {
   return buildCommand(Command::delete_, objectId, options);
 }
 
-inline std::string request(uint16_t objectId, std::initializer_list<std::string_view> options)
+inline CommandBuffer request(uint16_t objectId, std::initializer_list<std::string_view> options)
 {
   return buildCommand(Command::request, objectId, options);
 }
 
-inline std::string release(uint16_t objectId, std::initializer_list<std::string_view> options)
+inline CommandBuffer release(uint16_t objectId, std::initializer_list<std::string_view> options)
 {
   return buildCommand(Command::release, objectId, options);
 }
@@ -231,6 +242,9 @@ bool parseEvent(std::string_view message, Event& event);
 bool parseId(std::string_view line, uint16_t& id);
 bool parseLine(std::string_view text, Line& line);
 
+/**
+ * @brief Split option[value], surrounding quotes are removed from the value
+ */
 bool parseOptionValue(std::string_view text, std::string_view& option, std::string_view& value);
 
 constexpr bool isS88FeedbackId(uint16_t id)
@@ -50,23 +50,20 @@ bool ECoS::receiveReply(const Reply& reply)
 
   if(reply.command == Command::set)
   {
-    if(reply.options.size() == 1)
+    if(reply.options == Option::stop)
     {
-      if(reply.options[0] == Option::stop)
+      if(m_go != TriState::False)
       {
-        if(m_go != TriState::False)
-        {
-          m_go = TriState::False;
-          m_kernel.ecosGoChanged(m_go);
-        }
+        m_go = TriState::False;
+        m_kernel.ecosGoChanged(m_go);
       }
-      else if(reply.options[0] == Option::go)
+    }
+    else if(reply.options == Option::go)
+    {
+      if(m_go != TriState::True)
       {
-        if(m_go != TriState::True)
-        {
-          m_go = TriState::True;
-          m_kernel.ecosGoChanged(m_go);
-        }
+        m_go = TriState::True;
+        m_kernel.ecosGoChanged(m_go);
       }
     }
   }
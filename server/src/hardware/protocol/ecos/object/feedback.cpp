@@ -41,11 +41,10 @@ Feedback::Feedback(Kernel& kernel, uint16_t id)
 Feedback::Feedback(Kernel& kernel, const Line& data)
   : Feedback(kernel, data.objectId)
 {
-  const auto values = data.values;
-  if(auto ports = values.find(Option::ports); ports != values.end())
+  if(std::string_view ports; data.find(Option::ports, ports))
   {
     size_t n;
-    if(fromChars(ports->second, n).ec == std::errc())
+    if(fromChars(ports, n).ec == std::errc())
       m_state.resize(n, TriState::Undefined);
   }
 }
@@ -24,6 +24,7 @@
 #include <cassert>
 #include "feedback.hpp"
 #include "../messages.hpp"
+#include "../../../../utils/tokenizer.hpp"
 
 namespace ECoS {
 
@@ -40,7 +41,7 @@ bool FeedbackManager::receiveReply(const Reply& reply)
 
   if(reply.command == Command::queryObjects)
   {
-    for(std::string_view line : reply.lines)
+    for(auto line : Tokenizer(reply.lines, '\n'))
     {
       Line data;
       if(parseLine(line, data) && !objectExists(data.objectId))
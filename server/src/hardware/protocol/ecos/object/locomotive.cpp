@@ -24,6 +24,7 @@
 #include <cassert>
 #include "../messages.hpp"
 #include "../../../../utils/fromchars.hpp"
+#include "../../../../utils/tokenizer.hpp"
 
 namespace ECoS {
 
@@ -39,11 +40,11 @@ Locomotive::Locomotive(Kernel& kernel, uint16_t id)
 Locomotive::Locomotive(Kernel& kernel, const Line& data)
   : Locomotive(kernel, data.objectId)
 {
-  const auto values = data.values;
-  if(auto addr = values.find(Option::addr); addr != values.end())
-    fromChars(addr->second, m_address);
-  if(auto protocol = values.find(Option::protocol); protocol != values.end())
-    fromString(protocol->second, m_protocol);
+  std::string_view value;
+  if(data.find(Option::addr, value))
+    fromChars(value, m_address);
+  if(data.find(Option::protocol, value))
+    fromString(value, m_protocol);
 
   if(m_protocol != LocomotiveProtocol::Unknown)
     for(uint8_t i = 0; i < getFunctionCount(); i++)
@@ -54,7 +55,7 @@ bool Locomotive::receiveReply(const Reply& reply)
 {
   assert(reply.objectId == m_id);
 
-  if(reply.command == Command::request && !reply.options.empty() && reply.options[0] == Option::control && reply.status == Status::Ok)
+  if(std::string_view option; reply.command == Command::request && Tokenizer(reply.options, ',', true).next(option) && option == Option::control && reply.status == Status::Ok)
   {
     m_control = true;
   }
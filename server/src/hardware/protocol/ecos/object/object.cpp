@@ -24,6 +24,7 @@
 #include <cassert>
 #include "../messages.hpp"
 #include "../kernel.hpp"
+#include "../../../../utils/tokenizer.hpp"
 
 namespace ECoS {
 
@@ -45,7 +46,7 @@ bool Object::receiveReply(const Reply& reply)
   {
     std::string_view key;
     std::string_view value;
-    for(auto text : reply.options)
+    for(auto text : Tokenizer(reply.options, ',', true))
       if(parseOptionValue(text, key, value))
         update(key, value);
   }
@@ -93,14 +94,17 @@ void Object::removeObject(uint16_t objectId)
   m_kernel.removeObject(objectId);
 }
 
-void Object::update(const std::vector<std::string_view>& lines)
+void Object::update(std::string_view lines)
 {
-  for(auto line : lines)
+  std::string_view key;
+  std::string_view value;
+  for(auto line : Tokenizer(lines, '\n'))
   {
     Line data;
     if(parseLine(line, data))
-      for(auto it : data.values)
-        update(it.first, it.second);
+      for(auto item : Tokenizer(data.values, ' ', true))
+        if(parseOptionValue(item, key, value))
+          update(key, value);
   }
 }
 
@@ -37,7 +37,7 @@ struct Event;
 class Object
 {
   private:
-    void update(const std::vector<std::string_view>& lines);
+    void update(std::string_view lines);
 
   protected:
     Kernel& m_kernel;
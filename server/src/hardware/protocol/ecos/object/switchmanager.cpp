@@ -28,6 +28,7 @@
 #include "../../../../utils/fromchars.hpp"
 #include "../../../../utils/startswith.hpp"
 #include "../../../../utils/endswith.hpp"
+#include "../../../../utils/tokenizer.hpp"
 
 namespace ECoS {
 
@@ -41,7 +42,11 @@ SwitchManager::SwitchManager(Kernel& kernel)
 void SwitchManager::setSwitch(SwitchProtocol protocol, uint16_t address, bool port)
 {
   if(protocol == SwitchProtocol::DCC || protocol == SwitchProtocol::Motorola) /*[[likely]]*/
-    send(set(m_id, Option::switch_, std::string((protocol == SwitchProtocol::Motorola) ? "MOT" : "DCC").append(std::to_string(address)).append(port ? "g" : "r")));
+  {
+    StringBuilder<16> value((protocol == SwitchProtocol::Motorola) ? "MOT" : "DCC");
+    value.append(address).append(port ? 'g' : 'r');
+    send(set(m_id, Option::switch_, value.view()));
+  }
 }
 
 bool SwitchManager::receiveReply(const Reply& reply)
@@ -50,13 +55,13 @@ bool SwitchManager::receiveReply(const Reply& reply)
 
   if(reply.command == Command::queryObjects)
   {
-    for(std::string_view line : reply.lines)
+    for(auto line : Tokenizer(reply.lines, '\n'))
     {
       Line data;
       if(parseLine(line, data) && !objectExists(data.objectId))
       {
         SwitchType type = SwitchType::Unknown;
-        if(auto it = data.values.find(Option::type); it != data.values.end() && fromString(it->second, type))
+        if(std::string_view value; data.find(Option::type, value) && fromString(value, type))
         {
           switch(type)
           {
@@ -84,28 +89,27 @@ bool SwitchManager::receiveEvent(const Event& event)
 {
   assert(event.objectId == m_id);
 
-  if(!event.lines.empty())
+  Tokenizer lines(event.lines, '\n');
+  if(std::string_view text; lines.next(text))
   {
     Line firstLine;
-    if(parseLine(event.lines.front(), firstLine))
+    if(parseLine(text, firstLine))
     {
       if(firstLine.objectId == m_id) // TODO: msg[LIST_CHANGED]
       {
-        if(auto msg = firstLine.values.find("msg"); msg != firstLine.values.end() && msg->second == "LIST_CHANGED")
+        if(std::string_view msg; firstLine.find("msg", msg) && msg == "LIST_CHANGED")
         {
-          auto it = event.lines.begin();
-          it++; // skip first line
-          for(; it != event.lines.end(); it++)
+          for(auto lineText : lines) // remaining lines
           {
             Line line;
-            if(parseLine(*it, line) && line.objectId != m_id)
+            if(parseLine(lineText, line) && line.objectId != m_id)
             {
-              if(endsWith(*it, "appended") && !objectExists(line.objectId))
+              if(endsWith(lineText, "appended") && !objectExists(line.objectId))
               {
                 // FIXME: check type for accessory/turntable
                 addObject(std::make_unique<Switch>(m_kernel, line.objectId));
               }
-              else if(endsWith(*it, "removed"))
+              else if(endsWith(lineText, "removed"))
               {
                 removeObject(line.objectId);
               }
@@ -222,7 +222,7 @@ void Kernel::start()
   m_addressToSlot.clear();
   m_slots.clear();
   m_pendingSlotMessages.clear();
-  m_inputValues.fill(TriState::Undefined);
+  m_inputValues.reset();
   m_outputValues.fill(OutputPairValue::Undefined);
 
   if(m_config.listenOnly)
@@ -469,8 +469,7 @@ void Kernel::receive(const Message& message)
         const auto& inputRep = static_cast<const InputRep&>(message);
         if(inputRep.isControlSet())
         {
-          const auto value = toTriState(inputRep.value());
-          if(m_inputValues[inputRep.fullAddress()] != value)
+          if(m_inputValues.set(inputRep.fullAddress(), inputRep.value()))
           {
             if(m_config.debugLogInput)
               EventLoop::call(
@@ -479,10 +478,8 @@ void Kernel::receive(const Message& message)
                   Log::log(logId, LogMessage::D2007_INPUT_X_IS_X, address, value ? std::string_view{"1"} : std::string_view{"0"});
                 });
 
-            m_inputValues[inputRep.fullAddress()] = value;
-
             EventLoop::call(
-              [this, address=1 + inputRep.fullAddress(), value]()
+              [this, address=1 + inputRep.fullAddress(), value=toTriState(inputRep.value())]()
               {
                 m_inputController->updateInputValue(InputChannel::Input, address, value);
               });
@@ -35,6 +35,7 @@
 #include <traintastic/enum/outputchannel.hpp>
 #include "config.hpp"
 #include "iohandler/iohandler.hpp"
+#include "../../input/inputvalues.hpp"
 #include "../../output/outputvalue.hpp"
 
 class Clock;
@@ -175,7 +176,7 @@ class Kernel : public ::KernelBase
     std::unordered_map<uint16_t, std::vector<std::byte>> m_pendingSlotMessages;
 
     InputController* m_inputController;
-    std::array<TriState, 4096> m_inputValues;
+    InputValues m_inputValues{4096};
 
     OutputController* m_outputController;
     std::array<OutputPairValue, accessoryOutputAddressMax - accessoryOutputAddressMin + 1> m_outputValues;
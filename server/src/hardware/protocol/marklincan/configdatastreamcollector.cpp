@@ -39,6 +39,8 @@ ConfigDataStreamCollector::Status ConfigDataStreamCollector::process(const Confi
     if(m_offset + 8 >= m_data.size()) // last message
     {
       std::memcpy(m_data.data() + m_offset, message.data, m_data.size() - m_offset);
+      if(m_onData)
+        m_onData(m_data.data() + m_offset, m_data.size() - m_offset);
       m_offset = m_data.size();
 
       if(crc16(m_data) != m_crc)
@@ -48,6 +50,8 @@ ConfigDataStreamCollector::Status ConfigDataStreamCollector::process(const Confi
     }
 
     std::memcpy(m_data.data() + m_offset, message.data, 8);
+    if(m_onData)
+      m_onData(m_data.data() + m_offset, 8);
     m_offset += 8;
     return Collecting;
   }
@@ -55,7 +59,7 @@ ConfigDataStreamCollector::Status ConfigDataStreamCollector::process(const Confi
   {
     m_data.resize(message.length());
     m_crc = message.crc();
-    return Collecting;
+    return Started;
   }
 
   return ErrorInvalidMessage;
@@ -24,6 +24,7 @@
 #define TRAINTASTIC_SERVER_HARDWARE_PROTOCOL_MARKLINCAN_CONFIGDATASTREAMCOLLECTOR_HPP
 
 #include <cstddef>
+#include <functional>
 #include <vector>
 #include "message/configdata.hpp"
 
@@ -35,10 +36,12 @@ class ConfigDataStreamCollector
     uint16_t m_crc = 0;
     std::vector<std::byte> m_data;
     size_t m_offset = 0;
+    std::function<void(const std::byte*, size_t)> m_onData;
 
   public:
     enum Status
     {
+      Started, //!< stream header received, length and CRC are known
       Collecting,
       Complete,
       ErrorInvalidMessage,
@@ -50,6 +53,18 @@ class ConfigDataStreamCollector
 
     ConfigDataStreamCollector(std::string name_);
 
+    //! Stream length, only valid after the stream is started
+    uint32_t length() const
+    {
+      return static_cast<uint32_t>(m_data.size());
+    }
+
+    //! Stream CRC, only valid after the stream is started
+    uint16_t crc() const
+    {
+      return m_crc;
+    }
+
     const std::byte* data() const
     {
       return m_data.data();
@@ -65,6 +80,17 @@ class ConfigDataStreamCollector
       return m_data;
     }
 
+    /**
+     * @brief Set data callback
+     *
+     * The callback is called for every received chunk of data, before the
+     * CRC is validated, so the data can be processed while it is received.
+     */
+    void setOnData(std::function<void(const std::byte*, size_t)> callback)
+    {
+      m_onData = std::move(callback);
+    }
+
     Status process(const ConfigDataStream& message);
 
     std::vector<std::byte>&& releaseData()
@@ -23,10 +23,14 @@
 #ifndef TRAINTASTIC_SERVER_HARDWARE_PROTOCOL_MARKLINCAN_IOHANDLER_IOHANDLER_HPP
 #define TRAINTASTIC_SERVER_HARDWARE_PROTOCOL_MARKLINCAN_IOHANDLER_IOHANDLER_HPP
 
+#include <cstdint>
+#include <vector>
+
 namespace MarklinCAN {
 
 class Kernel;
 struct Message;
+enum class Command : uint8_t;
 
 class IOHandler
 {
@@ -48,6 +52,13 @@ class IOHandler
     virtual void stop() = 0;
 
     virtual bool send(const Message& message) = 0;
+
+    /**
+     * @brief Set the commands the kernel wants to receive
+     * IO handlers that can drop messages before they reach the kernel can use this, others ignore it.
+     * @param[in] commands Commands to receive, empty to receive all messages
+     */
+    virtual void setReceiveFilter(const std::vector<Command>& /*commands*/) {}
 };
 
 template<class T>
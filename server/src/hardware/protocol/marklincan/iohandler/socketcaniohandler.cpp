@@ -62,6 +62,15 @@ SocketCANIOHandler::SocketCANIOHandler(Kernel& kernel, const std::string& interf
   }
 
   m_stream.assign(fd);
+
+  for(size_t i = 0; i < readBatchSize; i++)
+  {
+    m_readIOVecs[i].iov_base = &m_readBuffer[i];
+    m_readIOVecs[i].iov_len = frameSize;
+    std::memset(&m_readMessages[i], 0, sizeof(m_readMessages[i]));
+    m_readMessages[i].msg_hdr.msg_iov = &m_readIOVecs[i];
+    m_readMessages[i].msg_hdr.msg_iovlen = 1;
+  }
 }
 
 void SocketCANIOHandler::start()
@@ -96,32 +105,58 @@ bool SocketCANIOHandler::send(const Message& message)
   return true;
 }
 
+void SocketCANIOHandler::setReceiveFilter(const std::vector<Command>& commands)
+{
+  std::vector<struct can_filter> filters;
+  if(commands.empty())
+  {
+    filters.emplace_back(can_filter{0, 0}); // receive all
+  }
+  else
+  {
+    // match extended frames by the command bits of the identifier:
+    static constexpr canid_t commandMask = 0xFF << 17;
+    for(auto command : commands)
+      filters.emplace_back(can_filter{CAN_EFF_FLAG | (static_cast<canid_t>(command) << 17), CAN_EFF_FLAG | commandMask});
+  }
+
+  // failing is harmless, the kernel ignores messages it doesn't handle:
+  setsockopt(m_stream.native_handle(), SOL_CAN_RAW, CAN_RAW_FILTER, filters.data(), filters.size() * sizeof(struct can_filter));
+}
+
 void SocketCANIOHandler::read()
 {
-  m_stream.async_read_some(boost::asio::buffer(m_readBuffer.data() + m_readBufferOffset * frameSize, (m_readBuffer.size() - m_readBufferOffset) * frameSize),
-    [this](const boost::system::error_code& ec, std::size_t bytesTransferred)
+  m_stream.async_wait(boost::asio::posix::stream_descriptor::wait_read,
+    [this](const boost::system::error_code& ec)
     {
       if(!ec)
       {
-        auto framesTransferred = bytesTransferred / frameSize;
-        const auto* frame = reinterpret_cast<const struct can_frame*>(m_readBuffer.data());
-        framesTransferred += m_readBufferOffset;
+        // receive all pending frames using a single system call:
+        const int count = recvmmsg(m_stream.native_handle(), m_readMessages.data(), m_readMessages.size(), MSG_DONTWAIT, nullptr);
+        if(count < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+          EventLoop::call(
+            [this, readError=boost::system::error_code(errno, boost::system::system_category())]()
+            {
+              Log::log(m_kernel.logId, LogMessage::E2008_SOCKET_READ_FAILED_X, readError);
+              m_kernel.error();
+            });
+          return;
+        }
 
-        while(framesTransferred > 0)
+        for(int i = 0; i < count; i++)
         {
+          if(m_readMessages[i].msg_len != frameSize) /*[[unlikely]]*/
+            continue;
+
+          const auto& frame = m_readBuffer[i];
           Message message;
-          message.id = frame->can_id & CAN_EFF_MASK;
-          message.dlc = frame->can_dlc;
-          std::memcpy(message.data, frame->data, message.dlc);
+          message.id = frame.can_id & CAN_EFF_MASK;
+          message.dlc = frame.can_dlc;
+          std::memcpy(message.data, frame.data, message.dlc);
           m_kernel.receive(message);
-          frame++;
-          framesTransferred--;
         }
 
-        if(framesTransferred != 0) /*[[unlikely]]*/
-          memmove(m_readBuffer.data(), frame, framesTransferred * frameSize);
-        m_readBufferOffset = framesTransferred;
-
         read();
       }
       else if(ec != boost::asio::error::operation_aborted)
@@ -24,7 +24,9 @@
 #define TRAINTASTIC_SERVER_HARDWARE_PROTOCOL_MARKLINCAN_IOHANDLER_SOCKETCANIOHANDLER_HPP
 
 #include "iohandler.hpp"
+#include <array>
 #include <string>
+#include <sys/socket.h>
 #include <linux/can.h>
 #include <boost/asio/posix/stream_descriptor.hpp>
 
@@ -34,10 +36,12 @@ class SocketCANIOHandler : public IOHandler
 {
   private:
     static constexpr size_t frameSize = sizeof(struct can_frame);
+    static constexpr size_t readBatchSize = 32; //!< max. number of frames received per system call
 
     boost::asio::posix::stream_descriptor m_stream;
-    std::array<struct can_frame, 32> m_readBuffer;
-    size_t m_readBufferOffset = 0;
+    std::array<struct can_frame, readBatchSize> m_readBuffer;
+    std::array<struct iovec, readBatchSize> m_readIOVecs;
+    std::array<struct mmsghdr, readBatchSize> m_readMessages;
     std::array<struct can_frame, 32> m_writeBuffer;
     size_t m_writeBufferOffset = 0;
 
@@ -51,6 +55,8 @@ class SocketCANIOHandler : public IOHandler
     void stop() final;
 
     bool send(const Message& message) final;
+
+    void setReceiveFilter(const std::vector<Command>& commands) final;
 };
 
 }
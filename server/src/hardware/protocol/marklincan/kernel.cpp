@@ -21,6 +21,7 @@
  */
 
 #include "kernel.hpp"
+#include <algorithm>
 #include <nlohmann/json.hpp>
 #include <version.hpp>
 #include "messages.hpp"
@@ -47,6 +48,16 @@
 
 namespace MarklinCAN {
 
+//! Locomotive list being decompressed and parsed while it is received
+struct Kernel::LocomotiveListDownload
+{
+  ZLib::Uncompress::Stream inflate;
+  LocomotiveList::Parser parser;
+  std::string text; //!< uncompressed text, kept when debugConfigStream is enabled
+  size_t skip = sizeof(uint32_t); //!< uncompressed size prefix, not compressed data
+  bool error = false;
+};
+
 static std::tuple<bool, DecoderProtocol, uint16_t> uidToProtocolAddress(uint32_t uid)
 {
   if(inRange(uid, UID::Range::locomotiveMotorola))
@@ -86,7 +97,12 @@ void Kernel::setConfig(const Config& config)
       if(m_config.defaultSwitchTime != newConfig.defaultSwitchTime)
         send(AccessorySwitchTime(newConfig.defaultSwitchTime / 10));
 
+      const bool debugLogRXTXChanged = m_config.debugLogRXTX != newConfig.debugLogRXTX;
+
       m_config = newConfig;
+
+      if(debugLogRXTXChanged)
+        m_ioHandler->setReceiveFilter(receiveFilter());
     });
 }
 
@@ -97,6 +113,13 @@ void Kernel::setOnLocomotiveListChanged(std::function<void(const std::shared_ptr
   m_onLocomotiveListChanged = std::move(callback);
 }
 
+void Kernel::setLocomotiveList(std::shared_ptr<LocomotiveList> list)
+{
+  assert(isEventLoopThread());
+  assert(!m_started);
+  m_locomotiveList = std::move(list);
+}
+
 void Kernel::setOnNodeChanged(std::function<void(const Node& node)> callback)
 {
   assert(isEventLoopThread());
@@ -132,7 +155,7 @@ void Kernel::start()
   assert(!m_started);
 
   // reset all state values
-  m_inputValues.fill(TriState::Undefined);
+  m_inputValues.reset();
   m_outputValuesMotorola.fill(OutputPairValue::Undefined);
   m_outputValuesDCC.fill(OutputPairValue::Undefined);
 
@@ -149,6 +172,7 @@ void Kernel::start()
     {
       try
       {
+        m_ioHandler->setReceiveFilter(receiveFilter());
         m_ioHandler->start();
       }
       catch(const LogMessageException& e)
@@ -207,6 +231,35 @@ void Kernel::started()
   nextState();
 }
 
+std::vector<Command> Kernel::receiveFilter() const
+{
+  if(m_config.debugLogRXTX)
+    return {}; // receive all, so everything is logged
+
+  std::vector<Command> commands{
+    Command::System,
+    Command::Ping,
+    Command::StatusDataConfig,
+    Command::ConfigData,
+    Command::ConfigDataStream,
+  };
+
+  if(m_decoderController)
+  {
+    commands.emplace_back(Command::LocomotiveSpeed);
+    commands.emplace_back(Command::LocomotiveDirection);
+    commands.emplace_back(Command::LocomotiveFunction);
+  }
+
+  if(m_inputController)
+    commands.emplace_back(Command::FeedbackEvent);
+
+  if(m_outputController)
+    commands.emplace_back(Command::AccessoryControl);
+
+  return commands;
+}
+
 void Kernel::receive(const Message& message)
 {
   assert(isKernelThread());
@@ -406,13 +459,11 @@ void Kernel::receive(const Message& message)
 
           if(feedbackState.deviceId() == 0) //! \todo what about other values?
           {
-            const auto value = feedbackState.stateNew() == 0 ? TriState::False : TriState::True;
-            if(inRange(feedbackState.contactId(), s88AddressMin, s88AddressMax) && m_inputValues[feedbackState.contactId() - s88AddressMin] != value)
+            const bool value = feedbackState.stateNew() != 0;
+            if(inRange(feedbackState.contactId(), s88AddressMin, s88AddressMax) && m_inputValues.set(feedbackState.contactId() - s88AddressMin, value))
             {
-              m_inputValues[feedbackState.contactId() - s88AddressMin] = value;
-
               EventLoop::call(
-                [this, address=feedbackState.contactId(), value]()
+                [this, address=feedbackState.contactId(), value=toTriState(value)]()
                 {
                   m_inputController->updateInputValue(InputChannel::Input, address, value);
                 });
@@ -521,6 +572,16 @@ void Kernel::receive(const Message& message)
       if(message.isResponse() && message.dlc == 8)
       {
         m_configDataStreamCollector = std::make_unique<ConfigDataStreamCollector>(std::string{static_cast<const ConfigData&>(message).name()});
+        m_locomotiveListDownload.reset();
+        if(m_configDataStreamCollector->name == ConfigDataName::loks)
+        {
+          m_locomotiveListDownload = std::make_shared<LocomotiveListDownload>();
+          m_configDataStreamCollector->setOnData(
+            [this](const std::byte* data, size_t size)
+            {
+              receiveLocomotiveListData(data, size);
+            });
+        }
       }
       break;
 
@@ -528,7 +589,19 @@ void Kernel::receive(const Message& message)
       if(m_configDataStreamCollector) /*[[likely]]*/
       {
         const auto status = m_configDataStreamCollector->process(static_cast<const ConfigDataStream&>(message));
-        if(status != ConfigDataStreamCollector::Collecting)
+        if(status == ConfigDataStreamCollector::Started)
+        {
+          if(m_locomotiveListDownload && m_locomotiveList &&
+              m_locomotiveList->source().size == m_configDataStreamCollector->length() &&
+              m_locomotiveList->source().crc == m_configDataStreamCollector->crc())
+          {
+            // unchanged, skip download:
+            m_configDataStreamCollector.reset();
+            m_locomotiveListDownload.reset();
+            locomotiveListChanged();
+          }
+        }
+        else if(status != ConfigDataStreamCollector::Collecting)
         {
           if(status == ConfigDataStreamCollector::Complete)
           {
@@ -537,6 +610,7 @@ void Kernel::receive(const Message& message)
           else // error
           {
             m_configDataStreamCollector.reset();
+            m_locomotiveListDownload.reset();
           }
         }
       }
@@ -774,35 +848,67 @@ void Kernel::receiveConfigData(std::unique_ptr<ConfigDataStreamCollector> config
     writeFile(std::filesystem::path(basename).concat(".bin"), configData->bytes());
   }
 
-  if(configData->name == ConfigDataName::loks)
+  if(configData->name == ConfigDataName::loks && m_locomotiveListDownload)
   {
-    const size_t uncompressedSize = be_to_host(*reinterpret_cast<const uint32_t*>(configData->data()));
-    std::string locList;
-    if(ZLib::Uncompress::toString(configData->data() + sizeof(uint32_t), configData->dataSize() - sizeof(uint32_t), uncompressedSize, locList))
+    auto download = std::move(m_locomotiveListDownload);
+    if(!download->error && download->inflate.end())
     {
       if(m_config.debugConfigStream)
       {
-        writeFile(std::filesystem::path(basename).concat(".txt"), locList);
+        writeFile(std::filesystem::path(basename).concat(".txt"), download->text);
       }
 
-      EventLoop::call(
-        [this, list=std::make_shared<LocomotiveList>(locList)]()
-        {
-          // update MFX UID to SID list:
-          m_mfxUIDtoSID.clear();
-          for(const auto& item : *list)
-            m_mfxUIDtoSID.emplace(item.mfxUID, item.sid);
-
-          if(m_onLocomotiveListChanged) /*[[likely]]*/
-            m_onLocomotiveListChanged(list);
-        });
+      m_locomotiveList = std::make_shared<LocomotiveList>(download->parser.finish(), LocomotiveList::Source{configData->length(), configData->crc()});
+      locomotiveListChanged();
     }
-
-    if(m_state == State::DownloadLokList)
+    else if(m_state == State::DownloadLokList)
       nextState();
   }
 }
 
+void Kernel::receiveLocomotiveListData(const std::byte* data, size_t size)
+{
+  auto& download = *m_locomotiveListDownload;
+  if(download.error)
+    return;
+
+  if(download.skip != 0)
+  {
+    const size_t n = std::min(download.skip, size);
+    download.skip -= n;
+    data += n;
+    size -= n;
+  }
+
+  const size_t offset = download.text.size();
+  if(!download.inflate.write(data, size, download.text))
+  {
+    download.error = true;
+    return;
+  }
+  download.parser.parse(std::string_view(download.text).substr(offset));
+  if(!m_config.debugConfigStream)
+    download.text.clear();
+}
+
+void Kernel::locomotiveListChanged()
+{
+  EventLoop::call(
+    [this, list=m_locomotiveList]()
+    {
+      // update MFX UID to SID list:
+      m_mfxUIDtoSID.clear();
+      for(const auto& item : *list)
+        m_mfxUIDtoSID.emplace(item.mfxUID, item.sid);
+
+      if(m_onLocomotiveListChanged) /*[[likely]]*/
+        m_onLocomotiveListChanged(list);
+    });
+
+  if(m_state == State::DownloadLokList)
+    nextState();
+}
+
 void Kernel::restartStatusDataConfigTimer()
 {
   assert(!m_statusDataConfigRequestQueue.empty());
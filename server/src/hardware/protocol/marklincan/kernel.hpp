@@ -39,6 +39,7 @@
 #include "configdatastreamcollector.hpp"
 #include "../dcc/dcc.hpp"
 #include "../motorola/motorola.hpp"
+#include "../../input/inputvalues.hpp"
 #include "../../output/outputvalue.hpp"
 
 class Decoder;
@@ -102,7 +103,7 @@ class Kernel : public ::KernelBase
     std::map<uint32_t, uint16_t> m_mfxUIDtoSID;
 
     InputController* m_inputController = nullptr;
-    std::array<TriState, s88AddressMax - s88AddressMin + 1> m_inputValues;
+    InputValues m_inputValues{s88AddressMax - s88AddressMin + 1};
 
     OutputController* m_outputController = nullptr;
     std::array<OutputPairValue, Motorola::Accessory::addressMax - Motorola::Accessory::addressMin + 1> m_outputValuesMotorola;
@@ -110,6 +111,9 @@ class Kernel : public ::KernelBase
 
     std::vector<std::byte> m_statusConfigData;
     std::unique_ptr<ConfigDataStreamCollector> m_configDataStreamCollector;
+    struct LocomotiveListDownload;
+    std::shared_ptr<LocomotiveListDownload> m_locomotiveListDownload;
+    std::shared_ptr<LocomotiveList> m_locomotiveList; //!< last received locomotive list
 
     const std::filesystem::path m_debugDir;
 
@@ -119,11 +123,15 @@ class Kernel : public ::KernelBase
 
     void setIOHandler(std::unique_ptr<IOHandler> handler);
 
+    std::vector<Command> receiveFilter() const;
+
     void send(const Message& message);
     void postSend(const Message& message);
 
     void receiveStatusDataConfig(uint32_t nodeUID, uint8_t index, const std::vector<std::byte>& statusConfigData);
     void receiveConfigData(std::unique_ptr<ConfigDataStreamCollector> configData);
+    void receiveLocomotiveListData(const std::byte* data, size_t size);
+    void locomotiveListChanged();
 
     void restartStatusDataConfigTimer();
 
@@ -188,6 +196,17 @@ class Kernel : public ::KernelBase
      */
     void setOnLocomotiveListChanged(std::function<void(const std::shared_ptr<LocomotiveList>&)> callback);
 
+    /**
+     * \brief Set previously received locomotive list
+     *
+     * If the command station reports a locomotive list with the same length
+     * and CRC, this list is used and the download is skipped.
+     *
+     * \param[in] list The locomotive list, may be \c nullptr
+     * \note This function may not be called when the kernel is running.
+     */
+    void setLocomotiveList(std::shared_ptr<LocomotiveList> list);
+
     /**
      *
      */
@@ -21,6 +21,7 @@
  */
 
 #include "locomotivelist.hpp"
+#include <cassert>
 #include <traintastic/enum/decoderprotocol.hpp>
 #include "../dcc/dcc.hpp"
 #include "../../../utils/fromchars.hpp"
@@ -28,18 +29,6 @@
 
 namespace MarklinCAN {
 
-static bool readLine(std::string_view& src, std::string_view& line)
-{
-  const size_t n = src.find('\n');
-  if(n == std::string_view::npos)
-    return false;
-
-  line = src.substr(0, n);
-  src = src.substr(n + 1);
-
-  return true;
-}
-
 //! \brief Function types used by CS2 (and CS3?)
 //! \note Values based on tests with CS2
 enum class FunctionType : uint8_t
@@ -132,117 +121,170 @@ constexpr DecoderFunctionType toDecoderFunctionType(uint8_t typ)
 
 
 LocomotiveList::LocomotiveList(std::string_view list)
-  : m_locomotives{build(list)}
+  : m_locomotives{[list]() { Parser parser; parser.parse(list); return parser.finish(); }()}
+  , m_source{}
 {
 }
 
-std::vector<LocomotiveList::Locomotive> LocomotiveList::build(std::string_view list)
+LocomotiveList::LocomotiveList(std::vector<Locomotive> locomotives, Source source)
+  : m_locomotives{std::move(locomotives)}
+  , m_source{source}
 {
-  std::string_view line;
+}
 
-  if(list.empty() || !readLine(list, line) || line != "[lokomotive]")
-    return {};
+void LocomotiveList::Parser::parse(std::string_view text)
+{
+  if(!m_line.empty())
+  {
+    const size_t n = text.find('\n');
+    m_line.append(text.substr(0, n));
+    if(n == std::string_view::npos)
+      return;
+    parseLine(m_line);
+    m_line.clear();
+    text.remove_prefix(n + 1);
+  }
 
-  std::vector<Locomotive> locomotives;
-  while(readLine(list, line))
+  size_t n;
+  while((n = text.find('\n')) != std::string_view::npos)
   {
-    if(line == "lokomotive")
-    {
-      Locomotive locomotive;
+    parseLine(text.substr(0, n));
+    text.remove_prefix(n + 1);
+  }
+  m_line.assign(text);
+}
 
-      while(readLine(list, line))
+std::vector<LocomotiveList::Locomotive> LocomotiveList::Parser::finish()
+{
+  if(!m_line.empty())
+  {
+    parseLine(m_line);
+    m_line.clear();
+  }
+  if(m_state == State::Function)
+    endFunction();
+  if(m_state == State::Locomotive)
+    endLocomotive();
+  m_state = State::Invalid;
+  return std::move(m_locomotives);
+}
+
+void LocomotiveList::Parser::parseLine(std::string_view line)
+{
+  switch(m_state)
+  {
+    case State::Header:
+      m_state = (line == "[lokomotive]") ? State::Section : State::Invalid;
+      return;
+
+    case State::Invalid:
+      return;
+
+    case State::Function:
+      if(startsWith(line, " .."))
       {
-        if(startsWith(line, " ."))
+        line = line.substr(3);
+        if(startsWith(line, "nr="))
         {
-          line = line.substr(2);
-          if(startsWith(line, "name="))
-          {
-            locomotive.name = line.substr(5);
-          }
-          else if(startsWith(line, "adresse=0x"))
-          {
-            fromChars(line.substr(10), locomotive.address, 16);
-          }
-          else if(startsWith(line, "typ="))
+          fromChars(line.substr(3), m_function.nr);
+        }
+        else if(startsWith(line, "typ="))
+        {
+          m_functionHasTyp = true;
+          uint8_t typ;
+          if(fromChars(line.substr(4), typ).ec == std::errc())
           {
-            std::string_view typ = line.substr(4);
-            if(typ == "mfx")
-            {
-              locomotive.protocol = DecoderProtocol::MFX;
-            }
-            else if(typ == "dcc")
-            {
-              locomotive.protocol = DecoderProtocol::DCCShort; // or DCCLong (handled later)
-            }
-            else if(typ == "mm2_dil8" || typ == "mm2_prg" || typ == "mm_prg")
-            {
-              locomotive.protocol = DecoderProtocol::Motorola;
-            }
+            m_function.type = toDecoderFunctionType(typ);
+            m_function.function = toDecoderFunctionFunction(typ);
           }
-          else if(startsWith(line, "sid=0x"))
+        }
+        return;
+      }
+      endFunction();
+      [[fallthrough]];
+
+    case State::Locomotive:
+      if(startsWith(line, " ."))
+      {
+        auto& locomotive = m_locomotives.back();
+        line = line.substr(2);
+        if(startsWith(line, "name="))
+        {
+          locomotive.name = line.substr(5);
+        }
+        else if(startsWith(line, "adresse=0x"))
+        {
+          fromChars(line.substr(10), locomotive.address, 16);
+        }
+        else if(startsWith(line, "typ="))
+        {
+          std::string_view typ = line.substr(4);
+          if(typ == "mfx")
           {
-            fromChars(line.substr(6), locomotive.sid, 16);
+            locomotive.protocol = DecoderProtocol::MFX;
           }
-          else if(startsWith(line, "mfxuid=0x"))
+          else if(typ == "dcc")
           {
-            fromChars(line.substr(9), locomotive.mfxUID, 16);
+            locomotive.protocol = DecoderProtocol::DCCShort; // or DCCLong (handled later)
           }
-          else if(line == "funktionen" || line == "funktionen_2")
+          else if(typ == "mm2_dil8" || typ == "mm2_prg" || typ == "mm_prg")
           {
-            bool hasTyp = false; // if typ is missing the function is unused
-            Function function;
-            function.nr = 0xFF;
-
-            while(readLine(list, line))
-            {
-              if(startsWith(line, " .."))
-              {
-                line = line.substr(3);
-                if(startsWith(line, "nr="))
-                {
-                  fromChars(line.substr(3), function.nr);
-                }
-                else if(startsWith(line, "typ="))
-                {
-                  hasTyp = true;
-                  uint8_t typ;
-                  if(fromChars(line.substr(4), typ).ec == std::errc())
-                  {
-                    function.type = toDecoderFunctionType(typ);
-                    function.function = toDecoderFunctionFunction(typ);
-                  }
-                }
-              }
-              else
-              {
-                list = {line.data(), line.size() + 1 + list.size()}; // restore list for next readLine
-                break;
-              }
-            }
-
-            if(function.nr != 0xFF && hasTyp)
-            {
-              locomotive.functions.push_back(function);
-            }
+            locomotive.protocol = DecoderProtocol::Motorola;
           }
         }
-        else
+        else if(startsWith(line, "sid=0x"))
+        {
+          fromChars(line.substr(6), locomotive.sid, 16);
+        }
+        else if(startsWith(line, "mfxuid=0x"))
         {
-          list = {line.data(), line.size() + 1 + list.size()}; // restore list for next readLine
-          break;
+          fromChars(line.substr(9), locomotive.mfxUID, 16);
         }
+        else if(line == "funktionen" || line == "funktionen_2")
+        {
+          m_function = Function();
+          m_function.nr = 0xFF;
+          m_functionHasTyp = false; // if typ is missing the function is unused
+          m_state = State::Function;
+        }
+        return;
       }
+      endLocomotive();
+      [[fallthrough]];
 
-      if(locomotive.protocol == DecoderProtocol::DCCShort && DCC::isLongAddress(locomotive.address))
+    case State::Section:
+      if(line == "lokomotive")
+      {
+        m_locomotives.emplace_back();
+        m_state = State::Locomotive;
+      }
+      else
       {
-        locomotive.protocol = DecoderProtocol::DCCLong;
+        m_state = State::Section;
       }
+      return;
+  }
+}
 
-      locomotives.emplace_back(std::move(locomotive));
-    }
+void LocomotiveList::Parser::endFunction()
+{
+  assert(m_state == State::Function);
+  if(m_function.nr != 0xFF && m_functionHasTyp)
+  {
+    m_locomotives.back().functions.push_back(m_function);
   }
+  m_state = State::Locomotive;
+}
 
-  return locomotives;
+void LocomotiveList::Parser::endLocomotive()
+{
+  assert(m_state == State::Locomotive);
+  auto& locomotive = m_locomotives.back();
+  if(locomotive.protocol == DecoderProtocol::DCCShort && DCC::isLongAddress(locomotive.address))
+  {
+    locomotive.protocol = DecoderProtocol::DCCLong;
+  }
+  m_state = State::Section;
 }
 
 }
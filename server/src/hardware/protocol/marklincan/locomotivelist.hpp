@@ -23,6 +23,7 @@
 #ifndef TRAINTASTIC_SERVER_HARDWARE_PROTOCOL_MARKLINCAN_LOCOMOTIVELIST_HPP
 #define TRAINTASTIC_SERVER_HARDWARE_PROTOCOL_MARKLINCAN_LOCOMOTIVELIST_HPP
 
+#include <string>
 #include <string_view>
 #include <vector>
 #include <memory>
@@ -52,13 +53,60 @@ class LocomotiveList
       std::vector<Function> functions;
     };
 
-  private:
-    static std::vector<Locomotive> build(std::string_view list);
+    /**
+     * @brief Incremental locomotive list parser
+     *
+     * The list text can be passed in chunks of any size, a locomotive is
+     * added as soon as all its lines are parsed.
+     */
+    class Parser
+    {
+      private:
+        enum class State
+        {
+          Header,
+          Section,
+          Locomotive,
+          Function,
+          Invalid,
+        };
+
+        State m_state = State::Header;
+        std::string m_line; //!< incomplete line of the previous chunk
+        std::vector<Locomotive> m_locomotives;
+        Function m_function;
+        bool m_functionHasTyp = false;
+
+        void parseLine(std::string_view line);
+        void endFunction();
+        void endLocomotive();
+
+      public:
+        void parse(std::string_view text);
+
+        //! Parse the remaining text and return the locomotives
+        std::vector<Locomotive> finish();
+    };
 
+    //! Identifies the config data stream the list is build from
+    struct Source
+    {
+      uint32_t size = 0; //!< config data stream length
+      uint16_t crc = 0; //!< config data stream CRC
+    };
+
+  private:
     const std::vector<Locomotive> m_locomotives;
+    const Source m_source;
 
   public:
     LocomotiveList(std::string_view list = {});
+    LocomotiveList(std::vector<Locomotive> locomotives, Source source);
+
+    const Source& source() const
+    {
+      return m_source;
+    }
 
     auto begin() const { return m_locomotives.begin(); }
     auto end() const { return m_locomotives.end(); }
@@ -59,7 +59,7 @@ void Kernel::start()
   // reset all state values
   m_trackPowerOn = TriState::Undefined;
   m_emergencyStop = TriState::Undefined;
-  m_inputValues.fill(TriState::Undefined);
+  m_inputValues.reset();
 
   m_thread = std::thread(
     [this]()
@@ -131,6 +131,7 @@ void Kernel::receive(const Message& message)
     case idFeedbackBroadcast:
     {
       const auto* feedback = static_cast<const FeedbackBroadcast*>(&message);
+      InputValues::Changes inputChanges;
 
       for(uint8_t i = 0; i < feedback->pairCount(); i++)
       {
@@ -146,30 +147,7 @@ void Kernel::receive(const Message& message)
           case FeedbackBroadcast::Pair::Type::FeedbackModule:
             if(m_inputController)
             {
-              const uint16_t baseAddress = pair.groupAddress() << 2;
-
-              for(uint16_t j = 0; j < 4; j++)
-              {
-                const uint16_t fullAddress = baseAddress + j;
-                const TriState value = toTriState((pair.statusNibble() & (1 << j)) != 0);
-                if(m_inputValues[fullAddress] != value)
-                {
-                  if(m_config.debugLogInput)
-                    EventLoop::call(
-                      [this, address=1 + fullAddress, value]()
-                      {
-                        Log::log(logId, LogMessage::D2007_INPUT_X_IS_X, address, value == TriState::True ? std::string_view{"1"} : std::string_view{"0"});
-                      });
-
-                  m_inputValues[fullAddress] = value;
-
-                  EventLoop::call(
-                    [this, address=1 + fullAddress, value]()
-                    {
-                      m_inputController->updateInputValue(InputChannel::Input, address, value);
-                    });
-                }
-              }
+              m_inputValues.update(pair.groupAddress() << 2, pair.statusNibble(), 4, inputChanges);
             }
             break;
 
@@ -178,6 +156,20 @@ void Kernel::receive(const Message& message)
         }
       }
 
+      if(!inputChanges.empty())
+      {
+        EventLoop::call(
+          [this, changes=std::move(inputChanges), debugLogInput=m_config.debugLogInput]()
+          {
+            for(const auto& change : changes)
+            {
+              if(debugLogInput)
+                Log::log(logId, LogMessage::D2007_INPUT_X_IS_X, 1 + change.index, change.value == TriState::True ? std::string_view{"1"} : std::string_view{"0"});
+
+              m_inputController->updateInputValue(InputChannel::Input, 1 + change.index, change.value);
+            }
+          });
+      }
       break;
     }
     case 0x60:
@@ -30,6 +30,7 @@
 #include <traintastic/enum/outputpairvalue.hpp>
 #include "config.hpp"
 #include "iohandler/iohandler.hpp"
+#include "../../input/inputvalues.hpp"
 
 class Decoder;
 enum class DecoderChangeFlags;
@@ -89,7 +90,7 @@ class Kernel : public ::KernelBase
     DecoderController* m_decoderController;
 
     InputController* m_inputController;
-    std::array<TriState, inputAddressMax - inputAddressMin + 1> m_inputValues;
+    InputValues m_inputValues{inputAddressMax - inputAddressMin + 1};
 
     OutputController* m_outputController;
     //std::array<OutputPairValue, accessoryOutputAddressMax - accessoryOutputAddressMin + 1> m_outputValues;
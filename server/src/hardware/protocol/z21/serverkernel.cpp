@@ -264,7 +264,7 @@ void ServerKernel::receiveFrom(const Message& message, IOHandler::ClientId clien
 
     case LAN_LOGOFF:
       if(message == LanLogoff())
-        m_clients.erase(clientId);
+        removeClient(clientId);
       break;
 
     case LAN_GET_CODE:
@@ -352,11 +352,14 @@ void ServerKernel::removeClient(IOHandler::ClientId clientId)
 
 void ServerKernel::subscribe(IOHandler::ClientId clientId, uint16_t address, bool longAddress)
 {
-  auto& subscriptions = m_clients[clientId].subscriptions;
   const std::pair<uint16_t, bool> key{address, longAddress};
-  if(std::find(subscriptions.begin(), subscriptions.end(), key) != subscriptions.end())
+  auto& subscribers = m_subscribers[key];
+  if(std::find(subscribers.begin(), subscribers.end(), clientId) != subscribers.end())
     return;
-  subscriptions.emplace_back(address, longAddress);
+  subscribers.emplace_back(clientId);
+
+  auto& subscriptions = m_clients[clientId].subscriptions;
+  subscriptions.emplace_back(key);
   if(subscriptions.size() > ServerConfig::subscriptionMax)
     unsubscribe(clientId, *subscriptions.begin());
 
@@ -384,6 +387,14 @@ void ServerKernel::unsubscribe(IOHandler::ClientId clientId, std::pair<uint16_t,
       subscriptions.erase(it);
   }
 
+  if(auto it = m_subscribers.find(key); it != m_subscribers.end())
+  {
+    auto& subscribers = it->second;
+    subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), clientId), subscribers.end());
+    if(subscribers.empty())
+      m_subscribers.erase(it);
+  }
+
   EventLoop::call(
     [this, key]()
     {
@@ -399,17 +410,21 @@ void ServerKernel::unsubscribe(IOHandler::ClientId clientId, std::pair<uint16_t,
 void ServerKernel::decoderChanged(const Decoder& decoder, DecoderChangeFlags /*changes*/, uint32_t /*functionNumber*/)
 {
   const std::pair<uint16_t, bool> key(decoder.address, decoder.protocol == DecoderProtocol::DCCLong);
-  const LanXLocoInfo message(decoder);
+  const LanXLocoInfo message(decoder); // encoded once, sent as is to every subscribed client
 
-  EventLoop::call(
+  m_ioContext.post(
     [this, key, message]()
     {
-      for(auto it : m_clients)
-        if((it.second.broadcastFlags & BroadcastFlags::PowerLocoTurnoutChanges) == BroadcastFlags::PowerLocoTurnoutChanges)
+      const auto it = m_subscribers.find(key);
+      if(it == m_subscribers.end())
+        return;
+
+      for(const auto clientId : it->second)
+        if(auto client = m_clients.find(clientId);
+            client != m_clients.end() &&
+            (client->second.broadcastFlags & BroadcastFlags::PowerLocoTurnoutChanges) == BroadcastFlags::PowerLocoTurnoutChanges)
         {
-          auto& subscriptions = it.second.subscriptions;
-          if(std::find(subscriptions.begin(), subscriptions.end(), key) != subscriptions.end())
-            sendTo(message, it.first);
+          sendTo(message, clientId);
         }
     });
 }
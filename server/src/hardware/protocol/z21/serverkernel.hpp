@@ -27,6 +27,7 @@
 #include <list>
 #include <map>
 #include <unordered_map>
+#include <vector>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/signals2/signal.hpp>
 #include <traintastic/enum/tristate.hpp>
@@ -56,6 +57,7 @@ class ServerKernel final : public Kernel
     ServerConfig m_config;
     std::shared_ptr<DecoderList> m_decoderList;
     std::unordered_map<IOHandler::ClientId, Client> m_clients;
+    std::map<std::pair<uint16_t, bool>, std::vector<IOHandler::ClientId>> m_subscribers; //!< reverse index of Client::subscriptions, IO context only
     std::map<std::pair<uint16_t, bool>, DecoderSubscription> m_decoderSubscriptions;
     TriState m_trackPowerOn = TriState::Undefined;
     std::function<void()> m_onTrackPowerOff;
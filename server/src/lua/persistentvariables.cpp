@@ -391,6 +391,9 @@ int PersistentVariables::__newindex(lua_State* L)
   lua_rawgeti(L, LUA_REGISTRYINDEX, pv.registryIndex);
   lua_insert(L, 2); // moves key to 3 and value to 4
   lua_rawset(L, 2);
+
+  auto& script = Sandbox::getStateData(L).script();
+  script.stateChanged(script); // record in world state journal
   return 0;
 }
 
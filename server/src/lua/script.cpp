@@ -69,6 +69,7 @@ Script::Script(World& world, std::string_view _id) :
       [this]()
       {
         m_persistentVariables = nullptr;
+        stateChanged(*this);
         Log::log(*this, LogMessage::I9003_CLEARED_PERSISTENT_VARIABLES);
         updateEnabled();
       }}
@@ -117,6 +118,11 @@ void Script::save(WorldSaver& saver, nlohmann::json& data, nlohmann::json& state
 
   m_basename = id;
   saver.writeFile(std::filesystem::path(scripts) / m_basename += dotLua, code);
+}
+
+void Script::saveState(WorldSaver& saver, nlohmann::json& stateData) const
+{
+  IdObject::saveState(saver, stateData);
 
   if(m_sandbox)
   {
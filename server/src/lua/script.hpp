@@ -43,6 +43,7 @@ class Script : public IdObject
 
     void load(WorldLoader& loader, const nlohmann::json& data) final;
     void save(WorldSaver& saver, nlohmann::json& data, nlohmann::json& stateData) const final;
+    void saveState(WorldSaver& saver, nlohmann::json& stateData) const final;
     void addToWorld() final;
     void destroying() final;
     void loaded() final;
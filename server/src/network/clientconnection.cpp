@@ -26,6 +26,28 @@
 #include "../core/eventloop.hpp"
 #include "session.hpp"
 #include "../log/log.hpp"
+#include "../utils/endian.hpp"
+#include "../utils/zlib.hpp"
+
+//! Messages with at least this much data are compressed, if the client supports it
+static constexpr size_t compressThreshold = 4096;
+
+static std::unique_ptr<Message> compress(const Message& message)
+{
+  std::vector<std::byte> compressed;
+  if(!ZLib::compress(message.data(), message.dataSize(), compressed) || compressed.size() + sizeof(uint32_t) >= message.dataSize())
+    return {}; // not worth it
+
+  Message::Header header = *reinterpret_cast<const Message::Header*>(*message);
+  header.flags.compressed = 1;
+  header.dataSize = static_cast<uint32_t>(sizeof(uint32_t) + compressed.size());
+  auto result = std::make_unique<Message>(header);
+  auto* data = static_cast<std::byte*>(result->data());
+  const uint32_t size = host_to_be(message.dataSize());
+  std::memcpy(data, &size, sizeof(size));
+  std::memcpy(data + sizeof(size), compressed.data(), compressed.size());
+  return result;
+}
 
 ClientConnection::ClientConnection(Server& server, std::shared_ptr<boost::beast::websocket::stream<boost::beast::tcp_stream>> ws)
   : WebSocketConnection(server, std::move(ws), "client")
@@ -41,6 +63,18 @@ ClientConnection::~ClientConnection()
   assert(!m_session);
 }
 
+template<typename Function, typename... Args>
+void ClientConnection::callIfConnected(Function function, Args... args)
+{
+  // a raw this isn't safe here, Server::connectionGone() may have released the connection already:
+  EventLoop::call(
+    [weak=weak_from_this(), function, args...]()
+    {
+      if(auto connection = weak.lock())
+        (static_cast<ClientConnection&>(*connection).*function)(args...);
+    });
+}
+
 void ClientConnection::doRead()
 {
   assert(isServerThread());
@@ -63,7 +97,7 @@ void ClientConnection::doRead()
             {
               std::memcpy(message->data(), static_cast<const std::byte*>(m_readBuffer.cdata().data()) + sizeof(header), message->dataSize());
             }
-            EventLoop::call(&ClientConnection::processMessage, this, message);
+            callIfConnected(&ClientConnection::processMessage, message);
             m_readBuffer.consume(sizeof(header) + header.dataSize);
           }
           else
@@ -73,14 +107,14 @@ void ClientConnection::doRead()
         }
         doRead();
       }
-      else if(ec == boost::asio::error::eof || ec == boost::asio::error::connection_aborted || ec == boost::asio::error::connection_reset)
+      else if(ec == boost::asio::error::eof || ec == boost::asio::error::connection_aborted || ec == boost::asio::error::connection_reset || ec == boost::beast::error::timeout)
       {
-        EventLoop::call(std::bind(&ClientConnection::connectionLost, this));
+        callIfConnected(&ClientConnection::connectionLost);
       }
       else
       {
         Log::log(id, LogMessage::E1007_SOCKET_READ_FAILED_X, ec);
-        EventLoop::call(std::bind(&ClientConnection::disconnect, this));
+        callIfConnected(&ClientConnection::disconnect);
       }
     });
 }
@@ -89,7 +123,27 @@ void ClientConnection::doWrite()
 {
   assert(isServerThread());
 
-  m_ws->async_write(boost::asio::buffer(**m_writeQueue.front(), m_writeQueue.front()->size()),
+  // gather queued messages into one frame, if the client supports it:
+  static constexpr size_t gatherSizeMax = 64 * 1024;
+  m_writeBuffers.clear();
+  m_writeSize = 0;
+  size_t size = 0;
+  for(auto& message : m_writeQueue)
+  {
+    if(!m_writeBuffers.empty() && (!m_multiMessageFrame || size + message->size() > gatherSizeMax))
+      break;
+    m_writeSize += message->size();
+    if(m_compressMessages && message->dataSize() >= compressThreshold && !message->isCompressed())
+    {
+      if(auto compressed = compress(*message))
+        message = std::move(compressed);
+    }
+    m_writeBuffers.emplace_back(**message, message->size());
+    size += message->size();
+  }
+  m_writeCount = m_writeBuffers.size();
+
+  m_ws->async_write(m_writeBuffers,
     [this, weak=weak_from_this()](const boost::system::error_code& ec, std::size_t /*bytesTransferred*/)
     {
       if(weak.expired())
@@ -97,14 +151,17 @@ void ClientConnection::doWrite()
 
       if(!ec)
       {
-        m_writeQueue.pop();
+        m_writeQueue.erase(m_writeQueue.begin(), m_writeQueue.begin() + m_writeCount);
+        const size_t queueSize = (m_writeQueueSize -= m_writeSize);
+        if(queueSize < writeQueueSizeLow && m_notifyWriteQueueLow.exchange(false))
+          callIfConnected(&ClientConnection::writeQueueLow);
         if(!m_writeQueue.empty())
           doWrite();
       }
       else if(ec != boost::asio::error::operation_aborted)
       {
         Log::log(id, LogMessage::E1006_SOCKET_WRITE_FAILED_X, ec);
-        EventLoop::call(std::bind(&ClientConnection::disconnect, this));
+        callIfConnected(&ClientConnection::disconnect);
       }
     });
 }
@@ -115,6 +172,7 @@ void ClientConnection::processMessage(const std::shared_ptr<Message> message)
 
   if(m_authenticated && m_session)
   {
+    m_session->m_receiveCount++;
     if(m_session->processMessage(*message))
       return;
   }
@@ -129,13 +187,43 @@ void ClientConnection::processMessage(const std::shared_ptr<Message> message)
       sendMessage(std::move(response));
       return;
     }
+    if(message->command() == Message::Command::ResumeSession && message->type() == Message::Type::Request)
+    {
+      const auto uuid = message->read<boost::uuids::uuid>();
+      const auto receiveCount = message->read<uint32_t>(); // number of session messages received by the client
+      if(auto session = m_server.resumeSession(uuid, receiveCount))
+      {
+        m_session = std::move(session);
+        m_session->resume(std::dynamic_pointer_cast<ClientConnection>(shared_from_this()), receiveCount);
+        auto response = Message::newResponse(message->command(), message->requestId());
+        response->write(m_session->m_receiveCount); // client resends the messages the server didn't receive
+        sendMessage(std::move(response));
+      }
+      else
+      {
+        sendMessage(Message::newErrorResponse(message->command(), message->requestId(), LogMessage::C1021_UNKNOWN_SESSION));
+      }
+      return;
+    }
   }
   else
   {
     if(message->command() == Message::Command::Login && message->type() == Message::Type::Request)
     {
+      message->read<std::string_view>(); // username
+      message->read<std::string_view>(); // password
+      auto response = Message::newResponse(message->command(), message->requestId());
+      if(!message->endOfMessage()) // capabilities are optional, older clients don't send them
+      {
+        const auto capabilities = message->read<Message::Capabilities>();
+        m_multiMessageFrame = (static_cast<uint32_t>(capabilities) & static_cast<uint32_t>(Message::Capabilities::MultiMessageFrame)) != 0;
+        m_compressMessages = (static_cast<uint32_t>(capabilities) & static_cast<uint32_t>(Message::Capabilities::CompressedMessages)) != 0;
+        m_propertyIds = (static_cast<uint32_t>(capabilities) & static_cast<uint32_t>(Message::Capabilities::PropertyIds)) != 0;
+        m_tileStates = (static_cast<uint32_t>(capabilities) & static_cast<uint32_t>(Message::Capabilities::TileStates)) != 0;
+        response->write(static_cast<Message::Capabilities>(static_cast<uint32_t>(capabilities) & supportedCapabilities)); // the ones used
+      }
       m_authenticated = true; // oke for now, login can be added later :)
-      sendMessage(Message::newResponse(message->command(), message->requestId()));
+      sendMessage(std::move(response));
       return;
     }
   }
@@ -151,16 +239,59 @@ void ClientConnection::sendMessage(std::unique_ptr<Message> message)
 {
   assert(isEventLoopThread());
 
+  if(m_session)
+    m_session->send(std::move(message));
+  else
+    write(std::move(message));
+}
+
+void ClientConnection::write(std::shared_ptr<const Message> message)
+{
+  assert(isEventLoopThread());
+
+  if(m_writeQueueFull)
+    return; // disconnect pending
+
+  // a message is always accepted if nothing is queued, a single response can be larger than the limit:
+  const size_t queueSize = m_writeQueueSize;
+  if(queueSize != 0 && queueSize + message->size() > writeQueueSizeMax)
+  {
+    // client doesn't read fast enough, don't let it eat all memory:
+    Log::log(id, LogMessage::E1009_CLIENT_WRITE_QUEUE_FULL_X_BYTES_DISCONNECTING, queueSize + message->size());
+    m_writeQueueFull = true;
+    callIfConnected(&ClientConnection::disconnect);
+    return;
+  }
+  m_writeQueueSize += message->size();
+
   ioContext().post(
-    [this, msg=std::make_shared<std::unique_ptr<Message>>(std::move(message))]()
+    [this, msg=std::move(message)]()
     {
       const bool wasEmpty = m_writeQueue.empty();
-      m_writeQueue.emplace(std::move(*msg));
+      m_writeQueue.emplace_back(msg);
       if(wasEmpty)
         doWrite();
     });
 }
 
+void ClientConnection::writeQueueLow()
+{
+  assert(isEventLoopThread());
+
+  if(m_session)
+    m_session->flushPendingChanges();
+}
+
+void ClientConnection::connectionLost()
+{
+  assert(isEventLoopThread());
+
+  if(m_session) // keep the session for a while, the client can resume it after reconnecting
+    m_server.detachSession(std::move(m_session));
+
+  WebSocketConnection::connectionLost();
+}
+
 void ClientConnection::disconnect()
 {
   assert(isEventLoopThread());
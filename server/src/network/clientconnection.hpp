@@ -24,7 +24,9 @@
 #define TRAINTASTIC_SERVER_NETWORK_CLIENTCONNECTION_HPP
 
 #include <memory>
-#include <queue>
+#include <deque>
+#include <vector>
+#include <atomic>
 #include <boost/asio.hpp>
 #include <boost/beast/core/tcp_stream.hpp>
 #include <boost/beast/websocket/stream.hpp>
@@ -36,6 +38,7 @@ class Session;
 
 class ClientConnection : public WebSocketConnection
 {
+  friend class Server;
   friend class Session;
 
   protected:
@@ -43,20 +46,50 @@ class ClientConnection : public WebSocketConnection
 
     boost::beast::flat_buffer m_readBuffer;
     std::mutex m_writeQueueMutex;
-    std::queue<std::unique_ptr<Message>> m_writeQueue;
+    std::deque<std::shared_ptr<const Message>> m_writeQueue;
+    std::vector<boost::asio::const_buffer> m_writeBuffers;
+    size_t m_writeCount = 0; //!< number of messages in current write
+    size_t m_writeSize = 0; //!< uncompressed size of messages in current write
+    std::atomic<size_t> m_writeQueueSize = 0; //!< bytes, queued and being written
+    std::atomic<bool> m_notifyWriteQueueLow = false;
+    bool m_writeQueueFull = false;
+    std::atomic<bool> m_multiMessageFrame = false;
+    std::atomic<bool> m_compressMessages = false;
+    bool m_propertyIds = false; //!< see Message::Capabilities::PropertyIds
+    bool m_tileStates = false; //!< see Message::Capabilities::TileStates
     bool m_authenticated;
     std::shared_ptr<Session> m_session;
 
     void doRead() final;
     void doWrite() final;
 
+    void connectionLost() final;
+
+    //! Calls \a function in the event loop, unless the connection is gone by then
+    template<typename Function, typename... Args>
+    void callIfConnected(Function function, Args... args);
+
     void processMessage(const std::shared_ptr<Message> message);
     void sendMessage(std::unique_ptr<Message> message);
+    void write(std::shared_ptr<const Message> message);
+    void writeQueueLow();
 
   public:
+    static constexpr size_t writeQueueSizeHigh = 1024 * 1024; //!< above this coalescible changes are held back
+    static constexpr size_t writeQueueSizeLow = 256 * 1024; //!< below this held back changes are sent
+    static constexpr size_t writeQueueSizeMax = 16 * 1024 * 1024; //!< client is disconnected above this, unless the queue was empty
+    static constexpr uint32_t supportedCapabilities =
+      static_cast<uint32_t>(Message::Capabilities::MultiMessageFrame) |
+      static_cast<uint32_t>(Message::Capabilities::CompressedMessages) |
+      static_cast<uint32_t>(Message::Capabilities::PropertyIds) |
+      static_cast<uint32_t>(Message::Capabilities::TileStates);
+
     ClientConnection(Server& server, std::shared_ptr<boost::beast::websocket::stream<boost::beast::tcp_stream>> ws);
     virtual ~ClientConnection();
 
+    //! Number of bytes queued for sending, including the message(s) being written.
+    size_t writeQueueSize() const { return m_writeQueueSize; }
+
     void disconnect() final;
 };
 
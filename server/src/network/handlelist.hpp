@@ -25,48 +25,164 @@
 
 #include <cstdint>
 #include <cassert>
-#include <unordered_map>
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
 
+/**
+ * \brief Generational slot map of session handles
+ *
+ * A handle consists of a slot index and a generation. A slot is retired when
+ * its generation is exhausted, so a released handle is never reused.
+ * The handle of an item is cached in the item itself
+ * (see Object::m_sessionHandles), so both lookup directions are O(1)
+ * without hashing.
+ */
 template<typename Thandle, typename Titem>
 class HandleList
 {
   public:
     using Handle = Thandle;
 
-  protected:
-    Handle m_nextHandle;
-    std::unordered_map<Handle, Titem> m_handleToItem;
-    std::unordered_map<Titem, Handle> m_itemToHandle;
-    std::unordered_map<Handle, uint32_t> m_handleCounter;
+    static constexpr Handle invalidHandle = 0;
+
+  private:
+    static constexpr unsigned int indexBits = 20;
+    static constexpr Handle indexMask = (Handle(1) << indexBits) - 1;
+    static constexpr Handle generationMax = std::numeric_limits<Handle>::max() >> indexBits;
+
+    struct Slot
+    {
+      Titem item;
+      Handle handle = invalidHandle; //!< invalidHandle if slot is free
+      Handle generation = 0;
+      uint32_t counter = 0;
+    };
+
+    std::vector<Slot> m_slots;
+    std::deque<Handle> m_freeSlots; //!< FIFO, spreads slot reuse
+
+    const Slot* getSlot(Handle handle) const
+    {
+      const Handle index = handle & indexMask;
+      if(handle == invalidHandle || index >= m_slots.size() || m_slots[index].handle != handle)
+        return nullptr;
+      return &m_slots[index];
+    }
+
+    Slot* getSlot(Handle handle)
+    {
+      return const_cast<Slot*>(std::as_const(*this).getSlot(handle));
+    }
+
+    Handle findHandle(const typename Titem::element_type& item) const
+    {
+      for(const auto& [list, handle] : item.m_sessionHandles)
+        if(list == this)
+          return handle;
+      return invalidHandle;
+    }
+
+    void eraseHandle(typename Titem::element_type& item)
+    {
+      auto& handles = item.m_sessionHandles;
+      auto it = std::find_if(handles.begin(), handles.end(),
+        [this](const auto& entry)
+        {
+          return entry.first == this;
+        });
+      assert(it != handles.end());
+      *it = handles.back();
+      handles.pop_back();
+    }
+
+    void releaseSlot(Slot& slot)
+    {
+      eraseHandle(*slot.item);
+      slot.item = nullptr;
+      slot.handle = invalidHandle;
+      slot.counter = 0;
+      if(slot.generation < generationMax)
+        m_freeSlots.push_back(static_cast<Handle>(&slot - m_slots.data()));
+    }
 
   public:
-    static const Handle invalidHandle = 0;
+    class const_iterator
+    {
+      friend class HandleList;
 
-    HandleList() :
-      m_nextHandle{invalidHandle + 1}
+      private:
+        const Slot* m_slot;
+        const Slot* m_end;
+
+        const_iterator(const Slot* slot, const Slot* end)
+          : m_slot{slot}
+          , m_end{end}
+        {
+          skipFree();
+        }
+
+        void skipFree()
+        {
+          while(m_slot != m_end && m_slot->handle == invalidHandle)
+            m_slot++;
+        }
+
+      public:
+        std::pair<Handle, const Titem&> operator *() const
+        {
+          return {m_slot->handle, m_slot->item};
+        }
+
+        const_iterator& operator ++()
+        {
+          m_slot++;
+          skipFree();
+          return *this;
+        }
+
+        bool operator ==(const const_iterator& other) const
+        {
+          return m_slot == other.m_slot;
+        }
+
+        bool operator !=(const const_iterator& other) const
+        {
+          return m_slot != other.m_slot;
+        }
+    };
+
+    HandleList() = default;
+    HandleList(const HandleList&) = delete;
+    HandleList& operator =(const HandleList&) = delete;
+
+    ~HandleList()
     {
+      clear();
     }
 
-    auto begin() const
+    const_iterator begin() const
     {
-      return m_handleToItem.begin();
+      return {m_slots.data(), m_slots.data() + m_slots.size()};
     }
 
-    auto end() const
+    const_iterator end() const
     {
-      return m_handleToItem.end();
+      return {m_slots.data() + m_slots.size(), m_slots.data() + m_slots.size()};
     }
 
     Titem getItem(Handle handle) const
     {
-      auto it = m_handleToItem.find(handle);
-      return it != m_handleToItem.end() ? it->second : nullptr;
+      const Slot* slot = getSlot(handle);
+      return slot ? slot->item : nullptr;
     }
 
-    uint32_t getCounter(Handle handle)
+    uint32_t getCounter(Handle handle) const
     {
-      auto it = m_handleCounter.find(handle);
-      return it != m_handleCounter.end() ? it->second : 0;
+      const Slot* slot = getSlot(handle);
+      return slot ? slot->counter : 0;
     }
 
     Handle addItem(const Titem& item)
@@ -74,68 +190,73 @@ class HandleList
       if(!item)
         return invalidHandle;
 
-      auto it = m_itemToHandle.find(item);
-      if(it == m_itemToHandle.end())
-      {
-        Handle handle = m_nextHandle;
-        m_handleToItem.emplace(handle, item);
-        m_handleCounter.emplace(handle, 1);
-        m_itemToHandle.emplace(item, handle);
-        assert(m_handleToItem.size() == m_itemToHandle.size());
-        if(++m_nextHandle == invalidHandle)
-          m_nextHandle++;
+      if(const Handle handle = getHandle(*item); handle != invalidHandle)
         return handle;
+
+      Handle index;
+      if(!m_freeSlots.empty())
+      {
+        index = m_freeSlots.front();
+        m_freeSlots.pop_front();
       }
       else
       {
-        m_handleCounter[it->second]++;
-        return it->second;
+        index = static_cast<Handle>(m_slots.size());
+        if(index > indexMask)
+        {
+          assert(false); // out of handles
+          return invalidHandle;
+        }
+        m_slots.emplace_back();
       }
+
+      Slot& slot = m_slots[index];
+      slot.generation++;
+      slot.item = item;
+      slot.handle = (slot.generation << indexBits) | index;
+      slot.counter = 1;
+      item->m_sessionHandles.emplace_back(this, slot.handle);
+      return slot.handle;
+    }
+
+    /**
+     * \brief Get handle of item
+     *
+     * Increments the handle counter if the item has a handle.
+     *
+     * \param[in] item The item
+     * \return The handle or \c invalidHandle if the item has no handle
+     */
+    Handle getHandle(const typename Titem::element_type& item)
+    {
+      const Handle handle = findHandle(item);
+      if(handle != invalidHandle)
+        m_slots[handle & indexMask].counter++;
+      return handle;
     }
 
     Handle getHandle(const Titem& item)
     {
-      if(item)
-      {
-        auto it = m_itemToHandle.find(item);
-        if(it != m_itemToHandle.end())
-        {
-          m_handleCounter[it->second]++;
-          return it->second;
-        }
-      }
-      return invalidHandle;
+      return item ? getHandle(*item) : invalidHandle;
     }
 
-    void removeHandle(const Thandle& handle)
+    void removeHandle(Handle handle)
     {
-      auto it = m_handleToItem.find(handle);
-      if(it != m_handleToItem.end())
-      {
-        m_itemToHandle.erase(it->second);
-        m_handleToItem.erase(it);
-        m_handleCounter.erase(handle);
-        assert(m_handleToItem.size() == m_itemToHandle.size());
-      }
+      if(Slot* slot = getSlot(handle))
+        releaseSlot(*slot);
     }
 
     void removeItem(const Titem& item)
     {
-      auto it = m_itemToHandle.find(item);
-      if(it != m_itemToHandle.end())
-      {
-        m_handleToItem.erase(it->second);
-        m_handleCounter.erase(it->second);
-        m_itemToHandle.erase(it);
-        assert(m_handleToItem.size() == m_itemToHandle.size());
-      }
+      if(item)
+        removeHandle(findHandle(*item));
     }
 
     void clear()
     {
-      m_handleToItem.clear();
-      m_itemToHandle.clear();
-      assert(m_handleToItem.size() == m_itemToHandle.size());
+      for(auto& slot : m_slots)
+        if(slot.handle != invalidHandle)
+          releaseSlot(slot); // keeps generation, so handles aren't reused
     }
 };
 
@@ -31,6 +31,7 @@
 #include <version.hpp>
 #include "clientconnection.hpp"
 #include "httpconnection.hpp"
+#include "session.hpp"
 #include "webthrottleconnection.hpp"
 #include "../core/eventloop.hpp"
 #include "../log/log.hpp"
@@ -359,13 +360,65 @@ Server::~Server()
 
   while(!m_connections.empty())
     m_connections.front()->disconnect();
+
+  m_detachedSessions.clear();
 }
 
 void Server::connectionGone(const std::shared_ptr<WebSocketConnection>& connection)
 {
   assert(isEventLoopThread());
 
-  m_connections.erase(std::find(m_connections.begin(), m_connections.end(), connection));
+  if(auto it = std::find(m_connections.begin(), m_connections.end(), connection); it != m_connections.end())
+    m_connections.erase(it);
+}
+
+void Server::detachSession(std::shared_ptr<Session> session)
+{
+  assert(isEventLoopThread());
+
+  session->detach();
+  session->m_resumeTimer.expires_after(Session::resumeTimeout);
+  session->m_resumeTimer.async_wait(
+    [this, weak=std::weak_ptr<Session>(session)](const boost::system::error_code& ec)
+    {
+      auto expired = weak.lock();
+      if(ec || !expired || expired->m_resumeTimer.expiry() > std::chrono::steady_clock::now())
+        return; // cancelled, resumed or detached again
+      if(auto it = m_detachedSessions.find(expired->uuid()); it != m_detachedSessions.end() && it->second == expired)
+        m_detachedSessions.erase(it);
+    });
+  const auto uuid = session->uuid();
+  m_detachedSessions.emplace(uuid, std::move(session));
+}
+
+std::shared_ptr<Session> Server::resumeSession(const boost::uuids::uuid& uuid, uint32_t receiveCount)
+{
+  assert(isEventLoopThread());
+
+  auto it = m_detachedSessions.find(uuid);
+  if(it == m_detachedSessions.end())
+  {
+    // the client may notice a lost connection before the server does, take over the session from the old connection:
+    for(const auto& connection : m_connections)
+    {
+      auto client = std::dynamic_pointer_cast<ClientConnection>(connection);
+      if(client && client->m_session && client->m_session->uuid() == uuid)
+      {
+        client->connectionLost(); // detaches the session and closes the old connection
+        break;
+      }
+    }
+
+    it = m_detachedSessions.find(uuid);
+    if(it == m_detachedSessions.end())
+      return {};
+  }
+
+  auto session = std::move(it->second);
+  m_detachedSessions.erase(it);
+  if(!session->canResume(receiveCount))
+    return {}; // client creates a new session
+  return session;
 }
 
 void Server::doReceive()
@@ -534,7 +587,11 @@ bool Server::acceptWebSocketUpgradeRequest(http::request<http::string_body>&& re
   beast::get_lowest_layer(stream).expires_never(); // disable HTTP timeout
 
   auto ws = std::make_shared<websocket::stream<beast::tcp_stream>>(std::move(stream));
-  ws->set_option(websocket::stream_base::timeout::suggested(beast::role_type::server));
+  websocket::stream_base::timeout timeout;
+  timeout.handshake_timeout = handshakeTimeout;
+  timeout.idle_timeout = idleTimeout;
+  timeout.keep_alive_pings = true; // detect lost connections well before the client stops trying to resume
+  ws->set_option(timeout);
   ws->set_option(websocket::stream_base::decorator(
     [](websocket::response_type& response)
     {
@@ -26,7 +26,9 @@
 #include <memory>
 #include <array>
 #include <list>
+#include <unordered_map>
 #include <thread>
+#include <chrono>
 #include <filesystem>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
@@ -34,13 +36,17 @@
 #include <boost/beast/core/tcp_stream.hpp>
 #include <boost/beast/http/message_generator.hpp>
 #include <boost/beast/http/string_body.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/uuid/uuid.hpp>
 
 class WebSocketConnection;
+class Session;
 class Message;
 
 class Server : public std::enable_shared_from_this<Server>
 {
   friend class WebSocketConnection;//WebThrottleConnection;
+  friend class ClientConnection;
   friend class HTTPConnection;
 
   private:
@@ -52,6 +58,7 @@ class Server : public std::enable_shared_from_this<Server>
     boost::asio::ip::udp::endpoint m_remoteEndpoint;
     const bool m_localhostOnly;
     std::list<std::shared_ptr<WebSocketConnection>> m_connections;
+    std::unordered_map<boost::uuids::uuid, std::shared_ptr<Session>, boost::hash<boost::uuids::uuid>> m_detachedSessions; //!< sessions of lost connections, can be resumed by the client
     std::filesystem::path m_manualPath;
 
     void doReceive();
@@ -65,9 +72,14 @@ class Server : public std::enable_shared_from_this<Server>
 
     void connectionGone(const std::shared_ptr<WebSocketConnection>& connection);
 
+    void detachSession(std::shared_ptr<Session> session);
+    std::shared_ptr<Session> resumeSession(const boost::uuids::uuid& uuid, uint32_t receiveCount);
+
   public:
     static constexpr std::string_view id{"server"};
     static constexpr uint16_t defaultPort = 5740; //!< unoffical, not (yet) assigned by IANA
+    static constexpr auto handshakeTimeout = std::chrono::seconds(30);
+    static constexpr auto idleTimeout = std::chrono::seconds(10); //!< pings are sent after half of it, must be well below the client's resume window
 
     Server(bool localhostOnly, uint16_t port, bool discoverable);
     ~Server();
@@ -75,6 +87,9 @@ class Server : public std::enable_shared_from_this<Server>
 #ifndef NDEBUG
     inline auto threadId() const { return m_thread.get_id(); }
 #endif
+#ifdef TRAINTASTIC_TEST
+    size_t connectionCount() const { return m_connections.size(); }
+#endif
 };
 
 #endif
@@ -27,9 +27,7 @@
 #include "clientconnection.hpp"
 #include <traintastic/enum/interfaceitemtype.hpp>
 #include <traintastic/enum/attributetype.hpp>
-#ifndef NDEBUG
-  #include "../core/eventloop.hpp" // for: isEventLoopThread()
-#endif
+#include "../core/eventloop.hpp"
 #include "../core/abstractobjectlist.hpp"
 #include "../core/abstractunitproperty.hpp"
 #include "../core/objectproperty.tpp"
@@ -48,8 +46,11 @@
 #endif
 
 Session::Session(const std::shared_ptr<ClientConnection>& connection) :
+  m_resumeTimer{EventLoop::ioContext},
   m_connection{connection},
-  m_uuid{boost::uuids::random_generator()()}
+  m_uuid{boost::uuids::random_generator()()},
+  m_propertyIds{connection->m_propertyIds},
+  m_tileStates{connection->m_tileStates}
 {
   assert(isEventLoopThread());
 }
@@ -68,6 +69,65 @@ Session::~Session()
   }
 }
 
+void Session::send(std::unique_ptr<Message> message)
+{
+  assert(isEventLoopThread());
+
+  flushPendingChanges(); // send pending changes first, to keep message order
+
+  std::shared_ptr<const Message> shared{std::move(message)};
+  m_sendCount++;
+
+  if(m_resumable)
+  {
+    m_journal.emplace_back(shared);
+    m_journalSize += shared->size();
+    while(m_journalSize > journalSizeMax && m_journal.size() > 1)
+    {
+      if(!m_connection && m_sendCount - m_detachedSendCount >= m_journal.size())
+      {
+        // message the client never received is dropped, the session can't be resumed anymore:
+        m_resumable = false;
+        m_journal.clear();
+        m_journalSize = 0;
+        break;
+      }
+      m_journalSize -= m_journal.front()->size();
+      m_journal.pop_front();
+    }
+  }
+
+  if(m_connection)
+    m_connection->write(std::move(shared));
+}
+
+void Session::detach()
+{
+  assert(isEventLoopThread());
+  m_connection.reset();
+  m_detachedSendCount = m_sendCount;
+}
+
+bool Session::canResume(uint32_t receiveCount) const
+{
+  // the journal must contain all messages the client didn't receive:
+  return m_resumable && m_sendCount - receiveCount <= m_journal.size();
+}
+
+void Session::resume(const std::shared_ptr<ClientConnection>& connection, uint32_t receiveCount)
+{
+  assert(isEventLoopThread());
+  assert(!m_connection);
+  assert(canResume(receiveCount));
+
+  m_resumeTimer.cancel();
+  m_connection = connection;
+
+  // resend the messages the client didn't receive:
+  for(auto it = m_journal.end() - (m_sendCount - receiveCount); it != m_journal.end(); ++it)
+    m_connection->write(*it);
+}
+
 bool Session::processMessage(const Message& message)
 {
   switch(message.command())
@@ -114,11 +174,11 @@ bool Session::processMessage(const Message& message)
       {
         auto response = Message::newResponse(message.command(), message.requestId());
         writeObject(*response, obj);
-        m_connection->sendMessage(std::move(response));
+        send(std::move(response));
       }
       else
       {
-        m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1015_UNKNOWN_OBJECT));
+        send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1015_UNKNOWN_OBJECT));
       }
       return true;
     }
@@ -148,7 +208,7 @@ bool Session::processMessage(const Message& message)
 
         auto event = Message::newEvent(message.command(), sizeof(Handle));
         event->write(handle);
-        m_connection->sendMessage(std::move(event));
+        send(std::move(event));
       }
       break;
     }
@@ -158,7 +218,7 @@ bool Session::processMessage(const Message& message)
       {
         if(ObjectPtr object = m_handles.getItem(message.read<Handle>()))
         {
-          if(AbstractProperty* property = object->getProperty(message.read<std::string>()); property && !property->isInternal())
+          if(auto* property = dynamic_cast<AbstractProperty*>(readInterfaceItem(message, *object)); property && !property->isInternal())
           {
             try
             {
@@ -188,23 +248,23 @@ bool Session::processMessage(const Message& message)
             {
               if(message.isRequest()) // send error response
               {
-                m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1018_EXCEPTION_X, e.what()));
+                send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1018_EXCEPTION_X, e.what()));
               }
               else // send changed event with current value:
                 objectPropertyChanged(*property);
             }
 
             if(message.isRequest()) // send success response
-              m_connection->sendMessage(Message::newResponse(message.command(), message.requestId()));
+              send(Message::newResponse(message.command(), message.requestId()));
           }
           else if(message.isRequest()) // send error response
           {
-            m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1016_UNKNOWN_PROPERTY));
+            send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1016_UNKNOWN_PROPERTY));
           }
         }
         else if(message.isRequest()) // send error response
         {
-          m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1015_UNKNOWN_OBJECT));
+          send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1015_UNKNOWN_OBJECT));
         }
       }
       return true;
@@ -215,7 +275,7 @@ bool Session::processMessage(const Message& message)
       {
         if(ObjectPtr object = m_handles.getItem(message.read<Handle>()))
         {
-          if(AbstractVectorProperty* property = object->getVectorProperty(message.read<std::string>()); property && !property->isInternal())
+          if(auto* property = dynamic_cast<AbstractVectorProperty*>(readInterfaceItem(message, *object)); property && !property->isInternal())
           {
             try
             {
@@ -247,23 +307,23 @@ bool Session::processMessage(const Message& message)
             {
               if(message.isRequest()) // send error response
               {
-                m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1018_EXCEPTION_X, e.what()));
+                send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1018_EXCEPTION_X, e.what()));
               }
               else // send changed event with current value:
                 objectPropertyChanged(*property);
             }
 
             if(message.isRequest()) // send success response
-              m_connection->sendMessage(Message::newResponse(message.command(), message.requestId()));
+              send(Message::newResponse(message.command(), message.requestId()));
           }
           else if(message.isRequest()) // send error response
           {
-            m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1016_UNKNOWN_PROPERTY));
+            send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1016_UNKNOWN_PROPERTY));
           }
         }
         else if(message.isRequest()) // send error response
         {
-          m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1015_UNKNOWN_OBJECT));
+          send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1015_UNKNOWN_OBJECT));
         }
       }
       return true;
@@ -298,16 +358,16 @@ bool Session::processMessage(const Message& message)
             {
               auto response = Message::newResponse(message.command(), message.requestId());
               writeObject(*response, obj);
-              m_connection->sendMessage(std::move(response));
+              send(std::move(response));
             }
             else
-              m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1015_UNKNOWN_OBJECT));
+              send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1015_UNKNOWN_OBJECT));
           }
           else // send error response
-            m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1016_UNKNOWN_PROPERTY));
+            send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1016_UNKNOWN_PROPERTY));
         }
         else // send error response
-          m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1015_UNKNOWN_OBJECT));
+          send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1015_UNKNOWN_OBJECT));
 
         return true;
       }
@@ -328,16 +388,16 @@ bool Session::processMessage(const Message& message)
               auto response = Message::newResponse(message.command(), message.requestId());
               for(size_t i = startIndex; i <= endIndex; i++)
                 writeObject(*response, property->getObject(i));
-              m_connection->sendMessage(std::move(response));
+              send(std::move(response));
             }
             else // send error response
-              m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1017_INVALID_INDICES));
+              send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1017_INVALID_INDICES));
           }
           else // send error response
-            m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1016_UNKNOWN_PROPERTY));
+            send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1016_UNKNOWN_PROPERTY));
         }
         else // send error response
-          m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1015_UNKNOWN_OBJECT));
+          send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1015_UNKNOWN_OBJECT));
 
         return true;
       }
@@ -461,7 +521,7 @@ bool Session::processMessage(const Message& message)
                   break;
               }
 
-              m_connection->sendMessage(std::move(response));
+              send(std::move(response));
               return true;
             }
           }
@@ -469,7 +529,7 @@ bool Session::processMessage(const Message& message)
           {
             if(message.isRequest())
             {
-              m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), e.message(), e.args()));
+              send(Message::newErrorResponse(message.command(), message.requestId(), e.message(), e.args()));
               return true;
             }
             // we can't report it back to the caller, so just log it.
@@ -479,7 +539,7 @@ bool Session::processMessage(const Message& message)
           {
             if(message.isRequest())
             {
-              m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1018_EXCEPTION_X, e.what()));
+              send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1018_EXCEPTION_X, e.what()));
               return true;
             }
           }
@@ -497,7 +557,7 @@ bool Session::processMessage(const Message& message)
           assert(model);
           auto response = Message::newResponse(message.command(), message.requestId());
           writeTableModel(*response, model);
-          m_connection->sendMessage(std::move(response));
+          send(std::move(response));
 
           model->columnHeadersChanged = [this](const TableModelPtr& tableModel)
             {
@@ -506,7 +566,7 @@ bool Session::processMessage(const Message& message)
               event->write(tableModel->columnCount());
               for(const auto& text : tableModel->columnHeaders())
                 event->write(text);
-              m_connection->sendMessage(std::move(event));
+              send(std::move(event));
             };
 
           model->rowCountChanged = [this](const TableModelPtr& tableModel)
@@ -514,7 +574,7 @@ bool Session::processMessage(const Message& message)
               auto event = Message::newEvent(Message::Command::TableModelRowCountChanged);
               event->write(m_handles.getHandle(std::dynamic_pointer_cast<Object>(tableModel)));
               event->write(tableModel->rowCount());
-              m_connection->sendMessage(std::move(event));
+              send(std::move(event));
             };
 
           model->updateRegion = [this](const TableModelPtr& tableModel, const TableModel::Region& region)
@@ -530,13 +590,13 @@ bool Session::processMessage(const Message& message)
                 for(uint32_t column = region.columnMin; column <= region.columnMax; column++)
                   event->write(tableModel->getText(column, row));
 
-              m_connection->sendMessage(std::move(event));
+              send(std::move(event));
             };
 
           return true;
         }
       }
-      m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1019_OBJECT_NOT_A_TABLE));
+      send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1019_OBJECT_NOT_A_TABLE));
       return true;
     }
     case Message::Command::ReleaseTableModel:
@@ -571,7 +631,7 @@ bool Session::processMessage(const Message& message)
           response->write(info.used);
           response->write(info.value);
         }
-        m_connection->sendMessage(std::move(response));
+        send(std::move(response));
         return true;
       }
       break;
@@ -605,7 +665,7 @@ bool Session::processMessage(const Message& message)
               break;
           }
         }
-        m_connection->sendMessage(std::move(response));
+        send(std::move(response));
         return true;
       }
       break;
@@ -627,7 +687,7 @@ bool Session::processMessage(const Message& message)
           if(tile.data().isActive())
             writeObject(*response, it.second);
         }
-        m_connection->sendMessage(std::move(response));
+        send(std::move(response));
         return true;
       }
       break;
@@ -646,7 +706,7 @@ bool Session::processMessage(const Message& message)
         response->write(item.menu);
         response->writeBlockEnd();
       }
-      m_connection->sendMessage(std::move(response));
+      send(std::move(response));
       return true;
     }
     case Message::Command::ServerLog:
@@ -670,11 +730,11 @@ bool Session::processMessage(const Message& message)
           std::vector<std::byte> worldData;
           message.read(worldData);
           Traintastic::instance->importWorld(worldData);
-          m_connection->sendMessage(Message::newResponse(message.command(), message.requestId()));
+          send(Message::newResponse(message.command(), message.requestId()));
         }
         catch(const LogMessageException& e)
         {
-          m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), e.message(), e.args()));
+          send(Message::newErrorResponse(message.command(), message.requestId(), e.message(), e.args()));
         }
       }
       break;
@@ -690,16 +750,16 @@ bool Session::processMessage(const Message& message)
             Traintastic::instance->world->export_(worldData);
             auto response = Message::newResponse(message.command(), message.requestId());
             response->write(worldData);
-            m_connection->sendMessage(std::move(response));
+            send(std::move(response));
           }
           catch(const LogMessageException& e)
           {
-            m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), e.message(), e.args()));
+            send(Message::newErrorResponse(message.command(), message.requestId(), e.message(), e.args()));
           }
         }
         else
         {
-          m_connection->sendMessage(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1010_EXPORTING_WORLD_FAILED_X, "nullptr"));
+          send(Message::newErrorResponse(message.command(), message.requestId(), LogMessage::C1010_EXPORTING_WORLD_FAILED_X, "nullptr"));
         }
         return true;
       }
@@ -716,16 +776,16 @@ bool Session::processMessage(const Message& message)
             auto throttle = ClientThrottle::create(*Traintastic::instance->world);
             auto response = message.response();
             writeObject(*response, throttle);
-            m_connection->sendMessage(std::move(response));
+            send(std::move(response));
           }
           else
           {
-            m_connection->sendMessage(message.errorResponse(LogMessage::C1015_UNKNOWN_OBJECT)); // FIXME change error
+            send(message.errorResponse(LogMessage::C1015_UNKNOWN_OBJECT)); // FIXME change error
           }
         }
         else
         {
-          m_connection->sendMessage(message.errorResponse(LogMessage::C1015_UNKNOWN_OBJECT)); // FIXME change error
+          send(message.errorResponse(LogMessage::C1015_UNKNOWN_OBJECT)); // FIXME change error
         }
         return true;
       }
@@ -748,21 +808,21 @@ bool Session::processMessage(const Message& message)
               {
                 writeObject(*response, list->getObject(i));
               }
-              m_connection->sendMessage(std::move(response));
+              send(std::move(response));
             }
             else // send error response
             {
-              m_connection->sendMessage(message.errorResponse(LogMessage::C1017_INVALID_INDICES));
+              send(message.errorResponse(LogMessage::C1017_INVALID_INDICES));
             }
           }
           else
           {
-            m_connection->sendMessage(message.errorResponse(LogMessage::C1015_UNKNOWN_OBJECT));
+            send(message.errorResponse(LogMessage::C1015_UNKNOWN_OBJECT));
           }
         }
         else
         {
-          m_connection->sendMessage(message.errorResponse(LogMessage::C1015_UNKNOWN_OBJECT));
+          send(message.errorResponse(LogMessage::C1015_UNKNOWN_OBJECT));
         }
         return true;
       }
@@ -780,6 +840,21 @@ bool Session::isSessionObject(const ObjectPtr& object)
   return dynamic_cast<ClientThrottle*>(object.get());
 }
 
+InterfaceItem* Session::readInterfaceItem(const Message& message, const Object& object) const
+{
+  if(m_propertyIds)
+    return object.interfaceItems().findById(message.read<uint16_t>());
+  return object.interfaceItems().find(message.read<std::string_view>());
+}
+
+void Session::writeInterfaceItem(Message& message, const InterfaceItem& item) const
+{
+  if(m_propertyIds)
+    message.write(item.id());
+  else
+    message.write(item.name());
+}
+
 void Session::writeObject(Message& message, const ObjectPtr& object)
 {
   message.writeBlock(); // object
@@ -798,6 +873,7 @@ void Session::writeObject(Message& message, const ObjectPtr& object)
     if(auto* board = dynamic_cast<Board*>(object.get()))
     {
       m_objectSignals.emplace(handle, board->tileDataChanged.connect(std::bind(&Session::boardTileDataChanged, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)));
+      m_objectSignals.emplace(handle, board->tileStateChanged.connect(std::bind(&Session::boardTileStateChanged, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)));
     }
 
     bool hasPublicEvents = false;
@@ -816,6 +892,8 @@ void Session::writeObject(Message& message, const ObjectPtr& object)
 
       message.writeBlock(); // item
       message.write(name);
+      if(m_propertyIds)
+        message.write(item.id());
 
       if(auto* baseProperty = dynamic_cast<BaseProperty*>(&item))
       {
@@ -938,18 +1016,18 @@ void Session::memoryLoggerChanged(const MemoryLogger& logger, const uint32_t add
       event->write(log.args->at(j));
   }
 
-  m_connection->sendMessage(std::move(event));
+  send(std::move(event));
 }
 
 void Session::objectDestroying(Object& object)
 {
-  const auto handle = m_handles.getHandle(object.shared_from_this());
+  const auto handle = m_handles.getHandle(object);
   m_handles.removeHandle(handle);
   m_objectSignals.erase(handle);
 
   auto event = Message::newEvent(Message::Command::ObjectDestroyed, sizeof(Handle));
   event->write(handle);
-  m_connection->sendMessage(std::move(event));
+  send(std::move(event));
 }
 
 void Session::objectPropertyChanged(BaseProperty& baseProperty)
@@ -957,9 +1035,95 @@ void Session::objectPropertyChanged(BaseProperty& baseProperty)
   if(baseProperty.isInternal())
     return;
 
+  // Changes are collected and sent once per event loop iteration, so a
+  // property that changes multiple times only sends its latest value:
+  if(!m_changedPropertySet.emplace(&baseProperty).second)
+    return; // already pending
+
+  m_changedProperties.push_back({baseProperty.object().shared_from_this(), &baseProperty});
+  postFlushPendingChanges();
+}
+
+void Session::postFlushPendingChanges()
+{
+  if(m_flushPosted)
+    return;
+
+  m_flushPosted = true;
+  EventLoop::call(
+    [weak=weak_from_this()]()
+    {
+      if(auto session = weak.lock())
+      {
+        session->m_flushPosted = false;
+        session->flushPendingChanges();
+      }
+    });
+}
+
+bool Session::isClientBehind()
+{
+  if(!m_connection)
+    return false; // detached, only journaled
+
+  const size_t queueSize = m_connection->writeQueueSize();
+  if(!m_clientBehind && queueSize > ClientConnection::writeQueueSizeHigh)
+  {
+    Log::log(m_connection->id, LogMessage::W1005_CLIENT_CANT_KEEP_UP_X_BYTES_QUEUED, queueSize);
+    m_clientBehind = true;
+  }
+  else if(m_clientBehind && queueSize < ClientConnection::writeQueueSizeLow)
+  {
+    m_clientBehind = false;
+  }
+
+  if(m_clientBehind)
+  {
+    m_connection->m_notifyWriteQueueLow = true;
+    // queue may have drained before the flag was set:
+    if(m_connection->writeQueueSize() < ClientConnection::writeQueueSizeLow)
+    {
+      m_connection->m_notifyWriteQueueLow = false;
+      m_clientBehind = false;
+    }
+  }
+
+  return m_clientBehind;
+}
+
+void Session::flushPendingChanges()
+{
+  if(m_changedProperties.empty() && m_changedTileStates.empty())
+    return;
+
+  // property and tile state changes are coalescible, they are held back (and merged) while the
+  // client can't keep up, ClientConnection::writeQueueLow() flushes them when it has caught up:
+  if(isClientBehind())
+    return;
+
+  // the send functions call ClientConnection::sendMessage which calls this function, so move them out first:
+  auto changedProperties = std::move(m_changedProperties);
+  m_changedProperties.clear();
+  m_changedPropertySet.clear();
+  auto changedTileStates = std::move(m_changedTileStates);
+  m_changedTileStates.clear();
+
+  for(const auto& item : changedProperties)
+    sendPropertyChanged(item.object, *item.property);
+
+  for(const auto& item : changedTileStates)
+    sendTileStatesChanged(item);
+}
+
+void Session::sendPropertyChanged(const ObjectPtr& object, BaseProperty& baseProperty)
+{
+  const auto handle = m_handles.getHandle(object);
+  if(handle == Handles::invalidHandle)
+    return; // object is released or destroyed
+
   auto event = Message::newEvent(Message::Command::ObjectPropertyChanged);
-  event->write(m_handles.getHandle(baseProperty.object().shared_from_this()));
-  event->write(baseProperty.name());
+  event->write(handle);
+  writeInterfaceItem(*event, baseProperty);
   event->write(baseProperty.type());
   if(auto* property = dynamic_cast<AbstractProperty*>(&baseProperty))
   {
@@ -973,7 +1137,7 @@ void Session::objectPropertyChanged(BaseProperty& baseProperty)
   else
     assert(false);
 
-  m_connection->sendMessage(std::move(event));
+  send(std::move(event));
 }
 
 void Session::writePropertyValue(Message& message , const AbstractProperty& property)
@@ -1057,16 +1221,16 @@ void Session::writeVectorPropertyValue(Message& message , const AbstractVectorPr
 void Session::objectAttributeChanged(AbstractAttribute& attribute)
 {
   auto event = Message::newEvent(Message::Command::ObjectAttributeChanged);
-  event->write(m_handles.getHandle(attribute.item().object().shared_from_this()));
-  event->write(attribute.item().name());
+  event->write(m_handles.getHandle(attribute.item().object()));
+  writeInterfaceItem(*event, attribute.item());
   writeAttribute(*event, attribute);
-  m_connection->sendMessage(std::move(event));
+  send(std::move(event));
 }
 
 void Session::objectEventFired(const AbstractEvent& event, const Arguments& arguments)
 {
   auto message = Message::newEvent(Message::Command::ObjectEventFired);
-  message->write(m_handles.getHandle(event.object().shared_from_this()));
+  message->write(m_handles.getHandle(event.object()));
   message->write(event.name());
   message->write(static_cast<uint32_t>(arguments.size()));
   size_t i = 0;
@@ -1105,7 +1269,7 @@ void Session::objectEventFired(const AbstractEvent& event, const Arguments& argu
     }
     i++;
   }
-  m_connection->sendMessage(std::move(message));
+  send(std::move(message));
 }
 
 void Session::writeAttribute(Message& message , const AbstractAttribute& attribute)
@@ -1188,10 +1352,50 @@ void Session::writeTypeInfo(Message& message, const TypeInfo& typeInfo)
     message.write(typeInfo.setName);
 }
 
+void Session::boardTileStateChanged(Board& board, const TileLocation& location, uint8_t state)
+{
+  if(!m_tileStates) // client can't process BoardTileStatesChanged, send complete tile data
+  {
+    if(auto tile = board.getTile(location))
+      boardTileDataChanged(board, location, tile->data());
+    return;
+  }
+
+  auto it = std::find_if(m_changedTileStates.begin(), m_changedTileStates.end(),
+    [&board](const auto& item)
+    {
+      return item.board.get() == &board;
+    });
+  if(it == m_changedTileStates.end())
+    it = m_changedTileStates.insert(it, {std::static_pointer_cast<Board>(board.shared_from_this()), {}, {}});
+  if(auto [index, added] = it->indexes.emplace(location, it->states.size()); added)
+    it->states.emplace_back(location, state);
+  else
+    it->states[index->second].second = state; // merge, only the last state matters
+  postFlushPendingChanges();
+}
+
+void Session::sendTileStatesChanged(const ChangedTileStates& changed)
+{
+  const auto handle = m_handles.getHandle(*changed.board);
+  if(handle == Handles::invalidHandle)
+    return; // board is released or destroyed
+
+  auto event = Message::newEvent(Message::Command::BoardTileStatesChanged, sizeof(Handle) + sizeof(uint32_t) + changed.states.size() * (sizeof(TileLocation) + sizeof(uint8_t)));
+  event->write(handle);
+  event->write(static_cast<uint32_t>(changed.states.size()));
+  for(const auto& [location, state] : changed.states)
+  {
+    event->write(location);
+    event->write(state);
+  }
+  send(std::move(event));
+}
+
 void Session::boardTileDataChanged(Board& board, const TileLocation& location, const TileData& data)
 {
   auto event = Message::newEvent(Message::Command::BoardTileDataChanged);
-  event->write(m_handles.getHandle(board.shared_from_this()));
+  event->write(m_handles.getHandle(board));
   event->write(location);
   event->write(data);
   assert(data.isActive() == isActive(data.id()));
@@ -1201,5 +1405,5 @@ void Session::boardTileDataChanged(Board& board, const TileLocation& location, c
     assert(tile);
     writeObject(*event, tile);
   }
-  m_connection->sendMessage(std::move(event));
+  send(std::move(event));
 }
@@ -24,10 +24,16 @@
 #define TRAINTASTIC_SERVER_NETWORK_SESSION_HPP
 
 #include <memory>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/signals2/connection.hpp>
 #include <traintastic/network/message.hpp>
 #include <traintastic/enum/tristate.hpp>
+#include <traintastic/board/tilelocation.hpp>
 #include "handlelist.hpp"
 #include "../core/objectptr.hpp"
 #include "../core/tablemodelptr.hpp"
@@ -40,17 +46,22 @@ class AbstractProperty;
 class AbstractVectorProperty;
 class AbstractAttribute;
 class AbstractEvent;
+class InterfaceItem;
 class InputMonitor;
 class OutputKeyboard;
 class Board;
 class OutputMap;
 struct TypeInfo;
-struct TileLocation;
 struct TileData;
 
 class Session : public std::enable_shared_from_this<Session>
 {
   friend class ClientConnection;
+  friend class Server;
+
+  public:
+    static constexpr size_t journalSizeMax = 1024 * 1024; //!< bytes
+    static constexpr auto resumeTimeout = std::chrono::seconds(60);
 
   private:
     static void writePropertyValue(Message& message, const AbstractProperty& property);
@@ -60,19 +71,57 @@ class Session : public std::enable_shared_from_this<Session>
 
     boost::signals2::scoped_connection m_memoryLoggerChanged;
 
+    struct ChangedProperty
+    {
+      ObjectPtr object; //!< keeps the object alive until the change is sent
+      BaseProperty* property;
+    };
+
+    std::vector<ChangedProperty> m_changedProperties; //!< in order of first change
+    std::unordered_set<const BaseProperty*> m_changedPropertySet;
+
+    struct ChangedTileStates
+    {
+      std::shared_ptr<Board> board;
+      std::vector<std::pair<TileLocation, uint8_t>> states; //!< in order of first change
+      std::unordered_map<TileLocation, size_t, TileLocationHash> indexes; //!< location -> index in states
+    };
+
+    std::vector<ChangedTileStates> m_changedTileStates;
+    bool m_flushPosted = false;
+    bool m_clientBehind = false; //!< coalescible changes are held back, see isClientBehind()
+
+    uint32_t m_sendCount = 0; //!< number of messages sent to the client
+    uint32_t m_receiveCount = 0; //!< number of messages received from the client
+    std::deque<std::shared_ptr<const Message>> m_journal; //!< last sent messages, for resuming the session
+    size_t m_journalSize = 0;
+    uint32_t m_detachedSendCount = 0;
+    bool m_resumable = true;
+    boost::asio::steady_timer m_resumeTimer;
+
   protected:
     using Handle = uint32_t;
     using Handles = HandleList<Handle, ObjectPtr>;
 
     std::shared_ptr<ClientConnection> m_connection;
     boost::uuids::uuid m_uuid;
+    const bool m_propertyIds; //!< see Message::Capabilities::PropertyIds
+    const bool m_tileStates; //!< see Message::Capabilities::TileStates
     Handles m_handles;
     std::unordered_multimap<Handle, boost::signals2::scoped_connection> m_objectSignals;
 
     bool processMessage(const Message& message);
 
+    void send(std::unique_ptr<Message> message);
+
+    void detach();
+    bool canResume(uint32_t receiveCount) const;
+    void resume(const std::shared_ptr<ClientConnection>& connection, uint32_t receiveCount);
+
     bool isSessionObject(const ObjectPtr& object);
 
+    InterfaceItem* readInterfaceItem(const Message& message, const Object& object) const;
+    void writeInterfaceItem(Message& message, const InterfaceItem& item) const;
     void writeObject(Message& message, const ObjectPtr& object);
     void writeTableModel(Message& message, const TableModelPtr& model);
 
@@ -80,10 +129,16 @@ class Session : public std::enable_shared_from_this<Session>
 
     void objectDestroying(Object& object);
     void objectPropertyChanged(BaseProperty& property);
+    void sendPropertyChanged(const ObjectPtr& object, BaseProperty& property);
+    void sendTileStatesChanged(const ChangedTileStates& changed);
+    bool isClientBehind();
+    void postFlushPendingChanges();
+    void flushPendingChanges();
     void objectAttributeChanged(AbstractAttribute& attribute);
     void objectEventFired(const AbstractEvent& event, const Arguments& arguments);
 
     void boardTileDataChanged(Board& board, const TileLocation& location, const TileData& data);
+    void boardTileStateChanged(Board& board, const TileLocation& location, uint8_t state);
 
   public:
     Session(const std::shared_ptr<ClientConnection>& connection);
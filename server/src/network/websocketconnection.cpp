@@ -67,6 +67,10 @@ void WebSocketConnection::disconnect()
 {
   assert(isEventLoopThread());
 
+  if(m_disconnecting)
+    return;
+  m_disconnecting = true;
+
   m_server.m_ioContext.post(
     [this]()
     {
@@ -39,6 +39,7 @@ class WebSocketConnection : public std::enable_shared_from_this<WebSocketConnect
 protected:
   Server& m_server;
   std::shared_ptr<boost::beast::websocket::stream<boost::beast::tcp_stream>> m_ws;
+  bool m_disconnecting = false; //!< disconnect() is called, it can be called again by a pending read/write error
 
 #ifndef NDEBUG
   bool isServerThread() const;
@@ -49,7 +50,7 @@ protected:
   virtual void doRead() = 0;
   virtual void doWrite() = 0;
 
-  void connectionLost();
+  virtual void connectionLost();
 
 public:
   const std::string id;
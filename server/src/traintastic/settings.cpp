@@ -24,6 +24,7 @@
 #include <fstream>
 #include <iomanip>
 #include "../core/attributes.hpp"
+#include "../enum/worldcompression.hpp"
 #include "traintastic.hpp"
 #include "../network/server.hpp"
 #include "../log/log.hpp"
@@ -66,6 +67,8 @@ Settings::Settings(const std::filesystem::path& path)
   , loadLastWorldOnStartup{this, "load_last_world_on_startup", true, PropertyFlags::ReadWrite, [this](const bool& /*value*/){ saveToFile(); }}
   , autoSaveWorldOnExit{this, "auto_save_world_on_exit", false, PropertyFlags::ReadWrite, [this](const bool& /*value*/){ saveToFile(); }}
   , saveWorldUncompressed{this, "save_world_uncompressed", false, PropertyFlags::ReadWrite, [this](const bool& /*value*/){ saveToFile(); }}
+  , saveWorldBinary{this, "save_world_binary", false, PropertyFlags::ReadWrite, [this](const bool& /*value*/){ saveToFile(); }}
+  , saveWorldCompression{this, "save_world_compression", WorldCompression::XZ, PropertyFlags::ReadWrite, [this](const WorldCompression& /*value*/){ saveToFile(); }}
   , allowClientServerRestart{this, "allow_client_server_restart", false, PropertyFlags::ReadWrite | PropertyFlags::Internal, [this](const bool& /*value*/){ saveToFile(); }}
   , allowClientServerShutdown{this, "allow_client_server_shutdown", false, PropertyFlags::ReadWrite | PropertyFlags::Internal, [this](const bool& /*value*/){ saveToFile(); }}
   , memoryLoggerSize{this, Name::memoryLoggerSize, Default::memoryLoggerSize, PropertyFlags::ReadWrite, [this](const uint32_t& /*value*/){ saveToFile(); }}
@@ -75,6 +78,9 @@ Settings::Settings(const std::filesystem::path& path)
   m_interfaceItems.add(lastWorld);
   m_interfaceItems.add(loadLastWorldOnStartup);
   m_interfaceItems.add(autoSaveWorldOnExit);
+  m_interfaceItems.add(saveWorldBinary);
+  Attributes::addValues(saveWorldCompression, worldCompressionValues);
+  m_interfaceItems.add(saveWorldCompression);
 
 #ifndef NO_LOCALHOST_ONLY_SETTING
   Attributes::addCategory(localhostOnly, Category::network);
@@ -26,6 +26,7 @@
 #include "../core/object.hpp"
 #include <traintastic/utils/stdfilesystem.hpp>
 #include "../core/property.hpp"
+#include <traintastic/enum/worldcompression.hpp>
 
 class Settings : public Object
 {
@@ -76,6 +77,8 @@ class Settings : public Object
     Property<bool> loadLastWorldOnStartup;
     Property<bool> autoSaveWorldOnExit;
     Property<bool> saveWorldUncompressed;
+    Property<bool> saveWorldBinary;
+    Property<WorldCompression> saveWorldCompression;
     Property<bool> allowClientServerRestart;
     Property<bool> allowClientServerShutdown;
     Property<uint32_t> memoryLoggerSize;
@@ -0,0 +1,125 @@
+/**
+ * server/src/traintastic/startupprofiler.cpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "startupprofiler.hpp"
+#include <cassert>
+#include "../utils/allocationcounter.hpp"
+
+std::atomic_bool StartupProfiler::s_active{false};
+std::thread::id StartupProfiler::s_thread;
+StartupProfiler::Clock::time_point StartupProfiler::s_start;
+uint64_t StartupProfiler::s_startAllocations = 0;
+std::array<StartupProfiler::PhaseResult, StartupProfiler::phaseCount> StartupProfiler::s_phases;
+std::vector<StartupProfiler::Phase> StartupProfiler::s_stack;
+StartupProfiler::Clock::time_point StartupProfiler::s_segmentStart;
+uint64_t StartupProfiler::s_segmentAllocations = 0;
+
+std::string_view StartupProfiler::name(Phase phase)
+{
+  switch(phase)
+  {
+    case Phase::Settings:
+      return "settings";
+
+    case Phase::WorldListScan:
+      return "world_list_scan";
+
+    case Phase::ArchiveRead:
+      return "archive_read";
+
+    case Phase::JSONParse:
+      return "json_parse";
+
+    case Phase::ObjectCreation:
+      return "object_creation";
+
+    case Phase::Loaded:
+      return "loaded";
+
+    case Phase::BoardLinks:
+      return "board_links";
+
+    case Phase::PathDiscovery:
+      return "path_discovery";
+
+    case Phase::InterfaceBringUp:
+      return "interface_bring_up";
+  }
+  assert(false);
+  return {};
+}
+
+void StartupProfiler::start()
+{
+  s_thread = std::this_thread::get_id();
+  s_phases = {};
+  s_stack.clear();
+  s_stack.reserve(8);
+  s_startAllocations = allocationCount();
+  s_start = Clock::now();
+  s_active.store(true, std::memory_order_relaxed);
+}
+
+StartupProfiler::Report StartupProfiler::stop()
+{
+  assert(recording());
+  assert(s_stack.empty());
+
+  s_active.store(false, std::memory_order_relaxed);
+
+  return {Clock::now() - s_start, allocationCount() - s_startAllocations, s_phases};
+}
+
+void StartupProfiler::enter(Phase phase)
+{
+  const auto allocations = allocationCount();
+  const auto now = Clock::now();
+
+  account(now, allocations);
+  s_stack.emplace_back(phase);
+  s_phases[static_cast<size_t>(phase)].count++;
+  s_segmentStart = now;
+  s_segmentAllocations = allocations;
+}
+
+void StartupProfiler::leave()
+{
+  const auto allocations = allocationCount();
+  const auto now = Clock::now();
+
+  account(now, allocations);
+  if(!s_stack.empty())
+    s_stack.pop_back();
+  s_segmentStart = now;
+  s_segmentAllocations = allocations;
+}
+
+void StartupProfiler::account(Clock::time_point now, uint64_t allocations)
+{
+  if(s_stack.empty())
+    return;
+
+  auto& result = s_phases[static_cast<size_t>(s_stack.back())];
+  result.duration += now - s_segmentStart;
+  result.allocations += allocations - s_segmentAllocations;
+}
@@ -0,0 +1,134 @@
+/**
+ * server/src/traintastic/startupprofiler.hpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef TRAINTASTIC_SERVER_TRAINTASTIC_STARTUPPROFILER_HPP
+#define TRAINTASTIC_SERVER_TRAINTASTIC_STARTUPPROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief Measures the phases of server startup and world loading
+ *
+ * Code marks a phase using a Scope, it only records something between start()
+ * and stop() and only in the thread that called start(). Phases can be nested,
+ * e.g. board link building is done in a \c loaded() callback, time and
+ * allocations are only counted for the innermost phase. So the phases add up
+ * to the time spent in phases and can be compared directly.
+ */
+class StartupProfiler
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Phase : uint8_t
+    {
+      Settings,
+      WorldListScan,
+      ArchiveRead,
+      JSONParse,
+      ObjectCreation, //!< create objects and load their data and state
+      Loaded, //!< \c loaded() callbacks
+      BoardLinks, //!< Board::modified
+      PathDiscovery, //!< BlockPath::find
+      InterfaceBringUp, //!< world online and power on
+    };
+    static constexpr size_t phaseCount = 9;
+
+    struct PhaseResult
+    {
+      Clock::duration duration = Clock::duration::zero();
+      uint64_t allocations = 0;
+      uint32_t count = 0; //!< number of times the phase was entered
+    };
+
+    struct Report
+    {
+      Clock::duration duration; //!< from start() to stop()
+      uint64_t allocations;
+      std::array<PhaseResult, phaseCount> phases;
+    };
+
+    class Scope
+    {
+      private:
+        const bool m_recording;
+
+      public:
+        explicit Scope(Phase phase)
+          : m_recording{StartupProfiler::recording()}
+        {
+          if(m_recording)
+            StartupProfiler::enter(phase);
+        }
+
+        ~Scope()
+        {
+          if(m_recording)
+            StartupProfiler::leave();
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator =(const Scope&) = delete;
+    };
+
+  private:
+    static std::atomic_bool s_active;
+    static std::thread::id s_thread;
+    static Clock::time_point s_start;
+    static uint64_t s_startAllocations;
+    static std::array<PhaseResult, phaseCount> s_phases;
+    static std::vector<Phase> s_stack;
+    static Clock::time_point s_segmentStart; //!< start of time counted for the innermost phase
+    static uint64_t s_segmentAllocations;
+
+    static bool recording()
+    {
+      return s_active.load(std::memory_order_relaxed) && std::this_thread::get_id() == s_thread;
+    }
+
+    static void enter(Phase phase);
+    static void leave();
+    static void account(Clock::time_point now, uint64_t allocations);
+
+  public:
+    static std::string_view name(Phase phase);
+
+    static bool active()
+    {
+      return s_active.load(std::memory_order_relaxed);
+    }
+
+    //! \brief Start recording in the calling thread
+    static void start();
+
+    //! \brief Stop recording
+    static Report stop();
+};
+
+#endif
@@ -0,0 +1,90 @@
+/**
+ * server/src/traintastic/startupreport.cpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "startupreport.hpp"
+#include <algorithm>
+#include <limits>
+#include "../log/log.hpp"
+
+static double toMilliseconds(StartupProfiler::Clock::duration value)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(value).count() / 1000.0;
+}
+
+static int64_t toMillisecondsRounded(StartupProfiler::Clock::duration value)
+{
+  return std::chrono::round<std::chrono::milliseconds>(value).count();
+}
+
+static uint32_t toUInt32(uint64_t value)
+{
+  return static_cast<uint32_t>(std::min<uint64_t>(value, std::numeric_limits<uint32_t>::max()));
+}
+
+StartupReport::StartupReport()
+  : duration{this, "duration", 0, PropertyFlags::ReadOnly | PropertyFlags::NoStore | PropertyFlags::NoScript}
+  , allocations{this, "allocations", 0, PropertyFlags::ReadOnly | PropertyFlags::NoStore | PropertyFlags::NoScript}
+  , phases{*this, "phases", {}, PropertyFlags::ReadOnly | PropertyFlags::NoStore | PropertyFlags::NoScript}
+  , phaseDurations{*this, "phase_durations", {}, PropertyFlags::ReadOnly | PropertyFlags::NoStore | PropertyFlags::NoScript}
+  , phaseAllocations{*this, "phase_allocations", {}, PropertyFlags::ReadOnly | PropertyFlags::NoStore | PropertyFlags::NoScript}
+  , phaseCounts{*this, "phase_counts", {}, PropertyFlags::ReadOnly | PropertyFlags::NoStore | PropertyFlags::NoScript}
+{
+  m_interfaceItems.add(duration);
+  m_interfaceItems.add(allocations);
+  m_interfaceItems.add(phases);
+  m_interfaceItems.add(phaseDurations);
+  m_interfaceItems.add(phaseAllocations);
+  m_interfaceItems.add(phaseCounts);
+}
+
+void StartupReport::update(const StartupProfiler::Report& report)
+{
+  std::vector<std::string> names;
+  std::vector<double> durations;
+  std::vector<uint32_t> allocationCounts;
+  std::vector<uint32_t> counts;
+
+  for(size_t i = 0; i < StartupProfiler::phaseCount; i++)
+  {
+    const auto& phase = report.phases[i];
+    if(phase.count == 0)
+      continue;
+
+    const auto name = StartupProfiler::name(static_cast<StartupProfiler::Phase>(i));
+    Log::log(*this, LogMessage::I1010_STARTUP_PHASE_X_TOOK_X_MS_X_ALLOCATIONS, name, toMillisecondsRounded(phase.duration), phase.allocations);
+
+    names.emplace_back(name);
+    durations.emplace_back(toMilliseconds(phase.duration));
+    allocationCounts.emplace_back(toUInt32(phase.allocations));
+    counts.emplace_back(phase.count);
+  }
+
+  Log::log(*this, LogMessage::I1011_STARTUP_TOOK_X_MS_X_ALLOCATIONS, toMillisecondsRounded(report.duration), report.allocations);
+
+  duration.setValueInternal(toMilliseconds(report.duration));
+  allocations.setValueInternal(toUInt32(report.allocations));
+  phases.setValuesInternal(std::move(names));
+  phaseDurations.setValuesInternal(std::move(durations));
+  phaseAllocations.setValuesInternal(std::move(allocationCounts));
+  phaseCounts.setValuesInternal(std::move(counts));
+}
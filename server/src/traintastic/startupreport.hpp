@@ -0,0 +1,58 @@
+/**
+ * server/src/traintastic/startupreport.hpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef TRAINTASTIC_SERVER_TRAINTASTIC_STARTUPREPORT_HPP
+#define TRAINTASTIC_SERVER_TRAINTASTIC_STARTUPREPORT_HPP
+
+#include "../core/object.hpp"
+#include "../core/property.hpp"
+#include "../core/vectorproperty.hpp"
+#include "startupprofiler.hpp"
+
+/**
+ * \brief Result of the StartupProfiler of the last server startup
+ *
+ * The phase vectors are parallel, phases that weren't entered are left out.
+ */
+class StartupReport : public Object
+{
+  public:
+    CLASS_ID("startup_report")
+
+    static constexpr std::string_view id = classId;
+
+    Property<double> duration; //!< milliseconds, from start to ready, including time outside the phases
+    Property<uint32_t> allocations;
+    VectorProperty<std::string> phases;
+    VectorProperty<double> phaseDurations; //!< milliseconds
+    VectorProperty<uint32_t> phaseAllocations;
+    VectorProperty<uint32_t> phaseCounts; //!< number of times the phase was entered
+
+    StartupReport();
+
+    std::string getObjectId() const final { return std::string(id); }
+
+    void update(const StartupProfiler::Report& report);
+};
+
+#endif
@@ -41,6 +41,7 @@
 #include "../log/log.hpp"
 #include "../log/logmessageexception.hpp"
 #include "../lua/getversion.hpp"
+#include "startupprofiler.hpp"
 
 using nlohmann::json;
 
@@ -73,6 +74,7 @@ Traintastic::Traintastic(const std::filesystem::path& dataDir) :
   about{this, "about", std::string(versionCopyrightAndLicense), PropertyFlags::ReadOnly},
   settings{this, "settings", nullptr, PropertyFlags::ReadWrite/*ReadOnly*/},
   version{this, "version", TRAINTASTIC_VERSION_FULL, PropertyFlags::ReadOnly},
+  startupReport{this, "startup_report", std::make_shared<StartupReport>(), PropertyFlags::ReadOnly | PropertyFlags::NoStore},
   world{this, "world", nullptr, PropertyFlags::ReadWrite,
     [this](const std::shared_ptr<World>& /*newWorld*/)
     {
@@ -156,6 +158,7 @@ Traintastic::Traintastic(const std::filesystem::path& dataDir) :
   m_interfaceItems.add(about);
   m_interfaceItems.add(settings);
   m_interfaceItems.add(version);
+  m_interfaceItems.add(startupReport);
   m_interfaceItems.add(world);
   m_interfaceItems.add(worldList);
   m_interfaceItems.add(newWorld);
@@ -192,6 +195,8 @@ void Traintastic::importWorld(const std::vector<std::byte>& worldData)
 
 Traintastic::RunStatus Traintastic::run(const std::string& worldUUID, bool simulate, bool online, bool power, bool run)
 {
+  StartupProfiler::start();
+
   static const std::string boostVersion = std::string("boost ").append(std::to_string(BOOST_VERSION / 100000)).append(".").append(std::to_string(BOOST_VERSION / 100 % 100)).append(".").append(std::to_string(BOOST_VERSION % 100));
   Log::log(*this, LogMessage::I1001_TRAINTASTIC_VX, std::string_view{TRAINTASTIC_VERSION_FULL});
   Log::log(*this, LogMessage::I1006_X, boostVersion);
@@ -200,11 +205,17 @@ Traintastic::RunStatus Traintastic::run(const std::string& worldUUID, bool simul
   Log::log(*this, LogMessage::I1009_ZLIB_X, std::string_view{zlibVersion()});
   Log::log(*this, LogMessage::I9002_X, Lua::getVersion());
 
-  settings = std::make_shared<Settings>(m_dataDir);
+  {
+    StartupProfiler::Scope scope(StartupProfiler::Phase::Settings);
+    settings = std::make_shared<Settings>(m_dataDir);
+  }
   Attributes::setEnabled(restart, settings->allowClientServerRestart);
   Attributes::setEnabled(shutdown, settings->allowClientServerShutdown);
 
-  worldList = std::make_shared<WorldList>(worldDir());
+  {
+    StartupProfiler::Scope scope(StartupProfiler::Phase::WorldListScan);
+    worldList = std::make_shared<WorldList>(worldDir());
+  }
 
   if(!worldUUID.empty())
   {
@@ -236,6 +247,8 @@ Traintastic::RunStatus Traintastic::run(const std::string& worldUUID, bool simul
     if(simulate)
       world->simulation = true;
 
+    StartupProfiler::Scope scope(StartupProfiler::Phase::InterfaceBringUp);
+
     if(online)
       world->online();
 
@@ -245,6 +258,8 @@ Traintastic::RunStatus Traintastic::run(const std::string& worldUUID, bool simul
       world->powerOn();
   }
 
+  startupReport->update(StartupProfiler::stop());
+
   try
   {
     EventLoop::exec();
@@ -273,7 +288,14 @@ void Traintastic::exit()
 
 void Traintastic::loadWorldUUID(const boost::uuids::uuid& uuid)
 {
-  if(const WorldList::WorldInfo* info = worldList->find(uuid))
+  const WorldList::WorldInfo* info = worldList->find(uuid);
+  if(!info) // world might be added since the last scan
+  {
+    worldList->buildIndex();
+    info = worldList->find(uuid);
+  }
+
+  if(info)
     loadWorldPath(info->path);
   else
     Log::log(*this, LogMessage::E1002_WORLD_X_DOESNT_EXIST, to_string(uuid));
@@ -286,13 +308,16 @@ void Traintastic::loadWorldPath(const std::filesystem::path& path)
 #ifndef NDEBUG
     std::weak_ptr<World> weakWorld = world.value();
 #endif
-    world = WorldLoader(path).world();
+    world = nullptr; // closes the journal of the current world, the loader reads it if the same world is loaded again
 #ifndef NDEBUG
     assert(weakWorld.expired());
 #endif
+    world = WorldLoader(path).world();
     settings->lastWorld = world->uuid.value();
     Log::log(*this, LogMessage::N1027_LOADED_WORLD_X, world->name.value());
 
+    StartupProfiler::Scope scope(StartupProfiler::Phase::InterfaceBringUp);
+
     if(world->onlineWhenLoaded)
     {
       world->online();
@@ -33,6 +33,7 @@
 #include "../core/objectproperty.hpp"
 #include "../core/method.hpp"
 #include "settings.hpp"
+#include "startupreport.hpp"
 #include "../world/world.hpp"
 #include "../world/worldlist.hpp"
 
@@ -73,6 +74,7 @@ class Traintastic final : public Object
     Property<std::string> about;
     ObjectProperty<Settings> settings;
     Property<std::string> version;
+    ObjectProperty<StartupReport> startupReport;
     ObjectProperty<World> world;
     ObjectProperty<WorldList> worldList;
     Method<void()> newWorld;
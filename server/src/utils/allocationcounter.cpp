@@ -0,0 +1,122 @@
+/**
+ * server/src/utils/allocationcounter.cpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "allocationcounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+namespace {
+
+//! \brief Allocation count of a single thread, only written by that thread
+struct ThreadCounter
+{
+  std::atomic<uint64_t> count{0};
+  ThreadCounter* prev = nullptr;
+  ThreadCounter* next = nullptr;
+  bool registered = false;
+};
+
+std::mutex countersMutex;
+ThreadCounter* counters = nullptr; //!< counters of running threads, guarded by countersMutex
+uint64_t exitedCount = 0; //!< allocations of exited threads, guarded by countersMutex
+
+thread_local ThreadCounter threadCounter; // constant initialized, no guard on access
+
+//! \brief Adds the thread's counter to the list, moves its count to \c exitedCount when the thread exits
+struct ThreadCounterRegistration
+{
+  ThreadCounterRegistration()
+  {
+    std::lock_guard<std::mutex> lock(countersMutex);
+    threadCounter.next = counters;
+    if(counters)
+      counters->prev = &threadCounter;
+    counters = &threadCounter;
+  }
+
+  ~ThreadCounterRegistration()
+  {
+    std::lock_guard<std::mutex> lock(countersMutex);
+    exitedCount += threadCounter.count.load(std::memory_order_relaxed);
+    if(threadCounter.prev)
+      threadCounter.prev->next = threadCounter.next;
+    else
+      counters = threadCounter.next;
+    if(threadCounter.next)
+      threadCounter.next->prev = threadCounter.prev;
+  }
+};
+
+inline void countAllocation()
+{
+  if(!threadCounter.registered) [[unlikely]]
+  {
+    threadCounter.registered = true; // stays set, allocations after thread exit cleanup aren't counted
+    static thread_local ThreadCounterRegistration registration;
+  }
+  // only this thread writes it, a plain load and store avoids a locked read-modify-write:
+  threadCounter.count.store(threadCounter.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+}
+
+uint64_t allocationCount()
+{
+  std::lock_guard<std::mutex> lock(countersMutex);
+  uint64_t count = exitedCount;
+  for(const ThreadCounter* counter = counters; counter; counter = counter->next)
+    count += counter->count.load(std::memory_order_relaxed);
+  return count;
+}
+
+// Replaces the global operator new/delete, all other variants (array, nothrow) use these:
+
+void* operator new(std::size_t size)
+{
+  countAllocation();
+
+  if(size == 0)
+    size = 1;
+
+  for(;;)
+  {
+    if(void* ptr = std::malloc(size))
+      return ptr;
+
+    auto handler = std::get_new_handler();
+    if(!handler)
+      throw std::bad_alloc();
+    handler();
+  }
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept
+{
+  std::free(ptr);
+}
@@ -0,0 +1,33 @@
+/**
+ * server/src/utils/allocationcounter.hpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TRAINTASTIC_SERVER_UTILS_ALLOCATIONCOUNTER_HPP
+#define TRAINTASTIC_SERVER_UTILS_ALLOCATIONCOUNTER_HPP
+
+#include <cstdint>
+
+/**
+ * \brief Number of heap allocations (\c operator \c new calls) since start, all threads
+ */
+uint64_t allocationCount();
+
+#endif
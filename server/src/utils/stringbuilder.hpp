@@ -0,0 +1,125 @@
+/**
+ * server/src/utils/stringbuilder.hpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TRAINTASTIC_SERVER_UTILS_STRINGBUILDER_HPP
+#define TRAINTASTIC_SERVER_UTILS_STRINGBUILDER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @brief Build text messages in a fixed size buffer, without heap allocations
+ *
+ * Text that doesn't fit is truncated, in debug builds it asserts.
+ */
+template<size_t Capacity>
+class StringBuilder
+{
+  private:
+    std::array<char, Capacity> m_buffer;
+    size_t m_size = 0;
+
+  public:
+    StringBuilder() = default;
+
+    StringBuilder(std::string_view s)
+    {
+      append(s);
+    }
+
+    constexpr bool empty() const
+    {
+      return m_size == 0;
+    }
+
+    constexpr size_t size() const
+    {
+      return m_size;
+    }
+
+    constexpr std::string_view view() const
+    {
+      return {m_buffer.data(), m_size};
+    }
+
+    constexpr operator std::string_view() const
+    {
+      return view();
+    }
+
+    constexpr void clear()
+    {
+      m_size = 0;
+    }
+
+    StringBuilder& append(std::string_view s)
+    {
+      assert(m_size + s.size() <= Capacity);
+      const size_t n = std::min(s.size(), Capacity - m_size);
+      std::memcpy(m_buffer.data() + m_size, s.data(), n);
+      m_size += n;
+      return *this;
+    }
+
+    StringBuilder& append(const char* s)
+    {
+      return append(std::string_view{s});
+    }
+
+    StringBuilder& append(char c)
+    {
+      assert(m_size < Capacity);
+      if(m_size < Capacity)
+        m_buffer[m_size++] = c;
+      return *this;
+    }
+
+    template<class T>
+    std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>, StringBuilder&> append(T value, int base = 10)
+    {
+      auto r = std::to_chars(m_buffer.data() + m_size, m_buffer.data() + Capacity, value, base);
+      assert(r.ec == std::errc());
+      if(r.ec == std::errc())
+        m_size = r.ptr - m_buffer.data();
+      return *this;
+    }
+
+    /**
+     * @brief Append value as upper case hexadecimal number with a fixed number of digits
+     */
+    template<class T>
+    std::enable_if_t<std::is_integral_v<T>, StringBuilder&> appendHex(T value, size_t digits = sizeof(T) * 2)
+    {
+      static constexpr std::string_view hexDigits = "0123456789ABCDEF";
+      assert(digits <= sizeof(T) * 2);
+      for(size_t i = digits; i > 0; i--)
+        append(hexDigits[(static_cast<std::make_unsigned_t<T>>(value) >> ((i - 1) * 4)) & 0xF]);
+      return *this;
+    }
+};
+
+#endif
@@ -0,0 +1,156 @@
+/**
+ * server/src/utils/tokenizer.hpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TRAINTASTIC_SERVER_UTILS_TOKENIZER_HPP
+#define TRAINTASTIC_SERVER_UTILS_TOKENIZER_HPP
+
+#include <string_view>
+
+/**
+ * @brief Allocation free tokenizer for text based protocols
+ *
+ * Splits the text at the delimiter, spaces and carriage returns around a token
+ * are stripped and empty tokens are skipped. If \c groupBrackets is set text
+ * inside square brackets or double quotes is never split.
+ */
+class Tokenizer
+{
+  private:
+    std::string_view m_text;
+    char m_delimiter;
+    bool m_groupBrackets;
+
+    static constexpr bool isSpace(char c)
+    {
+      return c == ' ' || c == '\r';
+    }
+
+    static constexpr std::string_view trim(std::string_view s)
+    {
+      while(!s.empty() && isSpace(s.front()))
+        s.remove_prefix(1);
+      while(!s.empty() && isSpace(s.back()))
+        s.remove_suffix(1);
+      return s;
+    }
+
+    constexpr size_t find() const
+    {
+      if(!m_groupBrackets)
+        return m_text.find(m_delimiter);
+
+      size_t depth = 0;
+      bool quoted = false;
+      for(size_t i = 0; i < m_text.size(); i++)
+      {
+        const char c = m_text[i];
+        if(c == '"')
+          quoted = !quoted;
+        else if(quoted)
+          continue;
+        else if(c == '[')
+          depth++;
+        else if(c == ']' && depth != 0)
+          depth--;
+        else if(c == m_delimiter && depth == 0)
+          return i;
+      }
+      return std::string_view::npos;
+    }
+
+  public:
+    class Iterator
+    {
+      private:
+        Tokenizer* m_tokenizer;
+        std::string_view m_token;
+
+      public:
+        constexpr Iterator(Tokenizer* tokenizer)
+          : m_tokenizer{tokenizer}
+        {
+          ++*this;
+        }
+
+        constexpr std::string_view operator *() const
+        {
+          return m_token;
+        }
+
+        constexpr Iterator& operator ++()
+        {
+          if(m_tokenizer && !m_tokenizer->next(m_token))
+            m_tokenizer = nullptr;
+          return *this;
+        }
+
+        constexpr bool operator ==(const Iterator& other) const
+        {
+          return m_tokenizer == other.m_tokenizer;
+        }
+    };
+
+    constexpr Tokenizer(std::string_view text, char delimiter, bool groupBrackets = false)
+      : m_text{text}
+      , m_delimiter{delimiter}
+      , m_groupBrackets{groupBrackets}
+    {
+    }
+
+    /**
+     * @brief Get the next token
+     * @param[out] token The token, refers to the tokenized text
+     * @return \c true if a token is available, \c false if the end is reached
+     */
+    constexpr bool next(std::string_view& token)
+    {
+      while(!m_text.empty())
+      {
+        const size_t pos = find();
+        token = trim(m_text.substr(0, pos));
+        m_text.remove_prefix(pos != std::string_view::npos ? pos + 1 : m_text.size());
+        if(!token.empty())
+          return true;
+      }
+      return false;
+    }
+
+    /**
+     * @brief Text that isn't tokenized yet
+     */
+    constexpr std::string_view remaining() const
+    {
+      return trim(m_text);
+    }
+
+    constexpr Iterator begin()
+    {
+      return Iterator(this);
+    }
+
+    constexpr Iterator end()
+    {
+      return Iterator(nullptr);
+    }
+};
+
+#endif
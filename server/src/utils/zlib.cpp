@@ -21,6 +21,7 @@
  */
 
 #include "zlib.hpp"
+#include <algorithm>
 #include <zlib.h>
 
 namespace ZLib {
@@ -28,7 +29,16 @@ namespace ZLib {
 bool compressString(std::string_view src, std::vector<std::byte>& out)
 {
   uLongf destLen = out.size();
-  const int r = compress(reinterpret_cast<Bytef*>(out.data()), &destLen, reinterpret_cast<const Bytef*>(src.data()), src.size());
+  const int r = ::compress(reinterpret_cast<Bytef*>(out.data()), &destLen, reinterpret_cast<const Bytef*>(src.data()), src.size());
+  out.resize(destLen);
+  return r == Z_OK;
+}
+
+bool compress(const void* src, size_t srcSize, std::vector<std::byte>& out)
+{
+  out.resize(compressBound(srcSize));
+  uLongf destLen = out.size();
+  const int r = ::compress(reinterpret_cast<Bytef*>(out.data()), &destLen, reinterpret_cast<const Bytef*>(src), srcSize);
   out.resize(destLen);
   return r == Z_OK;
 }
@@ -44,4 +54,54 @@ bool toString(const void* src, size_t srcSize, size_t dstSize, std::string& out)
   return r == Z_OK;
 }
 
+Stream::Stream()
+  : m_stream{std::make_unique<z_stream>()}
+{
+  m_error = inflateInit(m_stream.get()) != Z_OK;
+}
+
+Stream::~Stream()
+{
+  inflateEnd(m_stream.get());
+}
+
+bool Stream::write(const void* src, size_t srcSize, std::string& out)
+{
+  if(m_error)
+    return false;
+  if(m_end)
+    return srcSize == 0;
+
+  m_stream->next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(src));
+  m_stream->avail_in = static_cast<uInt>(srcSize);
+
+  // also continue if the output buffer is full, zlib may hold more output
+  do
+  {
+    const size_t offset = out.size();
+    out.resize(offset + std::max<size_t>(4 * srcSize, 256));
+    m_stream->next_out = reinterpret_cast<Bytef*>(out.data() + offset);
+    m_stream->avail_out = static_cast<uInt>(out.size() - offset);
+
+    const int r = inflate(m_stream.get(), Z_NO_FLUSH);
+    out.resize(out.size() - m_stream->avail_out);
+
+    if(r == Z_STREAM_END)
+    {
+      m_end = true;
+      break;
+    }
+    if(r == Z_BUF_ERROR && m_stream->avail_out != 0)
+      break; // needs more input
+    if(r != Z_OK && r != Z_BUF_ERROR)
+    {
+      m_error = true;
+      return false;
+    }
+  }
+  while(m_stream->avail_in != 0 || m_stream->avail_out == 0);
+
+  return true;
+}
+
 }}
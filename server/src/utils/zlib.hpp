@@ -24,18 +24,59 @@
 #define TRAINTASTIC_SERVER_UTILS_ZLIB_HPP
 
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
 
+struct z_stream_s;
+
 namespace ZLib {
 
 bool compressString(std::string_view src, std::vector<std::byte>& out);
 
+//! Compress \a src, \a out is resized to the compressed size
+bool compress(const void* src, size_t srcSize, std::vector<std::byte>& out);
+
 namespace Uncompress {
 
 bool toString(const void* src, size_t srcSize, size_t dstSize, std::string& out);
 
+/**
+ * @brief Streaming zlib decompression
+ *
+ * Compressed data can be passed in chunks as it arrives, the decompressed data
+ * is appended to the output.
+ */
+class Stream
+{
+  private:
+    std::unique_ptr<z_stream_s> m_stream;
+    bool m_end = false;
+    bool m_error = false;
+
+  public:
+    Stream();
+    Stream(const Stream&) = delete;
+    Stream& operator =(const Stream&) = delete;
+    ~Stream();
+
+    /**
+     * @brief Decompress a chunk of data
+     * @param[in] src Compressed data
+     * @param[in] srcSize Size of the compressed data
+     * @param[in,out] out Decompressed data is appended to it
+     * @return \c true on success, \c false if the data is invalid
+     */
+    bool write(const void* src, size_t srcSize, std::string& out);
+
+    //! \c true if the end of the compressed stream is reached
+    bool end() const
+    {
+      return m_end;
+    }
+};
+
 }}
 
 #endif
@@ -21,12 +21,47 @@
  */
 
 #include "ctwreader.hpp"
+#include <array>
+#include <istream>
+#include <streambuf>
 #include <archive.h>
 #include <archive_entry.h>
 #include "libarchiveerror.hpp"
+#include "../traintastic/startupprofiler.hpp"
 
 using nlohmann::json;
 
+namespace {
+
+//! \brief Stream buffer for reading the current archive entry
+class ArchiveEntryBuffer : public std::streambuf
+{
+  private:
+    archive* m_archive;
+    std::array<char, 64 * 1024> m_buffer;
+
+  protected:
+    int_type underflow() final
+    {
+      StartupProfiler::Scope scope(StartupProfiler::Phase::ArchiveRead);
+      const auto count = archive_read_data(m_archive, m_buffer.data(), m_buffer.size());
+      if(count < 0)
+        throw LibArchiveError(m_archive);
+      if(count == 0)
+        return traits_type::eof();
+      setg(m_buffer.data(), m_buffer.data(), m_buffer.data() + count);
+      return traits_type::to_int_type(m_buffer[0]);
+    }
+
+  public:
+    explicit ArchiveEntryBuffer(archive* a)
+      : m_archive{a}
+    {
+    }
+};
+
+}
+
 CTWReader::CTWReader() :
   m_archive{archive_read_new(),
     [](archive* a)
@@ -37,6 +72,8 @@ CTWReader::CTWReader() :
 {
   if(archive_read_support_filter_xz(m_archive.get()) != ARCHIVE_OK)
     throw LibArchiveError(m_archive.get());
+  if(archive_read_support_filter_zstd(m_archive.get()) < ARCHIVE_WARN) // warns if an external program is used
+    throw LibArchiveError(m_archive.get());
   if(archive_read_support_format_tar(m_archive.get()) != ARCHIVE_OK)
     throw LibArchiveError(m_archive.get());
 }
@@ -44,10 +81,8 @@ CTWReader::CTWReader() :
 CTWReader::CTWReader(const std::filesystem::path& filename)
   : CTWReader()
 {
-  if(archive_read_open_filename(m_archive.get(), filename.string().c_str(), 10240) != ARCHIVE_OK)
+  if(archive_read_open_filename(m_archive.get(), filename.string().c_str(), 64 * 1024) != ARCHIVE_OK)
     throw LibArchiveError(m_archive.get());
-
-  readFiles();
 }
 
 CTWReader::CTWReader(const std::vector<std::byte>& memory)
@@ -55,60 +90,93 @@ CTWReader::CTWReader(const std::vector<std::byte>& memory)
 {
   if(archive_read_open_memory(m_archive.get(), memory.data(), memory.size()) != ARCHIVE_OK)
     throw LibArchiveError(m_archive.get());
+}
+
+bool CTWReader::readFile(const std::filesystem::path& filename, nlohmann::json& data)
+{
+  const auto name = filename.generic_string();
+
+  if(auto it = m_files.find(name); it != m_files.end())
+  {
+    StartupProfiler::Scope scope(StartupProfiler::Phase::JSONParse);
+    data = json::parse(it->second);
+    m_files.erase(it);
+    return true;
+  }
+
+  if(!nextFile(name))
+    return false;
+
+  // parse directly from the archive, without an in memory copy:
+  StartupProfiler::Scope scope(StartupProfiler::Phase::JSONParse);
+  ArchiveEntryBuffer buffer(m_archive.get());
+  std::istream stream(&buffer);
+  data = json::parse(stream);
+  return true;
+}
 
-  readFiles();
+bool CTWReader::readFile(const std::filesystem::path& filename, std::string& text)
+{
+  const auto name = filename.generic_string();
+
+  if(auto it = m_files.find(name); it != m_files.end())
+  {
+    text = std::move(it->second);
+    m_files.erase(it);
+    return true;
+  }
+
+  if(!nextFile(name))
+    return false;
+
+  return readData(text, m_entrySize);
 }
 
-void CTWReader::readFiles()
+bool CTWReader::nextFile(const std::string& filename)
 {
-  // load everything in memory:
+  StartupProfiler::Scope scope(StartupProfiler::Phase::ArchiveRead);
   archive_entry* entry = nullptr;
-  while(true)
+  while(!m_eof)
   {
     const int r = archive_read_next_header(m_archive.get(), &entry);
     if(r == ARCHIVE_EOF)
+    {
+      m_eof = true;
       break;
+    }
     if(r < ARCHIVE_OK)
       throw LibArchiveError(m_archive.get());
 
-    std::vector<std::byte> data;
-    data.resize(archive_entry_size(entry));
+    const char* pathname = archive_entry_pathname(entry);
+    if(!pathname)
+      continue;
 
-    size_t pos = 0;
-    while(pos < data.size())
-    {
-      const auto count = archive_read_data(m_archive.get(), data.data() + pos, data.size() - pos);
-      if(count < 0)
-        throw LibArchiveError(m_archive.get());
-      if(count == 0)
-        break; // should not happen
-      pos += static_cast<size_t>(count);
-    }
+    m_entrySize = static_cast<size_t>(archive_entry_size(entry));
+    if(filename == pathname)
+      return true;
 
-    if(pos == data.size())
-      m_files.emplace(archive_entry_pathname(entry), std::move(data));
+    // keep it for a later request:
+    if(std::string data; readData(data, m_entrySize))
+      m_files.emplace(pathname, std::move(data));
   }
-
-  m_archive.reset();
+  return false;
 }
 
-bool CTWReader::readFile(const std::filesystem::path& filename, nlohmann::json& data)
+bool CTWReader::readData(std::string& text, size_t size)
 {
-  auto it = m_files.find(filename.string());
-  if(it == m_files.end())
-    return false;
+  StartupProfiler::Scope scope(StartupProfiler::Phase::ArchiveRead);
+  text.resize(size);
 
-  std::string_view sv{reinterpret_cast<const char*>(it->second.data()), it->second.size()};
-  data = json::parse(sv.begin(), sv.end());
-  return true;
-}
-
-bool CTWReader::readFile(const std::filesystem::path& filename, std::string& text)
-{
-  auto it = m_files.find(filename.generic_string());
-  if(it == m_files.end())
-    return false;
+  size_t pos = 0;
+  while(pos < size)
+  {
+    const auto count = archive_read_data(m_archive.get(), text.data() + pos, size - pos);
+    if(count < 0)
+      throw LibArchiveError(m_archive.get());
+    if(count == 0)
+      break; // should not happen
+    pos += static_cast<size_t>(count);
+  }
 
-  text.assign(reinterpret_cast<const char*>(it->second.data()), it->second.size());
-  return true;
+  return pos == size;
 }
@@ -23,29 +23,53 @@
 #ifndef TRAINTASTIC_SERVER_WORLD_CTWREADER_HPP
 #define TRAINTASTIC_SERVER_WORLD_CTWREADER_HPP
 
+#include <memory>
+#include <string>
 #include <unordered_map>
-#include <vector>
-#include <cstddef>
 #include <traintastic/utils/stdfilesystem.hpp>
 #include <nlohmann/json.hpp>
 
 struct archive;
 
+/**
+ * \brief Read files from a Traintastic world (.ctw) archive
+ *
+ * A .ctw file is a tar archive, uncompressed, xz or zstd compressed.
+ * The archive is read sequentially, entries are only read when requested:
+ * the requested entry is handed to the parser straight from the archive,
+ * entries passed while searching are kept in memory for a later request.
+ * Therefore files are best read in the order they are written.
+ */
 class CTWReader
 {
   private:
     std::unique_ptr<archive, void(*)(archive*)> m_archive;
-    std::unordered_map<std::string, std::vector<std::byte>> m_files;
+    std::unordered_map<std::string, std::string> m_files; //!< entries passed while searching
+    size_t m_entrySize = 0; //!< size of the current entry
+    bool m_eof = false;
 
     CTWReader();
-    void readFiles();
+    bool nextFile(const std::string& filename);
+    bool readData(std::string& text, size_t size);
 
   public:
     CTWReader(const std::filesystem::path& filename);
+    //! \note \a memory must stay valid for the lifetime of the reader
     CTWReader(const std::vector<std::byte>& memory);
 
+    /**
+     * \brief Read and parse a JSON file
+     *
+     * Each file can only be read once.
+     */
     bool readFile(const std::filesystem::path& filename, nlohmann::json& data);
+
+    /**
+     * \brief Read a file
+     *
+     * Each file can only be read once.
+     */
     bool readFile(const std::filesystem::path& filename, std::string& text);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -45,7 +45,7 @@ static int memoryCloseCallback(archive* /*unused*/, void* /*clientData*/)
 }
 
 
-CTWWriter::CTWWriter()
+CTWWriter::CTWWriter(WorldCompression compression)
   : m_archive{archive_write_new(),
     [](archive* a)
     {
@@ -53,21 +53,34 @@ CTWWriter::CTWWriter()
       archive_write_free(a);
     }}
 {
-  if(archive_write_add_filter_xz(m_archive.get()) != ARCHIVE_OK)
-    throw LibArchiveError(m_archive.get());
+  switch(compression)
+  {
+    case WorldCompression::None:
+      break;
+
+    case WorldCompression::XZ:
+      if(archive_write_add_filter_xz(m_archive.get()) != ARCHIVE_OK)
+        throw LibArchiveError(m_archive.get());
+      break;
+
+    case WorldCompression::Zstd:
+      if(archive_write_add_filter_zstd(m_archive.get()) != ARCHIVE_OK)
+        throw LibArchiveError(m_archive.get());
+      break;
+  }
   if(archive_write_set_format_pax_restricted(m_archive.get()) != ARCHIVE_OK)
     throw LibArchiveError(m_archive.get());
 }
 
-CTWWriter::CTWWriter(const std::filesystem::path& filename)
-  : CTWWriter()
+CTWWriter::CTWWriter(const std::filesystem::path& filename, WorldCompression compression)
+  : CTWWriter(compression)
 {
   if(archive_write_open_filename(m_archive.get(), filename.string().c_str()) != ARCHIVE_OK)
     throw LibArchiveError(m_archive.get());
 }
 
-CTWWriter::CTWWriter(std::vector<std::byte>& memory)
-  : CTWWriter()
+CTWWriter::CTWWriter(std::vector<std::byte>& memory, WorldCompression compression)
+  : CTWWriter(compression)
 {
   assert(memory.empty());
   if(archive_write_set_bytes_per_block(m_archive.get(), 0) != ARCHIVE_OK)
@@ -27,6 +27,7 @@
 #include <vector>
 #include <traintastic/utils/stdfilesystem.hpp>
 #include <nlohmann/json.hpp>
+#include <traintastic/enum/worldcompression.hpp>
 
 struct archive;
 
@@ -35,11 +36,11 @@ class CTWWriter
   private:
     std::unique_ptr<archive, void(*)(archive*)> m_archive;
 
-    CTWWriter();
+    CTWWriter(WorldCompression compression);
 
   public:
-    CTWWriter(const std::filesystem::path& filename);
-    CTWWriter(std::vector<std::byte>& memory);
+    CTWWriter(const std::filesystem::path& filename, WorldCompression compression = WorldCompression::XZ);
+    CTWWriter(std::vector<std::byte>& memory, WorldCompression compression = WorldCompression::XZ);
 
     void writeFile(const std::filesystem::path& filename, const nlohmann::json& data);
     void writeFile(const std::filesystem::path& filename, const std::string& text);
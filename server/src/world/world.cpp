@@ -28,6 +28,7 @@
 #include <boost/uuid/uuid_io.hpp>
 
 #include "worldsaver.hpp"
+#include "worldjournal.hpp"
 
 #include "../log/log.hpp"
 #include "../log/logmessageexception.hpp"
@@ -40,6 +41,7 @@
 #include "../core/objectvectorproperty.tpp"
 #include "../core/objectlisttablemodel.hpp"
 #include "../core/attributes.hpp"
+#include "../core/eventloop.hpp"
 #include "../core/abstractvectorproperty.hpp"
 #include "../core/controllerlist.hpp"
 
@@ -271,48 +273,99 @@ World::World(Private /*unused*/) :
     {
       try
       {
-        // backup world:
         const std::filesystem::path worldDir = Traintastic::instance->worldDir();
         const std::filesystem::path worldBackupDir = Traintastic::instance->worldBackupDir();
-
-        if(!std::filesystem::is_directory(worldBackupDir))
-        {
-          std::error_code ec;
-          std::filesystem::create_directories(worldBackupDir, ec);
-          if(ec)
-            Log::log(*this, LogMessage::C1007_CREATING_WORLD_BACKUP_DIRECTORY_FAILED_X, ec);
-        }
-
-        if(std::filesystem::is_directory(worldDir / uuid.value()))
-        {
-          std::error_code ec;
-          std::filesystem::rename(worldDir / uuid.value(), worldBackupDir / uuid.value() += dateTimeStr(), ec);
-          if(ec)
-            Log::log(*this, LogMessage::C1006_CREATING_WORLD_BACKUP_FAILED_X, ec);
-        }
-
-        if(std::filesystem::is_regular_file(worldDir / uuid.value() += dotCTW))
-        {
-          std::error_code ec;
-          std::filesystem::rename(worldDir / uuid.value() += dotCTW, worldBackupDir / uuid.value() += dateTimeStr() += dotCTW, ec);
-          if(ec)
-            Log::log(*this, LogMessage::C1006_CREATING_WORLD_BACKUP_FAILED_X, ec);
-        }
-
-        // save world:
-        std::filesystem::path savePath = worldDir / uuid.value();
-        if(!Traintastic::instance->settings->saveWorldUncompressed)
-          savePath += dotCTW;
-
-        WorldSaver saver(*this, savePath);
-
-        if(Traintastic::instance)
-        {
-          Traintastic::instance->settings->lastWorld = uuid.value();
-          Traintastic::instance->worldList->update(*this, savePath);
-        }
-
-        Log::log(*this, LogMessage::N1022_SAVED_WORLD_X, name.value());
+        const bool compressed = !Traintastic::instance->settings->saveWorldUncompressed;
+        const auto format = Traintastic::instance->settings->saveWorldBinary ? WorldSaver::Format::Binary : WorldSaver::Format::JSON;
+        const WorldCompression compression = Traintastic::instance->settings->saveWorldCompression;
+
+        // only the snapshot is taken in the event loop, encoding, compressing and writing is done in the background:
+        auto saver = std::make_shared<WorldSaver>(*this);
+        const uint64_t journalSequence = this->journalSequence(); // included in snapshot
+
+        // wait for previous save, only blocks if a save is requested while saving:
+        if(m_saveThread.joinable())
+          m_saveThread.join();
+
+        fireEvent(onSaveProgress, static_cast<uint8_t>(0));
+
+        m_saveThread = std::thread(
+          [saver, journalSequence, worldDir, worldBackupDir, basename=uuid.value(), backupSuffix=dateTimeStr(), compressed, format, compression, weak=weak_from_this()]()
+          {
+            // report to world in the event loop, if it still exists:
+            auto post =
+              [weak](std::function<void(World&)> func)
+              {
+                EventLoop::call(
+                  [weak, func=std::move(func)]()
+                  {
+                    if(auto object = weak.lock())
+                      func(static_cast<World&>(*object));
+                  });
+              };
+
+            const std::filesystem::path directory = worldDir / basename;
+            const std::filesystem::path ctw = std::filesystem::path(directory) += dotCTW;
+            const std::filesystem::path directoryBackup = worldBackupDir / (basename + backupSuffix);
+            const std::filesystem::path ctwBackup = std::filesystem::path(directoryBackup) += dotCTW;
+
+            auto backup =
+              [&post](const std::filesystem::path& from, const std::filesystem::path& to, bool copy)
+              {
+                std::error_code ec;
+                if(copy) // keep the world in place until it is replaced
+                  std::filesystem::copy(from, to, std::filesystem::copy_options::recursive, ec);
+                else
+                  std::filesystem::rename(from, to, ec);
+                if(ec)
+                  post([ec](World& world) { Log::log(world, LogMessage::C1006_CREATING_WORLD_BACKUP_FAILED_X, ec); });
+              };
+
+            try
+            {
+              const auto& savePath = compressed ? ctw : directory;
+              const auto& otherPath = compressed ? directory : ctw;
+              const auto& otherBackup = compressed ? directoryBackup : ctwBackup;
+
+              // save world, the existing world isn't touched until the new one is written:
+              const auto tmpPath = saver->writeTemporary(savePath, format, compression,
+                [&post](uint8_t percent)
+                {
+                  post([percent](World& world) { world.fireEvent(world.onSaveProgress, percent); });
+                });
+
+              // backup world:
+              std::error_code ec;
+              if(!std::filesystem::is_directory(worldBackupDir, ec))
+              {
+                std::filesystem::create_directories(worldBackupDir, ec);
+                if(ec)
+                  post([ec](World& world) { Log::log(world, LogMessage::C1007_CREATING_WORLD_BACKUP_DIRECTORY_FAILED_X, ec); });
+              }
+              if(std::filesystem::exists(savePath, ec))
+                backup(savePath, compressed ? ctwBackup : directoryBackup, true);
+
+              WorldSaver::replace(tmpPath, savePath);
+
+              // a world saved the other way (compressed vs. uncompressed) is moved out of the way:
+              if(std::filesystem::exists(otherPath, ec))
+                backup(otherPath, otherBackup, false);
+
+              post([savePath, journalSequence](World& world)
+                {
+                  world.fireEvent(world.onSaveProgress, static_cast<uint8_t>(100));
+                  world.saveCompleted(true, savePath, journalSequence);
+                });
+            }
+            catch(const std::exception& e)
+            {
+              post([what=std::string(e.what())](World& world)
+                {
+                  Log::log(world, LogMessage::C1005_SAVING_WORLD_FAILED_X, what);
+                  world.saveCompleted(false, {}, 0);
+                });
+            }
+          });
       }
       catch(const std::exception& e)
       {
@@ -332,6 +385,8 @@ World::World(Private /*unused*/) :
         return {};
       }}
   , onEvent{*this, "on_event", EventFlags::Scriptable}
+  , onSaveProgress{*this, "on_save_progress", EventFlags::Public}
+  , onSaveCompleted{*this, "on_save_completed", EventFlags::Public}
 {
   Attributes::addDisplayName(uuid, DisplayName::World::uuid);
   m_interfaceItems.add(uuid);
@@ -464,6 +519,11 @@ World::World(Private /*unused*/) :
 
 World::~World()
 {
+  if(m_saveThread.joinable())
+    m_saveThread.join(); // don't lose a save that is still being written
+
+  m_journal.reset(); // writes pending changes, destroying the objects isn't a state change
+
   luaScripts->stopAll(); // no surprise event actions during destruction
 
   deleteAll(*interfaces);
@@ -553,6 +613,38 @@ void World::export_(std::vector<std::byte>& data)
   }
 }
 
+void World::stateChanged(Object& object)
+{
+  if(m_journal)
+    m_journal->changed(object);
+}
+
+uint64_t World::journalSequence() const
+{
+  return m_journal ? m_journal->sequence() : 0;
+}
+
+void World::saveCompleted(bool success, const std::filesystem::path& savePath, uint64_t journalSequence)
+{
+  if(success)
+  {
+    if(m_journal)
+      m_journal->saved(journalSequence);
+    else // first save, start journaling
+      m_journal = std::make_unique<WorldJournal>(*this, WorldJournal::path(savePath), journalSequence);
+
+    if(Traintastic::instance)
+    {
+      Traintastic::instance->settings->lastWorld = uuid.value();
+      Traintastic::instance->worldList->update(*this, savePath);
+    }
+
+    Log::log(*this, LogMessage::N1022_SAVED_WORLD_X, name.value());
+  }
+
+  fireEvent(onSaveCompleted, success);
+}
+
 void World::loaded()
 {
   updateScaleRatio();
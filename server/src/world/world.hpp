@@ -30,7 +30,9 @@
 #include "../core/method.hpp"
 #include "../core/event.hpp"
 #include <unordered_map>
+#include <thread>
 #include <boost/uuid/uuid.hpp>
+#include <traintastic/utils/stdfilesystem.hpp>
 #include <traintastic/enum/externaloutputchangeaction.hpp>
 #include <traintastic/enum/worldevent.hpp>
 #include "../enum/worldscale.hpp"
@@ -38,6 +40,7 @@
 #include <traintastic/set/worldstate.hpp>
 
 class WorldLoader;
+class WorldJournal;
 class LNCVProgrammer;
 class DecoderController;
 class InputController;
@@ -78,8 +81,13 @@ class World : public Object
   private:
     struct Private {};
 
+    std::thread m_saveThread; //!< encodes, compresses and writes the world snapshot
+    std::unique_ptr<WorldJournal> m_journal; //!< runtime state changes since the last save, created after the world is loaded or saved
+
     void updateEnabled();
     void updateScaleRatio();
+    uint64_t journalSequence() const;
+    void saveCompleted(bool success, const std::filesystem::path& savePath, uint64_t journalSequence);
 
   protected:
     static void init(World& world);
@@ -97,6 +105,8 @@ class World : public Object
     static constexpr std::string_view dotCTW = ".ctw";
     static constexpr std::string_view filename = "traintastic.json";
     static constexpr std::string_view filenameState = "traintastic.state.json";
+    static constexpr std::string_view filenameBinary = "traintastic.bin";
+    static constexpr std::string_view filenameStateBinary = "traintastic.state.bin";
 
     static std::shared_ptr<World> create();
 
@@ -162,12 +172,16 @@ class World : public Object
     Method<std::shared_ptr<LNCVProgrammer>(const ObjectPtr&)> getLNCVProgrammer;
 
     Event<WorldState, WorldEvent> onEvent;
+    Event<uint8_t> onSaveProgress; //!< save progress in percent, saving is done in the background
+    Event<bool> onSaveCompleted; //!< \c true if saved successfully
 
     World(Private);
     ~World() override;
 
     std::string getObjectId() const final { return std::string(classId); }
 
+    void stateChanged(Object& object) final;
+
     std::string getUniqueId(std::string_view prefix) const;
     bool isObject(const std::string&_id) const;
     ObjectPtr getObjectById(const std::string& _id) const;
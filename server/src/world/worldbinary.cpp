@@ -0,0 +1,208 @@
+/**
+ * server/src/world/worldbinary.cpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "worldbinary.hpp"
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include "../traintastic/startupprofiler.hpp"
+
+using nlohmann::json;
+
+namespace WorldBinary {
+
+static void writeUInt32(std::string& out, uint32_t value)
+{
+  for(int i = 0; i < 4; i++)
+  {
+    out.push_back(static_cast<char>(value & 0xFF));
+    value >>= 8;
+  }
+}
+
+static uint32_t readUInt32(std::string_view data, size_t& pos)
+{
+  if(data.size() - pos < 4)
+    throw std::runtime_error("binary world data truncated");
+  uint32_t value = 0;
+  for(int i = 3; i >= 0; i--)
+    value = (value << 8) | static_cast<uint8_t>(data[pos + static_cast<size_t>(i)]);
+  pos += 4;
+  return value;
+}
+
+static std::string_view readBytes(std::string_view data, size_t& pos, size_t size)
+{
+  if(data.size() - pos < size)
+    throw std::runtime_error("binary world data truncated");
+  const auto bytes = data.substr(pos, size);
+  pos += size;
+  return bytes;
+}
+
+bool isBinary(std::string_view data)
+{
+  return data.substr(0, magic.size()) == magic;
+}
+
+std::string write(const json& document)
+{
+  static const json emptyArray = json::array();
+  const auto it = document.find("objects");
+  const json& objects = (it != document.end()) ? *it : emptyArray;
+
+  std::vector<std::uint8_t> header;
+  {
+    // shallow, the objects array isn't part of the header:
+    json headerDocument = json::object();
+    for(auto item = document.begin(); item != document.end(); ++item)
+      if(item.key() != "objects")
+        headerDocument[item.key()] = item.value();
+    header = json::to_cbor(headerDocument);
+  }
+
+  std::vector<std::vector<std::uint8_t>> blobs;
+  blobs.reserve(objects.size());
+  size_t size = magic.size() + 3 * sizeof(uint32_t) + header.size();
+  for(const auto& object : objects)
+  {
+    blobs.emplace_back(json::to_cbor(object));
+    size += 2 * sizeof(uint32_t) + object["id"].get_ref<const std::string&>().size() + blobs.back().size();
+  }
+
+  std::string out;
+  out.reserve(size);
+  out.append(magic);
+  writeUInt32(out, version);
+  writeUInt32(out, static_cast<uint32_t>(objects.size()));
+  writeUInt32(out, static_cast<uint32_t>(header.size()));
+  for(size_t i = 0; i < blobs.size(); i++)
+  {
+    const auto& id = objects[i]["id"].get_ref<const std::string&>();
+    writeUInt32(out, static_cast<uint32_t>(id.size()));
+    out.append(id);
+    writeUInt32(out, static_cast<uint32_t>(blobs[i].size()));
+  }
+  out.append(reinterpret_cast<const char*>(header.data()), header.size());
+  for(const auto& blob : blobs)
+    out.append(reinterpret_cast<const char*>(blob.data()), blob.size());
+
+  return out;
+}
+
+Reader::Reader(std::string data)
+  : m_data{std::move(data)}
+{
+  StartupProfiler::Scope scope(StartupProfiler::Phase::JSONParse);
+
+  const std::string_view view{m_data};
+  size_t pos = 0;
+
+  if(!isBinary(view))
+    throw std::runtime_error("not a binary world");
+  pos += magic.size();
+
+  if(readUInt32(view, pos) != version)
+    throw std::runtime_error("unsupported binary world version");
+
+  const uint32_t count = readUInt32(view, pos);
+  const uint32_t headerSize = readUInt32(view, pos);
+
+  if(count > (view.size() - pos) / 8) // each index entry has an id length and a size
+    throw std::runtime_error("binary world data truncated");
+
+  std::vector<uint32_t> sizes;
+  sizes.reserve(count);
+  m_objects.reserve(count);
+  for(uint32_t i = 0; i < count; i++)
+  {
+    const auto idLength = readUInt32(view, pos);
+    m_objects.push_back({readBytes(view, pos, idLength), {}});
+    sizes.push_back(readUInt32(view, pos));
+  }
+
+  const auto header = readBytes(view, pos, headerSize);
+  m_header = json::from_cbor(header.begin(), header.end());
+
+  for(uint32_t i = 0; i < count; i++)
+    m_objects[i].data = readBytes(view, pos, sizes[i]);
+}
+
+json Reader::parse(const Object& object)
+{
+  return json::from_cbor(object.data.begin(), object.data.end());
+}
+
+std::vector<json> Reader::parseObjects() const
+{
+  StartupProfiler::Scope scope(StartupProfiler::Phase::JSONParse);
+
+  std::vector<json> objects(m_objects.size());
+
+  auto parseRange =
+    [this, &objects](size_t first, size_t last)
+    {
+      for(size_t i = first; i < last; i++)
+        objects[i] = parse(m_objects[i]);
+    };
+
+  const size_t threadCount = std::min<size_t>(std::max(1U, std::thread::hardware_concurrency()), m_objects.size() / parseObjectsPerThreadMin);
+  if(threadCount <= 1)
+  {
+    parseRange(0, objects.size());
+    return objects;
+  }
+
+  const size_t chunkSize = (objects.size() + threadCount - 1) / threadCount;
+  std::vector<std::exception_ptr> errors(threadCount);
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount - 1);
+
+  auto parseChunk =
+    [&parseRange, &errors, &objects, chunkSize](size_t chunk)
+    {
+      try
+      {
+        parseRange(chunk * chunkSize, std::min(objects.size(), (chunk + 1) * chunkSize));
+      }
+      catch(...)
+      {
+        errors[chunk] = std::current_exception();
+      }
+    };
+
+  for(size_t chunk = 1; chunk < threadCount; chunk++)
+    threads.emplace_back(parseChunk, chunk);
+  parseChunk(0);
+
+  for(auto& thread : threads)
+    thread.join();
+
+  for(const auto& error : errors)
+    if(error)
+      std::rethrow_exception(error);
+
+  return objects;
+}
+
+}
@@ -0,0 +1,112 @@
+/**
+ * server/src/world/worldbinary.hpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TRAINTASTIC_SERVER_WORLD_WORLDBINARY_HPP
+#define TRAINTASTIC_SERVER_WORLD_WORLDBINARY_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * \brief Binary world file format
+ *
+ * Same document as the JSON world file, but the objects are stored as
+ * separate CBOR blobs with an index, so they can be decoded without parsing
+ * text and without copying the whole document:
+ *
+ * | Field        | Type               | Description                        |
+ * |--------------|--------------------|------------------------------------|
+ * | magic        | 4 bytes            | \c TTWB                            |
+ * | version      | uint32             | format version                     |
+ * | object count | uint32             |                                    |
+ * | header size  | uint32             |                                    |
+ * | index        | object count times | uint32 id length, id, uint32 size  |
+ * | header       | header size bytes  | CBOR, document without \c objects  |
+ * | objects      |                    | CBOR, one per index entry in order |
+ *
+ * All integers are little endian.
+ */
+namespace WorldBinary {
+
+constexpr std::string_view magic{"TTWB"};
+constexpr uint32_t version = 1;
+
+//! \return \c true if data starts with the binary world magic
+bool isBinary(std::string_view data);
+
+/**
+ * \brief Encode world document
+ *
+ * \param[in] document World document, \c objects array must contain objects with an \c id
+ * \return Binary world data
+ */
+std::string write(const nlohmann::json& document);
+
+class Reader
+{
+  public:
+    struct Object
+    {
+      std::string_view id;
+      std::string_view data; //!< CBOR
+    };
+
+  private:
+    static constexpr size_t parseObjectsPerThreadMin = 256;
+
+    const std::string m_data;
+    nlohmann::json m_header;
+    std::vector<Object> m_objects;
+
+  public:
+    /**
+     * \param[in] data Binary world data
+     * \throws std::runtime_error if data isn't valid
+     */
+    explicit Reader(std::string data);
+
+    Reader(const Reader&) = delete;
+    Reader& operator =(const Reader&) = delete;
+
+    //! \brief World document without \c objects
+    nlohmann::json& header() { return m_header; }
+
+    const std::vector<Object>& objects() const { return m_objects; }
+
+    static nlohmann::json parse(const Object& object);
+
+    /**
+     * \brief Decode all objects
+     *
+     * The objects are independent CBOR blobs, large worlds are decoded using
+     * multiple threads.
+     *
+     * \return Objects in index order
+     */
+    std::vector<nlohmann::json> parseObjects() const;
+};
+
+}
+
+#endif
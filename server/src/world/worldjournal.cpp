@@ -0,0 +1,258 @@
+/**
+ * server/src/world/worldjournal.cpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "worldjournal.hpp"
+#include <fstream>
+#include "world.hpp"
+#include "worldsaver.hpp"
+#include "../core/eventloop.hpp"
+#include "../core/stateobject.hpp"
+#include "../log/log.hpp"
+
+using nlohmann::json;
+
+std::filesystem::path WorldJournal::path(const std::filesystem::path& worldPath)
+{
+  return std::filesystem::path(worldPath).replace_extension(dotJournal);
+}
+
+std::vector<json> WorldJournal::read(const std::filesystem::path& filename, std::string_view uuid, uint64_t sequence)
+{
+  std::vector<json> records;
+
+  std::ifstream file(filename, std::ios::binary);
+  if(!file.is_open())
+    return records;
+
+  std::string line;
+  if(!std::getline(file, line))
+    return records;
+
+  try
+  {
+    const json header = json::parse(line);
+    if(!header.is_object() || header.value("uuid", "") != uuid)
+      return records;
+  }
+  catch(const json::exception&)
+  {
+    return records;
+  }
+
+  while(std::getline(file, line) && !file.eof()) // the last line is only complete if it ends with a newline
+  {
+    json record;
+    try
+    {
+      record = json::parse(line);
+    }
+    catch(const json::exception&)
+    {
+      break;
+    }
+    if(!record.is_object() || !record["id"].is_string() || !record["sequence"].is_number_unsigned())
+      break;
+    if(record["sequence"].get<uint64_t>() > sequence)
+      records.emplace_back(std::move(record));
+  }
+
+  return records;
+}
+
+WorldJournal::WorldJournal(World& world, std::filesystem::path filename, uint64_t sequence, std::vector<json> records)
+  : m_filename{std::move(filename)}
+  , m_header{json::object({{"uuid", world.uuid.value()}}).dump().append("\n")}
+  , m_sequence{sequence}
+  , m_flushTimer{EventLoop::ioContext}
+  , m_thread{&WorldJournal::run, this}
+{
+  for(auto& record : records)
+  {
+    const auto recordSequence = record["sequence"].get<uint64_t>();
+    m_sequence = std::max(m_sequence, recordSequence);
+    m_records[record["id"].get<std::string>()] = {recordSequence, record.dump().append("\n")};
+  }
+
+  compact(); // replaces a file of a previous session, including a partly written last line
+}
+
+WorldJournal::~WorldJournal()
+{
+  m_flushTimer.cancel();
+  flush();
+
+  {
+    std::lock_guard<std::mutex> lock(m_jobsMutex);
+    m_stop = true;
+  }
+  m_jobsCondition.notify_one();
+  m_thread.join();
+}
+
+void WorldJournal::changed(Object& object)
+{
+  auto weak = object.weak_from_this();
+  if(weak.expired()) // still being constructed, it has its initial state
+    return;
+
+  m_dirty.try_emplace(object.getObjectId(), Dirty{std::move(weak), dynamic_cast<StateObject*>(&object) != nullptr});
+
+  if(!m_flushPending)
+  {
+    m_flushPending = true;
+    m_flushTimer.expires_after(flushDelay);
+    m_flushTimer.async_wait(
+      [this](const boost::system::error_code& ec)
+      {
+        if(ec)
+          return;
+        m_flushPending = false;
+        flush();
+      });
+  }
+}
+
+void WorldJournal::flush()
+{
+  if(m_dirty.empty())
+    return;
+
+  WorldSaver saver;
+  std::string lines;
+
+  for(const auto& [id, dirty] : m_dirty)
+  {
+    auto object = dirty.object.lock();
+    const bool exists = object && !object->dying();
+
+    json record = json::object();
+    if(dirty.isStateObject)
+    {
+      if(exists)
+        record["object"] = saver.saveStateObject(std::static_pointer_cast<StateObject>(object));
+      else
+        record["removed"] = true;
+    }
+    else if(exists)
+      record["state"] = saver.saveState(*object);
+    else
+      continue; // object is deleted, its state is dropped at the next save
+
+    record["id"] = id;
+    record["sequence"] = ++m_sequence;
+
+    auto& it = m_records[id];
+    it.sequence = m_sequence;
+    it.line = record.dump().append("\n");
+    lines.append(it.line);
+  }
+  m_dirty.clear();
+
+  if(lines.empty())
+    return;
+
+  m_size += lines.size();
+  if(m_size > m_compactSize)
+    compact();
+  else
+    queue({false, std::move(lines)});
+}
+
+void WorldJournal::saved(uint64_t sequence)
+{
+  for(auto it = m_records.begin(); it != m_records.end();)
+  {
+    if(it->second.sequence <= sequence)
+      it = m_records.erase(it);
+    else
+      it++;
+  }
+
+  compact();
+}
+
+void WorldJournal::compact()
+{
+  std::string data = m_header;
+  for(const auto& it : m_records)
+    data.append(it.second.line);
+
+  m_size = data.size();
+  m_compactSize = std::max(compactSizeMin, 2 * m_size);
+  queue({true, std::move(data)});
+}
+
+void WorldJournal::queue(Job job)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_jobsMutex);
+    m_jobs.emplace_back(std::move(job));
+  }
+  m_jobsCondition.notify_one();
+}
+
+void WorldJournal::run()
+{
+  std::unique_lock<std::mutex> lock(m_jobsMutex);
+  for(;;)
+  {
+    m_jobsCondition.wait(lock, [this]() { return m_stop || !m_jobs.empty(); });
+    if(m_jobs.empty()) // stop, after all jobs are written
+      break;
+
+    Job job = std::move(m_jobs.front());
+    m_jobs.pop_front();
+
+    lock.unlock();
+    try
+    {
+      write(job);
+    }
+    catch(const std::exception& e)
+    {
+      EventLoop::call(
+        [filename=m_filename.string(), what=std::string(e.what())]()
+        {
+          Log::log(World::id, LogMessage::E1010_WRITING_WORLD_JOURNAL_X_FAILED_X, filename, what);
+        });
+    }
+    lock.lock();
+  }
+}
+
+void WorldJournal::write(const Job& job)
+{
+  const auto filename = job.rewrite ? std::filesystem::path(m_filename) += ".tmp" : m_filename;
+
+  {
+    std::ofstream file(filename, job.rewrite ? (std::ios::binary | std::ios::trunc) : (std::ios::binary | std::ios::app));
+    if(!file.is_open())
+      throw std::runtime_error("file not open");
+    file.write(job.data.data(), static_cast<std::streamsize>(job.data.size()));
+    if(!file)
+      throw std::runtime_error("write failed");
+  }
+  WorldSaver::syncToDisk(filename);
+
+  if(job.rewrite)
+    std::filesystem::rename(filename, m_filename); // atomic, replaces existing file
+}
@@ -0,0 +1,157 @@
+/**
+ * server/src/world/worldjournal.hpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TRAINTASTIC_SERVER_WORLD_WORLDJOURNAL_HPP
+#define TRAINTASTIC_SERVER_WORLD_WORLDJOURNAL_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <boost/asio/steady_timer.hpp>
+#include <traintastic/utils/stdfilesystem.hpp>
+#include "../utils/json.hpp"
+
+class Object;
+class World;
+
+/**
+ * \brief Append-only journal of runtime state changes
+ *
+ * Runtime state (block occupancy, train positions, turnout positions, Lua
+ * persistent variables, ...) is only written to the state file when the
+ * world is saved. To survive a power cut every state change is also appended
+ * to \c <uuid>.journal next to the world, one JSON line per record:
+ *
+ * \code
+ * {"uuid":"..."}
+ * {"id":"train_1","sequence":1,"state":{...}}
+ * {"id":"train_block_status_1","object":{...},"sequence":2}
+ * {"id":"train_block_status_2","removed":true,"sequence":3}
+ * \endcode
+ *
+ * The first line is the header, \c state replaces the state of an object,
+ * \c object adds or replaces a state object and \c removed removes a state object.
+ *
+ * Changes are collected and written in batches, appending and syncing is done
+ * in a background thread. The state file contains the last sequence number it
+ * includes, WorldLoader only replays newer records. When the file has grown
+ * too much it is compacted, only the last record of each object is kept.
+ */
+class WorldJournal
+{
+  private:
+    struct Dirty
+    {
+      std::weak_ptr<Object> object;
+      bool isStateObject;
+    };
+
+    struct Record
+    {
+      uint64_t sequence;
+      std::string line;
+    };
+
+    struct Job
+    {
+      bool rewrite; //!< \c true: replace file, \c false: append to file
+      std::string data;
+    };
+
+    const std::filesystem::path m_filename;
+    const std::string m_header;
+    uint64_t m_sequence;
+    std::unordered_map<std::string, Dirty> m_dirty;
+    std::unordered_map<std::string, Record> m_records; //!< last record of each object
+    size_t m_size = 0; //!< journal file size
+    size_t m_compactSize = compactSizeMin;
+    boost::asio::steady_timer m_flushTimer;
+    bool m_flushPending = false;
+
+    std::mutex m_jobsMutex;
+    std::condition_variable m_jobsCondition;
+    std::deque<Job> m_jobs;
+    bool m_stop = false;
+    std::thread m_thread; //!< writes and syncs the journal file
+
+    void compact();
+    void queue(Job job);
+    void run();
+    void write(const Job& job);
+
+  public:
+    static constexpr std::string_view dotJournal = ".journal";
+    static constexpr auto flushDelay = std::chrono::milliseconds(100);
+    static constexpr size_t compactSizeMin = 256 * 1024;
+
+    /**
+     * \brief Journal filename for a world
+     *
+     * \param[in] worldPath World file (.ctw) or directory
+     */
+    static std::filesystem::path path(const std::filesystem::path& worldPath);
+
+    /**
+     * \brief Read journal records
+     *
+     * Reading stops at the first incomplete or invalid line, that is the last
+     * append that was interrupted.
+     *
+     * \param[in] filename Journal file
+     * \param[in] uuid World UUID, if it doesn't match the header no records are returned
+     * \param[in] sequence Last sequence number included in the state file, only newer records are returned
+     * \return Records in the order they must be applied
+     */
+    static std::vector<nlohmann::json> read(const std::filesystem::path& filename, std::string_view uuid, uint64_t sequence);
+
+    /**
+     * \param[in] world World to record the state changes of
+     * \param[in] filename Journal file, it is rewritten with only the \a records
+     * \param[in] sequence Last sequence number included in the state file
+     * \param[in] records Records replayed by WorldLoader, kept until the world is saved
+     */
+    WorldJournal(World& world, std::filesystem::path filename, uint64_t sequence, std::vector<nlohmann::json> records = {});
+    ~WorldJournal();
+
+    const std::filesystem::path& filename() const { return m_filename; }
+
+    //! \brief Last used sequence number
+    uint64_t sequence() const { return m_sequence; }
+
+    //! \brief Record the state of \a object, it is written at the next flush
+    void changed(Object& object);
+
+    //! \brief Write all recorded changes
+    void flush();
+
+    //! \brief Remove records included in the state file and compact the journal
+    void saved(uint64_t sequence);
+};
+
+#endif
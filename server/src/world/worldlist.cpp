@@ -22,12 +22,17 @@
 
 #include "worldlist.hpp"
 #include <fstream>
+#include <boost/uuid/nil_generator.hpp>
 #include <boost/uuid/string_generator.hpp>
+#include <boost/uuid/uuid_io.hpp>
 #include "../traintastic/traintastic.hpp"
 #include "../log/log.hpp"
 #include "worldlisttablemodel.hpp"
 #include "ctwreader.hpp"
+#include "worldbinary.hpp"
+#include "worldsaver.hpp"
 #include "libarchiveerror.hpp"
+#include "../traintastic/startupprofiler.hpp"
 
 using nlohmann::json;
 
@@ -37,6 +42,8 @@ WorldList::WorldList(const std::filesystem::path& path) :
   if(!std::filesystem::is_directory(m_path))
     std::filesystem::create_directories(m_path);
 
+  Log::log(Traintastic::classId, LogMessage::I1005_BUILDING_WORLD_INDEX);
+  loadIndex();
   buildIndex();
 }
 
@@ -51,57 +58,52 @@ const WorldList::WorldInfo* WorldList::find(const boost::uuids::uuid& uuid)
 
 void WorldList::buildIndex()
 {
-  Log::log(Traintastic::classId, LogMessage::I1005_BUILDING_WORLD_INDEX);
-
-  m_items.clear();
+  std::vector<WorldInfo> items;
+  std::unordered_map<std::string, IndexEntry> index;
+  bool indexChanged = false;
 
   WorldInfo info;
   for(const auto& it : std::filesystem::directory_iterator(m_path))
   {
     info.path = it.path();
 
-    if(info.path.extension() == World::dotCTW)
-    {
-      try
-      {
-        CTWReader ctw(info.path);
-
-        json world;
-        if(ctw.readFile(World::filename, world) && readInfo(world, info))
-          m_items.push_back(info);
-      }
-      catch(const LibArchiveError& e)
-      {
-        Log::log(Traintastic::classId, LogMessage::W1003_READING_WORLD_X_FAILED_LIBARCHIVE_ERROR_X_X, info.path.filename(), e.errorCode, e.what());
-      }
+    IndexEntry entry;
+    if(!stat(info.path, entry))
       continue;
-    }
 
-    const auto worldFile = info.path / World::filename;
-    if(std::filesystem::is_directory(info.path) && std::filesystem::is_regular_file(worldFile))
+    auto filename = info.path.filename().string();
+    if(auto cached = m_index.find(filename); cached != m_index.end() && cached->second.mtime == entry.mtime && cached->second.size == entry.size)
+    {
+      entry = cached->second;
+    }
+    else // new or modified
     {
-      std::ifstream file(worldFile);
-      if(file.is_open())
+      if(readInfo(info.path, info))
       {
-        try
-        {
-          json world = json::parse(file);
-
-          if(readInfo(world, info))
-            m_items.push_back(info);
-        }
-        catch(const std::exception& e)
-        {
-          Log::log(Traintastic::classId, LogMessage::C1004_READING_WORLD_FAILED_X_X, e, worldFile);
-        }
+        entry.uuid = info.uuid;
+        entry.name = info.name;
       }
+      else
+        entry.uuid = boost::uuids::nil_uuid(); // don't read it again until it is modified
+      indexChanged = true;
     }
+
+    if(!entry.uuid.is_nil())
+      items.emplace_back(WorldInfo{entry.uuid, entry.name, info.path});
+
+    index.emplace(std::move(filename), std::move(entry));
   }
 
-  sort();
+  if(index.size() != m_index.size()) // world(s) removed
+    indexChanged = true;
 
-  //for(auto& model : m_models)
-  //  model->setRowCount(m_items.size());
+  m_index = std::move(index);
+  m_items = std::move(items);
+
+  if(indexChanged)
+    saveIndex();
+
+  changed();
 }
 
 void WorldList::update(World& world, const std::filesystem::path& path)
@@ -117,10 +119,21 @@ void WorldList::update(World& world, const std::filesystem::path& path)
   {
     m_items.emplace_back(WorldInfo{uuid, world.name.value(), path});
   }
+
+  if(IndexEntry entry; stat(path, entry))
+  {
+    entry.uuid = uuid;
+    entry.name = world.name;
+    m_index.insert_or_assign(path.filename().string(), std::move(entry));
+    saveIndex();
+  }
+
+  changed();
 }
 
 TableModelPtr WorldList::getModel()
 {
+  buildIndex(); // pick up worlds added, modified or removed since the last scan
   return std::make_shared<WorldListTableModel>(*this);
 }
 
@@ -139,6 +152,177 @@ bool WorldList::readInfo(const json& world, WorldInfo& info)
   return !info.uuid.is_nil();
 }
 
+bool WorldList::readInfo(const std::filesystem::path& path, WorldInfo& info)
+{
+  if(path.extension() == World::dotCTW)
+  {
+    try
+    {
+      CTWReader ctw(path);
+
+      // the JSON data file is the first file of a JSON world, only that file is decompressed:
+      json world;
+      if(ctw.readFile(World::filename, world))
+        return readInfo(world, info);
+      if(std::string text; ctw.readFile(World::filenameBinary, text))
+      {
+        WorldBinary::Reader reader(std::move(text));
+        return readInfo(reader.header(), info);
+      }
+    }
+    catch(const LibArchiveError& e)
+    {
+      Log::log(Traintastic::classId, LogMessage::W1003_READING_WORLD_X_FAILED_LIBARCHIVE_ERROR_X_X, path.filename(), e.errorCode, e.what());
+    }
+    catch(const std::exception& e)
+    {
+      Log::log(Traintastic::classId, LogMessage::C1004_READING_WORLD_FAILED_X_X, e, path);
+    }
+    return false;
+  }
+
+  const auto filename = worldFile(path);
+  if(filename.filename() == World::filenameBinary)
+  {
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    if(file.is_open())
+    {
+      try
+      {
+        WorldBinary::Reader reader{std::string(std::istreambuf_iterator<char>(file), {})};
+        return readInfo(reader.header(), info);
+      }
+      catch(const std::exception& e)
+      {
+        Log::log(Traintastic::classId, LogMessage::C1004_READING_WORLD_FAILED_X_X, e, filename);
+      }
+    }
+  }
+  else if(filename.filename() == World::filename)
+  {
+    std::ifstream file(filename);
+    if(file.is_open())
+    {
+      try
+      {
+        StartupProfiler::Scope scope(StartupProfiler::Phase::JSONParse);
+        return readInfo(json::parse(file), info);
+      }
+      catch(const std::exception& e)
+      {
+        Log::log(Traintastic::classId, LogMessage::C1004_READING_WORLD_FAILED_X_X, e, filename);
+      }
+    }
+  }
+  return false;
+}
+
+std::filesystem::path WorldList::worldFile(const std::filesystem::path& path)
+{
+  if(path.extension() == WorldSaver::dotTmp || path.extension() == WorldSaver::dotOld) // being saved
+    return {};
+
+  if(path.extension() == World::dotCTW)
+    return path;
+
+  if(!std::filesystem::is_directory(path))
+    return {};
+
+  if(auto filename = path / World::filenameBinary; std::filesystem::is_regular_file(filename))
+    return filename;
+
+  if(auto filename = path / World::filename; std::filesystem::is_regular_file(filename))
+    return filename;
+
+  return {};
+}
+
+bool WorldList::stat(const std::filesystem::path& path, IndexEntry& entry)
+{
+  const auto filename = worldFile(path);
+  if(filename.empty())
+    return false;
+
+  std::error_code ec;
+  const auto mtime = std::filesystem::last_write_time(filename, ec);
+  if(ec)
+    return false;
+  const auto size = std::filesystem::file_size(filename, ec);
+  if(ec)
+    return false;
+
+  entry.mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+  entry.size = size;
+  return true;
+}
+
+void WorldList::loadIndex()
+{
+  std::ifstream file(m_path / indexFilename);
+  if(!file.is_open())
+    return;
+
+  try
+  {
+    const json index = json::parse(file);
+    if(index.value("version", 0) != indexVersion)
+      return;
+
+    for(const auto& [filename, entry] : index["worlds"].items())
+    {
+      m_index.emplace(filename, IndexEntry{
+        entry["mtime"].get<int64_t>(),
+        entry["size"].get<uintmax_t>(),
+        boost::uuids::string_generator()(entry["uuid"].get<std::string>()),
+        entry["name"].get<std::string>()});
+    }
+  }
+  catch(const std::exception&)
+  {
+    m_index.clear(); // invalid index, rebuild it
+  }
+}
+
+void WorldList::saveIndex() const
+{
+  json worlds = json::object();
+  for(const auto& [filename, entry] : m_index)
+  {
+    worlds[filename] = {
+      {"mtime", entry.mtime},
+      {"size", entry.size},
+      {"uuid", to_string(entry.uuid)},
+      {"name", entry.name}};
+  }
+
+  // write to a temporary file first, a partially written index must never replace a complete one:
+  const auto filename = m_path / indexFilename;
+  const auto tmpFilename = std::filesystem::path(filename) += WorldSaver::dotTmp;
+  {
+    std::ofstream file(tmpFilename, std::ios::binary | std::ios::trunc);
+    if(!file.is_open())
+      return;
+    file << json::object({{"version", indexVersion}, {"worlds", std::move(worlds)}}).dump();
+    file.close();
+    if(!file)
+    {
+      std::error_code ec;
+      std::filesystem::remove(tmpFilename, ec);
+      return;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmpFilename, filename, ec);
+}
+
+void WorldList::changed()
+{
+  sort();
+
+  for(auto* model : m_models)
+    model->worldListChanged();
+}
+
 void WorldList::sort()
 {
   std::sort(m_items.begin(), m_items.end(),
@@ -26,6 +26,7 @@
 #include "../core/object.hpp"
 #include "../core/table.hpp"
 #include <traintastic/utils/stdfilesystem.hpp>
+#include <unordered_map>
 #include <vector>
 #include <boost/uuid/uuid.hpp>
 
@@ -54,10 +55,29 @@ class WorldList : public Object, public Table
     };
 
   private:
+    //! \brief Cached world info, valid as long as the world file isn't modified
+    struct IndexEntry
+    {
+      int64_t mtime; //!< world file modification time
+      uintmax_t size; //!< world file size
+      boost::uuids::uuid uuid; //!< nil if it isn't a (readable) world
+      std::string name;
+    };
+
+    static constexpr int indexVersion = 1;
+
+    std::unordered_map<std::string, IndexEntry> m_index; //!< by file or directory name
+
+    static std::filesystem::path worldFile(const std::filesystem::path& path);
+    static bool stat(const std::filesystem::path& path, IndexEntry& entry);
     void sort();
+    void loadIndex();
+    void saveIndex() const;
+    void changed();
 
   protected:
     static bool readInfo(const nlohmann::json& world, WorldInfo& info);
+    static bool readInfo(const std::filesystem::path& path, WorldInfo& info);
 
     const std::filesystem::path m_path;
     std::vector<WorldInfo> m_items;
@@ -67,6 +87,7 @@ class WorldList : public Object, public Table
     CLASS_ID("world_list");
 
     static constexpr std::string_view id = classId;
+    static constexpr std::string_view indexFilename = ".index.json";
 
     WorldList(const std::filesystem::path& path);
 
@@ -74,6 +95,13 @@ class WorldList : public Object, public Table
 
     const WorldInfo* find(const boost::uuids::uuid& uuid);
 
+    /**
+     * \brief Scan the world directory
+     *
+     * Only worlds that are new or modified since the last scan are read, for
+     * the others the info is taken from the index. The index is stored in
+     * the world directory, so it is also used at the next start.
+     */
     void buildIndex();
 
     void update(World& world, const std::filesystem::path& path);
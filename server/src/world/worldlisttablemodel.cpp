@@ -70,3 +70,9 @@ std::string WorldListTableModel::getText(uint32_t column, uint32_t row) const
   return "";
 }
 
+void WorldListTableModel::worldListChanged()
+{
+  setRowCount(static_cast<uint32_t>(m_worldList->m_items.size()));
+  if(updateRegion && rowCount() != 0)
+    rowsChanged(0, rowCount() - 1);
+}
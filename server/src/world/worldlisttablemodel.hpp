@@ -40,6 +40,8 @@ class WorldListTableModel final : public TableModel
     ~WorldListTableModel() final;
 
     std::string getText(uint32_t column, uint32_t row) const final;
+
+    void worldListChanged();
 };
 
 #endif
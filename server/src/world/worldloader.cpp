@@ -22,7 +22,6 @@
 
 #include "worldloader.hpp"
 #include <fstream>
-#include <boost/algorithm/string.hpp>
 #include <boost/uuid/string_generator.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include "world.hpp"
@@ -30,6 +29,10 @@
 #include "../utils/startswith.hpp"
 #include "../utils/stripsuffix.hpp"
 #include "ctwreader.hpp"
+#include "worldbinary.hpp"
+#include "worldjournal.hpp"
+#include "../traintastic/startupprofiler.hpp"
+#include "../log/log.hpp"
 #include "../log/logmessageexception.hpp"
 #include <version.hpp>
 
@@ -57,6 +60,8 @@ WorldLoader::WorldLoader()
 WorldLoader::WorldLoader(std::filesystem::path path)
   : WorldLoader()
 {
+  m_journalPath = WorldJournal::path(path);
+
   if(path.extension() == World::dotCTW)
     m_ctw = std::make_unique<CTWReader>(path);
   else
@@ -75,23 +80,35 @@ WorldLoader::WorldLoader(const std::vector<std::byte>& memory)
 
 WorldLoader::~WorldLoader() = default; // default here, so we can use a forward declaration of CTWReader in the header.
 
+WorldLoader::ObjectData& WorldLoader::addObject(std::string id, json data, ObjectPtr object)
+{
+  if(auto it = m_objects.find(id); it != m_objects.end())
+    return *it->second; // first one wins
+
+  auto& objectData = m_objectData.emplace_back(ObjectData{std::move(id), std::move(data), std::move(object), false});
+  m_objects.emplace(objectData.id, &objectData);
+  return objectData;
+}
+
 ObjectPtr WorldLoader::getObject(std::string_view id)
 {
-  std::vector<std::string> ids;
-  boost::split(ids, id, [](char c){ return c == '.'; });
-  auto itId = ids.cbegin();
+  // id is: object[.property[.property...]], split without allocating:
+  size_t dot = id.find('.');
 
   ObjectPtr obj;
-  if(auto it = m_objects.find(*itId); it != m_objects.end())
+  if(auto it = m_objects.find(id.substr(0, dot)); it != m_objects.end())
   {
-    if(!it->second.object)
-      createObject(it->second);
-    obj = it->second.object;
+    if(!it->second->object)
+      createObject(*it->second);
+    obj = it->second->object;
   }
 
-  while(obj && ++itId != ids.cend())
+  while(obj && dot != std::string_view::npos)
   {
-    AbstractProperty* property = obj->getProperty(*itId);
+    id.remove_prefix(dot + 1);
+    dot = id.find('.');
+
+    AbstractProperty* property = obj->getProperty(id.substr(0, dot));
     if(property && property->type() == ValueType::Object)
       obj = property->toObject();
     else
@@ -112,18 +129,33 @@ void WorldLoader::load()
 
   json data;
   json state;
+  std::unique_ptr<WorldBinary::Reader> binaryData;
+  std::unique_ptr<WorldBinary::Reader> binaryState;
 
-  // load file(s):
-  if(m_ctw)
+  // load file(s), a world contains either the JSON or the binary format:
+  if(m_ctw && m_ctw->readFile(World::filename, data)) // parsed straight from the archive, so it is tried first
   {
-    if(!m_ctw->readFile(World::filename, data))
-      throw std::runtime_error(std::string("can't read ").append(World::filename));
-
     if(!m_ctw->readFile(World::filenameState, state))
       throw std::runtime_error(std::string("can't read ").append(World::filenameState));
   }
+  else if(std::string text; readFile(World::filenameBinary, text))
+  {
+    binaryData = std::make_unique<WorldBinary::Reader>(std::move(text));
+    data = std::move(binaryData->header());
+
+    if(!readFile(World::filenameStateBinary, text))
+      throw std::runtime_error(std::string("can't read ").append(World::filenameStateBinary));
+    binaryState = std::make_unique<WorldBinary::Reader>(std::move(text));
+    state = std::move(binaryState->header());
+  }
+  else if(m_ctw)
+  {
+    throw std::runtime_error(std::string("can't read ").append(World::filename));
+  }
   else
   {
+    StartupProfiler::Scope scope(StartupProfiler::Phase::JSONParse);
+
     std::ifstream file(m_path / World::filename);
     if(!file.is_open())
       throw std::runtime_error("can't open " + (m_path / World::filename).string());
@@ -162,64 +194,115 @@ void WorldLoader::load()
     }
   }
 
+  // create a list of all objects
+  auto& worldData = addObject(m_world->getObjectId(), json(), m_world);
+
+  auto addObjectJSON =
+    [this](json&& object)
+    {
+      //! \todo Remove in v0.4
+      if(object["class_id"].get<std::string_view>() == "output") // don't create Output objects, no longer stored in file.
+      {
+        return;
+      }
+
+      if(auto it = object.find("id"); it != object.end())
+      {
+        auto id = it.value().get<std::string>();
+        if(!isValidObjectId(id))
+          throw std::runtime_error("invalid object id value");
+        addObject(std::move(id), std::move(object));
+      }
+      else
+        throw std::runtime_error("id missing");
+    };
+
+  auto addObjects =
+    [this, &addObjectJSON](json& document, const std::unique_ptr<WorldBinary::Reader>& binary)
+    {
+      if(binary)
+      {
+        auto objects = binary->parseObjects(); // parallel, objects are independent until they are created
+        m_objects.reserve(m_objects.size() + objects.size());
+        for(auto& object : objects)
+          addObjectJSON(std::move(object));
+      }
+      else if(auto it = document.find("objects"); it != document.end())
+      {
+        m_objects.reserve(m_objects.size() + it->size());
+        for(auto& object : *it)
+          addObjectJSON(std::move(object));
+        document.erase(it);
+      }
+    };
+
+  addObjects(data, binaryData);
+
   // state data
+  uint64_t journalSequence = 0;
   if(state.is_object() && state["uuid"] == data["uuid"])
   {
-    m_states = state["states"];
-    auto stateObjects = state.value("objects", json::array());
-    data["objects"].insert(data["objects"].end(), stateObjects.begin(), stateObjects.end());
+    m_states = std::move(state["states"]);
+    addObjects(state, binaryState);
+    journalSequence = state.value<uint64_t>("journal_sequence", 0);
   }
 
-  // create a list of all objects
-  m_objects.insert({m_world->getObjectId(), {data, m_world, false}});
-  for(json object : data["objects"])
+  // state changes after the last save, e.g. after a power cut:
+  std::vector<json> journalRecords;
+  if(!m_journalPath.empty())
   {
-    //! \todo Remove in v0.4
-    if(object["class_id"].get<std::string_view>() == "output") // don't create Output objects, no longer stored in file.
+    journalRecords = WorldJournal::read(m_journalPath, m_world->uuid.value(), journalSequence);
+    for(auto& record : journalRecords)
     {
-      continue;
-    }
-
-    if(auto it = object.find("id"); it != object.end())
-    {
-      auto id = it.value().get<std::string>();
-      if(!isValidObjectId(id))
-        throw std::runtime_error("invalid object id value");
-      m_objects.insert({std::move(id), {object, nullptr, false}});
+      const auto id = record["id"].get<std::string>();
+      if(auto it = record.find("state"); it != record.end())
+      {
+        m_states[id] = *it;
+      }
+      else if(it = record.find("object"); it != record.end())
+      {
+        addObject(id, json()).json = *it;
+      }
+      else if(record.contains("removed") && id != m_world->getObjectId())
+      {
+        m_objects.erase(id);
+      }
     }
-    else
-      throw std::runtime_error("id missing");
+    if(!journalRecords.empty())
+      Log::log(*m_world, LogMessage::N1029_RESTORED_X_STATE_CHANGES_FROM_JOURNAL, journalRecords.size());
   }
 
+  worldData.json = std::move(data);
+
   //! \todo Remove in v0.4
   {
     // patch for input refactor:
     for(auto& objectData : m_objects)
     {
-      if(!objectData.second.json.contains("class_id"))
+      if(!objectData.second->json.contains("class_id"))
       {
         continue;
       }
-      auto classId = objectData.second.json["class_id"].get<std::string_view>();
+      auto classId = objectData.second->json["class_id"].get<std::string_view>();
       if(classId == "board_tile.rail.sensor" ||
           classId == "board_tile.rail.nx_button" ||
           classId == "input_map_item.block")
       {
-        const auto& input = objectData.second.json["input"];
+        const auto& input = objectData.second->json["input"];
         if(input.is_string())
         {
           if(auto it = m_objects.find(input.get<std::string>()); it != m_objects.end()) [[likely]]
           {
-            objectData.second.json["interface"] = it->second.json["interface"];
-            objectData.second.json["channel"] = it->second.json["channel"];
-            objectData.second.json["address"] = it->second.json["address"];
+            objectData.second->json["interface"] = it->second->json["interface"];
+            objectData.second->json["channel"] = it->second->json["channel"];
+            objectData.second->json["address"] = it->second->json["address"];
           }
         }
-        objectData.second.json.erase("input");
+        objectData.second->json.erase("input");
       }
       else if(classId == "board_tile.rail.block")
       {
-        auto& inputMap = objectData.second.json["input_map"];
+        auto& inputMap = objectData.second->json["input_map"];
         if(inputMap.is_object())
         {
           auto& items = inputMap["items"];
@@ -232,15 +315,15 @@ void WorldLoader::load()
               {
                 if(auto it = m_objects.find(input.get<std::string>()); it != m_objects.end()) [[likely]]
                 {
-                  item["interface"] = it->second.json["interface"];
-                  const int ch = it->second.json["channel"].get<int>();
+                  item["interface"] = it->second->json["interface"];
+                  const int ch = it->second->json["channel"].get<int>();
                   if(ch == 0)
                   {
                     item["channel"] = "input";
                   }
                   else if(auto interface = m_objects.find(item["interface"].get<std::string>()); it != m_objects.end()) [[likely]]
                   {
-                    const auto interfaceClassId = interface->second.json["class_id"].get<std::string_view>();
+                    const auto interfaceClassId = interface->second->json["class_id"].get<std::string_view>();
                     if(interfaceClassId == "interface.ecos")
                     {
                       if(ch == 1)
@@ -295,7 +378,7 @@ void WorldLoader::load()
                       assert(false);
                     }
                   }
-                  item["address"] = it->second.json["address"];
+                  item["address"] = it->second->json["address"];
                 }
               }
               item.erase("input");
@@ -307,7 +390,7 @@ void WorldLoader::load()
     // remove all input objects:
     for(auto it = m_objects.begin(); it != m_objects.end();)
     {
-      if(it->second.json.contains("class_id") && it->second.json["class_id"].get<std::string_view>() == "input")
+      if(it->second->json.contains("class_id") && it->second->json["class_id"].get<std::string_view>() == "input")
       {
         it = m_objects.erase(it);
       }
@@ -318,19 +401,31 @@ void WorldLoader::load()
     }
   }
 
-  // then create all objects
-  for(auto& it : m_objects)
-    if(!it.second.object)
-      createObject(it.second);
+  {
+    StartupProfiler::Scope scope(StartupProfiler::Phase::ObjectCreation);
+
+    // then create all objects
+    for(auto& it : m_objects)
+      if(!it.second->object)
+        createObject(*it.second);
 
-  // and load their data/state
-  for(auto& it : m_objects)
-    if(!it.second.loaded)
-      loadObject(it.second);
+    // and load their data/state
+    for(auto& it : m_objects)
+      if(!it.second->loaded)
+        loadObject(*it.second);
+  }
 
   // and finally notify loading is completed
-  for(auto& it : m_objects)
-    it.second.object->loaded();
+  {
+    StartupProfiler::Scope scope(StartupProfiler::Phase::Loaded);
+
+    for(auto& it : m_objects)
+      it.second->object->loaded();
+  }
+
+  // record state changes from now on:
+  if(!m_journalPath.empty())
+    m_world->m_journal = std::make_unique<WorldJournal>(*m_world, m_journalPath, journalSequence, std::move(journalRecords));
 }
 
 void WorldLoader::createObject(ObjectData& objectData)
@@ -450,6 +545,8 @@ bool WorldLoader::readFile(const std::filesystem::path& filename, std::string& d
   }
   else
   {
+    StartupProfiler::Scope scope(StartupProfiler::Phase::ArchiveRead);
+
     std::ifstream file(m_path / filename, std::ios::in | std::ios::binary | std::ios::ate);
     if(!file.is_open())
       return false;
@@ -468,6 +565,7 @@ bool WorldLoader::readFile(const std::filesystem::path& filename, nlohmann::json
   {
     try
     {
+      StartupProfiler::Scope scope(StartupProfiler::Phase::JSONParse);
       data = nlohmann::json::parse(text);
       return true;
     }
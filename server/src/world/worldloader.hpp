@@ -23,8 +23,10 @@
 #ifndef TRAINTASTIC_SERVER_WORLD_WORLDLOADER_HPP
 #define TRAINTASTIC_SERVER_WORLD_WORLDLOADER_HPP
 
+#include <deque>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <traintastic/utils/stdfilesystem.hpp>
@@ -40,20 +42,25 @@ class WorldLoader
   private:
     struct ObjectData
     {
+      std::string id;
       nlohmann::json json;
       std::shared_ptr<Object> object;
       bool loaded;
     };
 
     std::filesystem::path m_path;
+    std::filesystem::path m_journalPath; //!< only for worlds loaded from disk
     std::unique_ptr<CTWReader> m_ctw;
     std::shared_ptr<World> m_world;
-    std::unordered_map<std::string, ObjectData> m_objects;
+    std::deque<ObjectData> m_objectData; //!< owns the object ids, a deque keeps them at a stable address
+    std::unordered_map<std::string_view, ObjectData*> m_objects; //!< index of m_objectData, key points into ObjectData::id
     nlohmann::json m_states;
 
     WorldLoader();
     void load();
 
+    ObjectData& addObject(std::string id, nlohmann::json data, ObjectPtr object = {});
+
     void createObject(ObjectData& objectData);
     void loadObject(ObjectData& objectData);
 
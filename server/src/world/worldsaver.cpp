@@ -22,6 +22,13 @@
 
 #include "worldsaver.hpp"
 #include <fstream>
+#include <system_error>
+#if defined(__unix__) || defined(__APPLE__)
+  #include <fcntl.h>
+  #include <unistd.h>
+#elif defined(WIN32)
+  #include <windows.h>
+#endif
 #include <boost/uuid/uuid_io.hpp>
 #include <version.hpp>
 #include "world.hpp"
@@ -30,6 +37,7 @@
 #include "../status/simulationstatus.hpp"
 #include "../utils/sha1.hpp"
 #include "ctwwriter.hpp"
+#include "worldbinary.hpp"
 
 using nlohmann::json;
 
@@ -99,46 +107,135 @@ WorldSaver::WorldSaver(const World& world)
       }
     }
 
-    std::sort(objects.begin(), objects.end(),
-      [](const json& a, const json& b)
-      {
-        return (a["id"] < b["id"]);
-      });
-
-    m_data["objects"] = objects;
-    m_state["objects"] = stateObjects;
-    m_state["states"] = m_states;
+    m_data["objects"] = std::move(objects);
+    m_state["objects"] = std::move(stateObjects);
+    m_state["states"] = std::move(m_states);
   }
+
+  // state changes up to this sequence number are included, see WorldJournal:
+  m_state["journal_sequence"] = world.journalSequence();
+}
+
+WorldSaver::WorldSaver(const World& world, const std::filesystem::path& path, Format format)
+  : WorldSaver(world)
+{
+  write(path, format, WorldCompression::XZ);
 }
 
-WorldSaver::WorldSaver(const World& world, const std::filesystem::path& path)
+WorldSaver::WorldSaver(const World& world, std::vector<std::byte>& memory)
   : WorldSaver(world)
 {
+  sortObjects();
+  CTWWriter ctw(memory, WorldCompression::XZ);
+  writeCTW(ctw, Format::JSON, {}); // export is always JSON and xz, readable by older versions
+}
+
+void WorldSaver::write(const std::filesystem::path& path, Format format, WorldCompression compression, const Progress& progress)
+{
+  replace(writeTemporary(path, format, compression, progress), path);
+  if(progress)
+    progress(100);
+}
+
+std::filesystem::path WorldSaver::writeTemporary(const std::filesystem::path& path, Format format, WorldCompression compression, const Progress& progress)
+{
+  auto reportProgress =
+    [&progress](uint8_t percent)
+    {
+      if(progress)
+        progress(percent);
+    };
+
+  sortObjects();
+  reportProgress(10);
+
+  const auto tmpPath = std::filesystem::path(path) += dotTmp;
+  std::filesystem::remove_all(tmpPath); // leftover of an interrupted save
+
   if(path.extension() == World::dotCTW)
   {
-    CTWWriter ctw(path);
-    writeCTW(ctw);
+    {
+      CTWWriter ctw(tmpPath, compression);
+      writeCTW(ctw, format, progress);
+    }
+    syncToDisk(tmpPath);
   }
   else
   {
-    saveToDisk(m_data, path / World::filename);
-    saveToDisk(m_state, path / World::filenameState);
-    deleteFiles(path);
-    writeFiles(path);
+    if(format == Format::Binary)
+    {
+      saveToDisk(WorldBinary::write(m_data), tmpPath / World::filenameBinary);
+      reportProgress(50);
+      saveToDisk(WorldBinary::write(m_state), tmpPath / World::filenameStateBinary);
+    }
+    else
+    {
+      saveToDisk(m_data, tmpPath / World::filename);
+      reportProgress(50);
+      saveToDisk(m_state, tmpPath / World::filenameState);
+    }
+    reportProgress(60);
+    deleteFiles(tmpPath);
+    writeFiles(tmpPath);
+    syncDirectory(tmpPath);
   }
+  reportProgress(90);
+
+  return tmpPath;
 }
 
-WorldSaver::WorldSaver(const World& world, std::vector<std::byte>& memory)
-  : WorldSaver(world)
+void WorldSaver::replace(const std::filesystem::path& tmpPath, const std::filesystem::path& path)
+{
+  if(std::filesystem::is_directory(tmpPath)) // a directory can't be replaced by rename
+  {
+    const auto oldPath = std::filesystem::path(path) += dotOld;
+    std::filesystem::remove_all(oldPath);
+    if(std::filesystem::exists(path))
+      std::filesystem::rename(path, oldPath);
+    std::filesystem::rename(tmpPath, path);
+    syncDirectory(path.parent_path());
+    std::filesystem::remove_all(oldPath);
+  }
+  else
+  {
+    std::filesystem::rename(tmpPath, path); // atomic, replaces existing file
+    syncDirectory(path.parent_path());
+  }
+}
+
+void WorldSaver::sortObjects()
 {
-  CTWWriter ctw(memory);
-  writeCTW(ctw);
+  if(m_sorted)
+    return;
+
+  auto& objects = m_data["objects"];
+  std::sort(objects.begin(), objects.end(),
+    [](const json& a, const json& b)
+    {
+      return (a["id"] < b["id"]);
+    });
+  m_sorted = true;
 }
 
-void WorldSaver::writeCTW(CTWWriter& ctw)
+void WorldSaver::writeCTW(CTWWriter& ctw, Format format, const Progress& progress)
 {
-  ctw.writeFile(World::filename, m_data);
-  ctw.writeFile(World::filenameState, m_state);
+  // the compression is done while writing, so writing the data file takes most time:
+  if(format == Format::Binary)
+  {
+    ctw.writeFile(World::filenameBinary, WorldBinary::write(m_data));
+    if(progress)
+      progress(70);
+    ctw.writeFile(World::filenameStateBinary, WorldBinary::write(m_state));
+  }
+  else
+  {
+    ctw.writeFile(World::filename, m_data);
+    if(progress)
+      progress(70);
+    ctw.writeFile(World::filenameState, m_state);
+  }
+  if(progress)
+    progress(80);
   for(const auto& file : m_writeFiles)
     ctw.writeFile(file.first, file.second);
 }
@@ -156,6 +253,13 @@ json WorldSaver::saveObject(const ObjectPtr& object)
   return objectData;
 }
 
+json WorldSaver::saveState(const Object& object)
+{
+  json state = json::object();
+  object.saveState(*this, state);
+  return state;
+}
+
 json WorldSaver::saveStateObject(const std::shared_ptr<StateObject>& object)
 {
   json objectState = json::object();
@@ -196,15 +300,18 @@ void WorldSaver::saveToDisk(const json& data, const std::filesystem::path& filen
   if(!std::filesystem::is_directory(dir))
     std::filesystem::create_directories(dir);
 
-  std::ofstream file(filename);
-  if(file.is_open())
   {
-    file << data.dump(2);
-    //Traintastic::instance->console->notice(classId, "Saved world " + name.value());
+    std::ofstream file(filename);
+    if(file.is_open())
+    {
+      file << data.dump(2);
+      //Traintastic::instance->console->notice(classId, "Saved world " + name.value());
+    }
+    else
+      throw std::runtime_error("file not open");
+      //Traintastic::instance->console->critical(classId, "Can't write to world file");
   }
-  else
-    throw std::runtime_error("file not open");
-    //Traintastic::instance->console->critical(classId, "Can't write to world file");
+  syncToDisk(filename);
 }
 
 void WorldSaver::saveToDisk(const std::string& data, const std::filesystem::path& filename)
@@ -219,13 +326,55 @@ void WorldSaver::saveToDisk(const std::string& data, const std::filesystem::path
   if(!std::filesystem::is_directory(dir))
     std::filesystem::create_directories(dir);
 
-  std::ofstream file(filename);
-  if(file.is_open())
   {
-    file << data;
-    //Traintastic::instance->console->notice(classId, "Saved world " + name.value());
+    std::ofstream file(filename, std::ios::binary);
+    if(file.is_open())
+    {
+      file << data;
+      //Traintastic::instance->console->notice(classId, "Saved world " + name.value());
+    }
+    else
+      throw std::runtime_error("file not open");
+      //Traintastic::instance->console->critical(classId, "Can't write to world file");
   }
-  else
-    throw std::runtime_error("file not open");
-    //Traintastic::instance->console->critical(classId, "Can't write to world file");
+  syncToDisk(filename);
+}
+
+void WorldSaver::syncToDisk(const std::filesystem::path& filename)
+{
+#if defined(__unix__) || defined(__APPLE__)
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if(fd < 0)
+    throw std::system_error(errno, std::generic_category(), "open");
+  const int r = ::fsync(fd);
+  const int error = errno;
+  ::close(fd);
+  if(r != 0)
+    throw std::system_error(error, std::generic_category(), "fsync");
+#elif defined(WIN32)
+  HANDLE handle = CreateFileW(filename.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(handle == INVALID_HANDLE_VALUE)
+    throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "CreateFileW");
+  const bool success = FlushFileBuffers(handle);
+  const DWORD error = GetLastError();
+  CloseHandle(handle);
+  if(!success)
+    throw std::system_error(static_cast<int>(error), std::system_category(), "FlushFileBuffers");
+#endif
+}
+
+void WorldSaver::syncDirectory(const std::filesystem::path& directory)
+{
+#if defined(__unix__) || defined(__APPLE__)
+  const int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY);
+  if(fd < 0)
+    throw std::system_error(errno, std::generic_category(), "open");
+  const int r = ::fsync(fd);
+  const int error = errno;
+  ::close(fd);
+  if(r != 0)
+    throw std::system_error(error, std::generic_category(), "fsync");
+#else
+  static_cast<void>(directory); // NTFS journals directory changes, a directory can't be flushed
+#endif
 }
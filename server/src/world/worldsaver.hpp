@@ -24,9 +24,12 @@
 #define TRAINTASTIC_SERVER_WORLD_WORLDSAVER_HPP
 
 #include <list>
+#include <string_view>
+#include <functional>
 #include "../core/objectptr.hpp"
 #include <traintastic/utils/stdfilesystem.hpp>
 #include "../utils/json.hpp"
+#include <traintastic/enum/worldcompression.hpp>
 
 class World;
 class StateObject;
@@ -34,26 +37,83 @@ class CTWWriter;
 
 class WorldSaver
 {
+  friend class WorldJournal;
+
+  public:
+    enum class Format
+    {
+      JSON,
+      Binary, //!< see WorldBinary
+    };
+
+    using Progress = std::function<void(uint8_t percent)>;
+
+    static constexpr std::string_view dotTmp = ".tmp"; //!< suffix of a world that is being written
+    static constexpr std::string_view dotOld = ".old"; //!< suffix of a world directory that is being replaced
+
   private:
     nlohmann::json m_states;
     nlohmann::json m_data;
     nlohmann::json m_state;
     std::list<std::filesystem::path> m_deleteFiles;
     std::list<std::pair<std::filesystem::path, std::string>> m_writeFiles;
+    bool m_sorted = false;
 
-    WorldSaver(const World& world);
+    WorldSaver() = default; //!< for WorldJournal, no snapshot
 
-    void writeCTW(CTWWriter& ctw);
+    nlohmann::json saveState(const Object& object);
+    void sortObjects();
+    void writeCTW(CTWWriter& ctw, Format format, const Progress& progress);
 
     void deleteFiles(const std::filesystem::path& basePath);
     void writeFiles(const std::filesystem::path& basePath);
     static void saveToDisk(const nlohmann::json& data, const std::filesystem::path& filename);
     static void saveToDisk(const std::string& data, const std::filesystem::path& filename);
+    static void syncToDisk(const std::filesystem::path& filename);
+    static void syncDirectory(const std::filesystem::path& directory);
 
   public:
-    WorldSaver(const World& world, const std::filesystem::path& path);
+    /**
+     * \brief Take a snapshot of the world
+     *
+     * Only the snapshot requires the event loop, write() can run in any thread.
+     */
+    explicit WorldSaver(const World& world);
+
+    WorldSaver(const World& world, const std::filesystem::path& path, Format format = Format::JSON);
     WorldSaver(const World& world, std::vector<std::byte>& memory);
 
+    /**
+     * \brief Write snapshot to world file or directory
+     *
+     * Same as writeTemporary() followed by replace(), so an interrupted save
+     * never leaves a partial world.
+     *
+     * \param[in] path World file (.ctw) or directory
+     * \param[in] format World data format
+     * \param[in] compression World file compression, not used for a directory
+     * \param[in] progress Called with the progress in percent, in the calling thread
+     */
+    void write(const std::filesystem::path& path, Format format, WorldCompression compression, const Progress& progress = {});
+
+    /**
+     * \brief Write snapshot to \c <path>.tmp and sync it to disk
+     *
+     * The existing world at \a path isn't touched, progress is reported up to 90%.
+     *
+     * \return The temporary world file or directory, for replace()
+     */
+    std::filesystem::path writeTemporary(const std::filesystem::path& path, Format format, WorldCompression compression, const Progress& progress = {});
+
+    /**
+     * \brief Replace world file or directory by the one written by writeTemporary()
+     *
+     * A world file is replaced atomically. An existing world directory is
+     * renamed to \c <path>.old first and removed after the rename. The parent
+     * directory is synced, so the rename survives a crash.
+     */
+    static void replace(const std::filesystem::path& tmpPath, const std::filesystem::path& path);
+
     nlohmann::json saveObject(const ObjectPtr& object);
     nlohmann::json saveStateObject(const std::shared_ptr<StateObject>& object);
 
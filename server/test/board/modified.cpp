@@ -0,0 +1,188 @@
+/**
+ * server/test/board/modified.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/world/world.hpp"
+#include "../../src/core/method.tpp"
+#include "../../src/core/objectproperty.tpp"
+#include "../../src/board/board.hpp"
+#include "../../src/board/boardlist.hpp"
+#include "../../src/board/map/blockpath.hpp"
+#include "../../src/board/tile/rail/blockrailtile.hpp"
+#include "../../src/board/tile/rail/linkrailtile.hpp"
+#include "../../src/board/tile/rail/straightrailtile.hpp"
+
+static std::shared_ptr<BlockRailTile> getBlock(Board& board, TileLocation l)
+{
+  return std::dynamic_pointer_cast<BlockRailTile>(board.getTile(l));
+}
+
+static bool hasPath(const BlockRailTile& from, const std::shared_ptr<BlockRailTile>& to)
+{
+  for(const auto& path : from.paths())
+    if(path->toBlock() == to)
+      return true;
+  return false;
+}
+
+TEST_CASE("Board: modified, update changed part only", "[board]")
+{
+  auto world = World::create();
+  std::weak_ptr<World> worldWeak = world;
+
+  // Board:
+  // +--------+             +--------+
+  // | block1 |-------------| block2 |
+  // +--------+             +--------+
+  //
+  // +--------+    +--------+
+  // | block3 |----| block4 |
+  // +--------+    +--------+
+  auto board = world->boards->create();
+
+  REQUIRE(board->addTile(0, 0, TileRotate::Deg90, BlockRailTile::classId, false));
+  REQUIRE(board->addTile(1, 0, TileRotate::Deg90, StraightRailTile::classId, false));
+  REQUIRE(board->addTile(2, 0, TileRotate::Deg90, StraightRailTile::classId, false));
+  REQUIRE(board->addTile(3, 0, TileRotate::Deg90, StraightRailTile::classId, false));
+  REQUIRE(board->addTile(4, 0, TileRotate::Deg90, BlockRailTile::classId, false));
+
+  REQUIRE(board->addTile(0, 3, TileRotate::Deg90, BlockRailTile::classId, false));
+  REQUIRE(board->addTile(1, 3, TileRotate::Deg90, StraightRailTile::classId, false));
+  REQUIRE(board->addTile(2, 3, TileRotate::Deg90, BlockRailTile::classId, false));
+
+  auto block1 = getBlock(*board, {0, 0});
+  auto block2 = getBlock(*board, {4, 0});
+  auto block3 = getBlock(*board, {0, 3});
+  auto block4 = getBlock(*board, {2, 3});
+  REQUIRE(block1);
+  REQUIRE(block2);
+  REQUIRE(block3);
+  REQUIRE(block4);
+
+  world->run(); // this will build the board network
+  REQUIRE(hasPath(*block1, block2));
+  REQUIRE(hasPath(*block2, block1));
+  REQUIRE(hasPath(*block3, block4));
+  const BlockPath* path34 = block3->paths().front().get();
+  world->stop();
+
+  // break the connection between block1 and block2:
+  REQUIRE(board->deleteTile(2, 0));
+  world->run();
+  REQUIRE(block1->paths().empty());
+  REQUIRE(block2->paths().empty());
+  REQUIRE(block1->pathsIn().empty());
+  REQUIRE(block2->pathsIn().empty());
+  REQUIRE(block3->paths().front().get() == path34); // unchanged
+  world->stop();
+
+  // restore it:
+  REQUIRE(board->addTile(2, 0, TileRotate::Deg90, StraightRailTile::classId, false));
+  world->run();
+  REQUIRE(hasPath(*block1, block2));
+  REQUIRE(hasPath(*block2, block1));
+  world->stop();
+
+  // move block2 away from the track:
+  REQUIRE(board->moveTile(4, 0, 4, 1, TileRotate::Deg90, false));
+  world->run();
+  REQUIRE(block1->paths().empty());
+  REQUIRE(block2->paths().empty());
+  world->stop();
+
+  // and back again:
+  REQUIRE(board->moveTile(4, 1, 4, 0, TileRotate::Deg90, false));
+  world->run();
+  REQUIRE(hasPath(*block1, block2));
+  REQUIRE(hasPath(*block2, block1));
+  REQUIRE(block3->paths().front().get() == path34); // unchanged
+  world->stop();
+
+  // deleting a block removes its paths:
+  REQUIRE(block4->pathsIn().size() == 1);
+  REQUIRE(board->deleteTile(0, 3));
+  REQUIRE(block4->pathsIn().empty());
+
+  block1.reset();
+  block2.reset();
+  block3.reset();
+  block4.reset();
+  board.reset();
+  world.reset();
+  REQUIRE(worldWeak.expired());
+}
+
+TEST_CASE("Board: modified, link tile", "[board]")
+{
+  auto world = World::create();
+  std::weak_ptr<World> worldWeak = world;
+
+  // Board 1:                Board 2:
+  // +--------+                     +--------+
+  // | block1 |---[link1]  [link2]--| block2 |
+  // +--------+                     +--------+
+  auto board1 = world->boards->create();
+  REQUIRE(board1->addTile(0, 0, TileRotate::Deg90, BlockRailTile::classId, false));
+  REQUIRE(board1->addTile(1, 0, TileRotate::Deg90, StraightRailTile::classId, false));
+  REQUIRE(board1->addTile(2, 0, TileRotate::Deg90, LinkRailTile::classId, false));
+
+  auto board2 = world->boards->create();
+  REQUIRE(board2->addTile(0, 0, TileRotate::Deg270, LinkRailTile::classId, false));
+  REQUIRE(board2->addTile(1, 0, TileRotate::Deg90, BlockRailTile::classId, false));
+
+  auto block1 = getBlock(*board1, {0, 0});
+  auto block2 = getBlock(*board2, {1, 0});
+  auto link1 = std::dynamic_pointer_cast<LinkRailTile>(board1->getTile({2, 0}));
+  auto link2 = std::dynamic_pointer_cast<LinkRailTile>(board2->getTile({0, 0}));
+  REQUIRE(block1);
+  REQUIRE(block2);
+  REQUIRE(link1);
+  REQUIRE(link2);
+
+  world->run();
+  REQUIRE(block1->paths().empty());
+  REQUIRE(block2->paths().empty());
+  world->stop();
+
+  // only changing the link must update both boards:
+  link1->link = link2;
+  world->run();
+  REQUIRE(hasPath(*block1, block2));
+  REQUIRE(hasPath(*block2, block1));
+  world->stop();
+
+  link1->link = nullptr;
+  world->run();
+  REQUIRE(block1->paths().empty());
+  REQUIRE(block2->paths().empty());
+  world->stop();
+
+  block1.reset();
+  block2.reset();
+  link1.reset();
+  link2.reset();
+  board1.reset();
+  board2.reset();
+  world.reset();
+  REQUIRE(worldWeak.expired());
+}
@@ -0,0 +1,112 @@
+/**
+ * server/test/hardware/ecosmessages.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/hardware/protocol/ecos/messages.hpp"
+#include "../../src/utils/tokenizer.hpp"
+
+using namespace ECoS;
+
+TEST_CASE("ECoS: parse reply", "[ecos]")
+{
+  Reply reply;
+  REQUIRE(parseReply(
+    "<REPLY queryObjects(10, addr, name)>\r\n"
+    "1000 addr[3] name[\"BR 86, [1]\"]\r\n"
+    "1001 addr[78] protocol[DCC128]\r\n"
+    "<END 0 (OK)>\r\n", reply));
+  REQUIRE(reply.command == Command::queryObjects);
+  REQUIRE(reply.objectId == ObjectId::locomotiveManager);
+  REQUIRE(reply.options == "addr, name");
+  REQUIRE(reply.status == Status::Ok);
+  REQUIRE(reply.statusMessage == "OK");
+
+  Tokenizer lines(reply.lines, '\n');
+  std::string_view text;
+  std::string_view value;
+  Line line;
+
+  REQUIRE(lines.next(text));
+  REQUIRE(parseLine(text, line));
+  REQUIRE(line.objectId == 1000);
+  REQUIRE(line.find(Option::name, value));
+  REQUIRE(value == "BR 86, [1]");
+  REQUIRE_FALSE(line.find(Option::protocol, value));
+
+  REQUIRE(lines.next(text));
+  REQUIRE(parseLine(text, line));
+  REQUIRE(line.objectId == 1001);
+  REQUIRE(line.find(Option::protocol, value));
+  REQUIRE(value == "DCC128");
+
+  REQUIRE_FALSE(lines.next(text));
+}
+
+TEST_CASE("ECoS: parse reply without options", "[ecos]")
+{
+  Reply reply;
+  REQUIRE(parseReply("<REPLY get(1)>\r\n<END 15 (unknown object)>\r\n", reply));
+  REQUIRE(reply.command == Command::get);
+  REQUIRE(reply.objectId == ObjectId::ecos);
+  REQUIRE(reply.options.empty());
+  REQUIRE(reply.lines.empty());
+  REQUIRE(reply.status == Status::UnknownObject);
+  REQUIRE(reply.statusMessage == "unknown object");
+
+  REQUIRE_FALSE(parseReply("<REPLY get(1)>\r\n", reply));
+  REQUIRE_FALSE(parseReply("<EVENT 1>\r\n<END 0 (OK)>\r\n", reply));
+}
+
+TEST_CASE("ECoS: parse event", "[ecos]")
+{
+  Event event;
+  REQUIRE(parseEvent("<EVENT 11>\r\n11 msg[LIST_CHANGED]\r\n20000 appended\r\n<END 0 (OK)>\r\n", event));
+  REQUIRE(event.objectId == ObjectId::switchManager);
+  REQUIRE(event.status == Status::Ok);
+
+  Tokenizer lines(event.lines, '\n');
+  std::string_view text;
+  REQUIRE(lines.next(text));
+  REQUIRE(text == "11 msg[LIST_CHANGED]");
+  REQUIRE(lines.next(text));
+  REQUIRE(text == "20000 appended");
+  REQUIRE_FALSE(lines.next(text));
+}
+
+TEST_CASE("ECoS: parse request", "[ecos]")
+{
+  Request request;
+  REQUIRE(parseRequest("set(1000, speedstep[12], func[1,0])\n", request));
+  REQUIRE(request.command == Command::set);
+  REQUIRE(request.objectId == 1000);
+  REQUIRE(request.options.size() == 2);
+  REQUIRE(request.options[0] == "speedstep[12]");
+  REQUIRE(request.options[1] == "func[1,0]");
+}
+
+TEST_CASE("ECoS: build command", "[ecos]")
+{
+  REQUIRE(get(1, {Option::status, Option::name}).view() == "get(1, status, name)\n");
+  REQUIRE(set(1000, Option::speedStep, static_cast<uint8_t>(12)).view() == "set(1000, speedstep[12])\n");
+  REQUIRE(set(1000, Option::func, static_cast<uint8_t>(3), 1).view() == "set(1000, func[3,1])\n");
+  REQUIRE(set(11, Option::switch_, std::string_view{"DCC12g"}).view() == "set(11, switch[DCC12g])\n");
+}
@@ -0,0 +1,78 @@
+/**
+ * server/test/hardware/inputvalues.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/hardware/input/inputvalues.hpp"
+
+TEST_CASE("InputValues: set", "[inputvalues]")
+{
+  InputValues values(100);
+  REQUIRE(values[42] == TriState::Undefined);
+  REQUIRE(values.set(42, false));
+  REQUIRE(values[42] == TriState::False);
+  REQUIRE_FALSE(values.set(42, false));
+  REQUIRE(values.set(42, true));
+  REQUIRE(values[42] == TriState::True);
+  REQUIRE(values[43] == TriState::Undefined);
+
+  values.reset();
+  REQUIRE(values[42] == TriState::Undefined);
+}
+
+TEST_CASE("InputValues: update", "[inputvalues]")
+{
+  InputValues values(128);
+  InputValues::Changes changes;
+
+  // all inputs unknown, so all are changed:
+  values.update(60, 0b0101, 4, changes);
+  REQUIRE(changes.size() == 4);
+  REQUIRE(changes[0].index == 60);
+  REQUIRE(changes[0].value == TriState::True);
+  REQUIRE(changes[1].index == 61);
+  REQUIRE(changes[1].value == TriState::False);
+  REQUIRE(changes[3].index == 63);
+  REQUIRE(changes[3].value == TriState::False);
+
+  // no change:
+  changes.clear();
+  values.update(60, 0b0101, 4, changes);
+  REQUIRE(changes.empty());
+
+  // word boundary crossing:
+  changes.clear();
+  values.update(62, 0b1111, 4, changes);
+  REQUIRE(changes.size() == 3); // 62 was already true
+  REQUIRE(changes[0].index == 63);
+  REQUIRE(changes[1].index == 64);
+  REQUIRE(changes[2].index == 65);
+  REQUIRE(values[61] == TriState::False);
+  REQUIRE(values[64] == TriState::True);
+  REQUIRE(values[66] == TriState::Undefined);
+
+  // full word:
+  changes.clear();
+  values.update(64, ~uint64_t(0), 64, changes);
+  REQUIRE(changes.size() == 62);
+  REQUIRE(changes.front().index == 66);
+  REQUIRE(changes.back().index == 127);
+}
@@ -0,0 +1,115 @@
+/**
+ * server/test/hardware/marklincanlocomotivelist.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include "../../src/hardware/protocol/marklincan/locomotivelist.hpp"
+
+using namespace MarklinCAN;
+
+static constexpr std::string_view list =
+  "[lokomotive]\n"
+  "version\n"
+  " .minor=3\n"
+  "session\n"
+  " .id=1\n"
+  "lokomotive\n"
+  " .name=BR 86\n"
+  " .uid=0x4006\n"
+  " .adresse=0x6\n"
+  " .typ=mfx\n"
+  " .sid=0x6\n"
+  " .mfxuid=0x7a3c5e12\n"
+  " .funktionen\n"
+  " ..nr=0\n"
+  " ..typ=1\n"
+  " .funktionen\n"
+  " ..nr=1\n"
+  " .funktionen\n"
+  " ..nr=2\n"
+  " ..typ=237\n"
+  "lokomotive\n"
+  " .name=V 100\n"
+  " .adresse=0xc8\n"
+  " .typ=dcc\n"
+  " .funktionen_2\n"
+  " ..nr=3\n"
+  " ..typ=51\n"
+  "lokomotive\n"
+  " .name=Köf\n"
+  " .adresse=0x3\n"
+  " .typ=dcc\n";
+
+static void requireList(const LocomotiveList& locomotives)
+{
+  REQUIRE(locomotives.size() == 3);
+
+  REQUIRE(locomotives[0].name == "BR 86");
+  REQUIRE(locomotives[0].address == 6);
+  REQUIRE(locomotives[0].protocol == DecoderProtocol::MFX);
+  REQUIRE(locomotives[0].sid == 6);
+  REQUIRE(locomotives[0].mfxUID == 0x7a3c5e12);
+  REQUIRE(locomotives[0].functions.size() == 2); // function 1 has no typ, so it is unused
+  REQUIRE(locomotives[0].functions[0].nr == 0);
+  REQUIRE(locomotives[0].functions[0].type == DecoderFunctionType::OnOff);
+  REQUIRE(locomotives[0].functions[0].function == DecoderFunctionFunction::Light);
+  REQUIRE(locomotives[0].functions[1].nr == 2);
+  REQUIRE(locomotives[0].functions[1].type == DecoderFunctionType::Momentary);
+  REQUIRE(locomotives[0].functions[1].function == DecoderFunctionFunction::Mute);
+
+  REQUIRE(locomotives[1].name == "V 100");
+  REQUIRE(locomotives[1].address == 200);
+  REQUIRE(locomotives[1].protocol == DecoderProtocol::DCCLong);
+  REQUIRE(locomotives[1].functions.size() == 1);
+  REQUIRE(locomotives[1].functions[0].nr == 3);
+  REQUIRE(locomotives[1].functions[0].function == DecoderFunctionFunction::Generic);
+
+  REQUIRE(locomotives[2].name == "Köf");
+  REQUIRE(locomotives[2].address == 3);
+  REQUIRE(locomotives[2].protocol == DecoderProtocol::DCCShort);
+  REQUIRE(locomotives[2].functions.empty());
+}
+
+TEST_CASE("MarklinCAN: locomotive list", "[marklincan]")
+{
+  requireList(LocomotiveList(list));
+}
+
+TEST_CASE("MarklinCAN: locomotive list parser, chunked", "[marklincan]")
+{
+  for(size_t chunkSize : {1, 2, 5, 8, 13, 256})
+  {
+    LocomotiveList::Parser parser;
+    for(size_t i = 0; i < list.size(); i += chunkSize)
+    {
+      parser.parse(list.substr(i, std::min(chunkSize, list.size() - i)));
+    }
+    requireList(LocomotiveList(parser.finish(), {}));
+  }
+}
+
+TEST_CASE("MarklinCAN: locomotive list parser, invalid header", "[marklincan]")
+{
+  LocomotiveList::Parser parser;
+  parser.parse("[magnetartikel]\nlokomotive\n .name=BR 86\n");
+  REQUIRE(parser.finish().empty());
+}
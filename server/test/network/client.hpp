@@ -0,0 +1,103 @@
+/**
+ * server/test/network/client.hpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TRAINTASTIC_SERVER_TEST_NETWORK_CLIENT_HPP
+#define TRAINTASTIC_SERVER_TEST_NETWORK_CLIENT_HPP
+
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/websocket.hpp>
+#include <traintastic/network/message.hpp>
+#include "../../src/core/eventloop.hpp"
+#include "../../src/network/server.hpp"
+
+//! Minimal synchronous client, for testing the server's side of the protocol
+namespace TestClient {
+
+using WebSocket = boost::beast::websocket::stream<boost::asio::ip::tcp::socket>;
+
+inline uint16_t freePort()
+{
+  boost::asio::io_context ioContext;
+  boost::asio::ip::tcp::acceptor acceptor(ioContext, {boost::asio::ip::address_v4::loopback(), 0});
+  return acceptor.local_endpoint().port();
+}
+
+inline std::unique_ptr<WebSocket> connect(boost::asio::io_context& ioContext, uint16_t port)
+{
+  auto ws = std::make_unique<WebSocket>(ioContext);
+  ws->next_layer().connect({boost::asio::ip::address_v4::loopback(), port});
+  ws->handshake("localhost", "/client");
+  ws->binary(true);
+  return ws;
+}
+
+inline void send(WebSocket& ws, const Message& message)
+{
+  ws.write(boost::asio::buffer(*message, sizeof(Message::Header) + message.dataSize()));
+}
+
+inline std::unique_ptr<Message> receive(WebSocket& ws)
+{
+  boost::beast::flat_buffer buffer;
+  ws.read(buffer);
+  const auto& header = *reinterpret_cast<const Message::Header*>(buffer.cdata().data());
+  auto message = std::make_unique<Message>(header);
+  if(header.dataSize != 0)
+    std::memcpy(message->data(), static_cast<const std::byte*>(buffer.cdata().data()) + sizeof(header), message->dataSize());
+  return message;
+}
+
+inline std::unique_ptr<Message> login(WebSocket& ws, Message::Capabilities capabilities = Message::Capabilities::None)
+{
+  auto request = Message::newRequest(Message::Command::Login);
+  request->write(std::string_view{}); // username
+  request->write(std::string_view{}); // password
+  request->write(capabilities);
+  send(ws, *request);
+  return receive(ws);
+}
+
+//! Runs the client in a thread, the event loop must run in this thread.
+template<class Function>
+auto run(Function&& function)
+{
+  auto work = boost::asio::make_work_guard(EventLoop::ioContext);
+  auto client = std::async(std::launch::async, std::forward<Function>(function));
+  while(client.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready)
+    EventLoop::ioContext.run_for(std::chrono::milliseconds(10));
+  return client.get();
+}
+
+inline void waitForConnectionsGone(const Server& server)
+{
+  auto work = boost::asio::make_work_guard(EventLoop::ioContext);
+  const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while(server.connectionCount() != 0 && std::chrono::steady_clock::now() < timeout)
+    EventLoop::ioContext.run_for(std::chrono::milliseconds(10));
+}
+
+}
+
+#endif
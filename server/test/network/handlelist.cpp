@@ -0,0 +1,103 @@
+/**
+ * server/test/network/handlelist.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/network/handlelist.hpp"
+#include "../../src/world/world.hpp"
+#include "../../src/board/board.hpp"
+#include "../../src/board/boardlist.hpp"
+
+using Handles = HandleList<uint32_t, ObjectPtr>;
+
+TEST_CASE("HandleList: add, get and remove", "[handlelist]")
+{
+  auto world = World::create();
+  ObjectPtr board1 = world->boards->create();
+  ObjectPtr board2 = world->boards->create();
+
+  Handles handles;
+  const auto handle1 = handles.addItem(board1);
+  const auto handle2 = handles.addItem(board2);
+  REQUIRE(handle1 != Handles::invalidHandle);
+  REQUIRE(handle2 != Handles::invalidHandle);
+  REQUIRE(handle1 != handle2);
+  REQUIRE(handles.getCounter(handle1) == 1);
+
+  REQUIRE(handles.addItem(board1) == handle1);
+  REQUIRE(handles.getCounter(handle1) == 2);
+  REQUIRE(handles.getHandle(*board1) == handle1);
+  REQUIRE(handles.getHandle(board1) == handle1);
+  REQUIRE(handles.getCounter(handle1) == 4);
+
+  REQUIRE(handles.getItem(handle1) == board1);
+  REQUIRE(handles.getItem(handle2) == board2);
+
+  handles.removeHandle(handle1);
+  REQUIRE(handles.getItem(handle1) == nullptr);
+  REQUIRE(handles.getHandle(*board1) == Handles::invalidHandle);
+  REQUIRE(handles.getCounter(handle1) == 0);
+
+  handles.removeItem(board2);
+  REQUIRE(handles.getItem(handle2) == nullptr);
+}
+
+TEST_CASE("HandleList: released handles aren't reused", "[handlelist]")
+{
+  auto world = World::create();
+  ObjectPtr board = world->boards->create();
+
+  Handles handles;
+  const auto handle = handles.addItem(board);
+  handles.removeHandle(handle);
+  for(int i = 0; i < 10000; i++)
+  {
+    const auto h = handles.addItem(board);
+    REQUIRE(h != Handles::invalidHandle);
+    REQUIRE(h != handle);
+    handles.removeHandle(h);
+  }
+}
+
+TEST_CASE("HandleList: multiple lists", "[handlelist]")
+{
+  auto world = World::create();
+  ObjectPtr board = world->boards->create();
+
+  Handles handles1;
+  const auto handle1 = handles1.addItem(board);
+  {
+    Handles handles2;
+    handles2.addItem(board);
+    handles2.addItem(world);
+
+    size_t count = 0;
+    for(const auto& it : handles2)
+    {
+      REQUIRE(it.second);
+      REQUIRE(handles2.getItem(it.first) == it.second);
+      count++;
+    }
+    REQUIRE(count == 2);
+  }
+  REQUIRE(handles1.getHandle(*board) == handle1);
+  REQUIRE(handles1.getItem(handle1) == board);
+}
@@ -0,0 +1,102 @@
+/**
+ * server/test/network/headlessclient.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "client.hpp"
+#include "../../../benchmark/src/headlessclient.hpp"
+#include "../../src/traintastic/settings.hpp"
+#include "../../src/traintastic/traintastic.hpp"
+#include "../../src/world/world.hpp"
+
+using namespace TestClient;
+
+TEST_CASE("HeadlessClient: connect and set property", "[network][benchmark]")
+{
+  EventLoop::threadId = std::this_thread::get_id();
+  EventLoop::ioContext.restart();
+
+  const auto dataDir = std::filesystem::temp_directory_path() / "traintastic-h3c8qz";
+  std::filesystem::remove_all(dataDir);
+  Traintastic::instance = std::make_shared<Traintastic>(dataDir);
+  Traintastic::instance->settings = std::make_shared<Settings>(dataDir);
+  Traintastic::instance->newWorld();
+  const uint16_t port = freePort();
+  auto server = std::make_shared<Server>(true, port, false);
+
+  bool propertyIds = false;
+  SECTION("names")
+  {
+  }
+  SECTION("ids")
+  {
+    propertyIds = true;
+  }
+
+  const bool passed = run(
+    [port, propertyIds]()
+    {
+      boost::asio::io_context ioContext;
+      auto client = std::make_shared<HeadlessClient>(ioContext, false, propertyIds);
+      bool nameChanged = false;
+      client->onError =
+        [&ioContext](std::string_view /*error*/)
+        {
+          ioContext.stop();
+        };
+      client->connect("localhost", port,
+        [&](const HeadlessClient::ObjectPtr& traintastic)
+        {
+          if(!traintastic || client->propertyIds() != propertyIds)
+            return client->close();
+
+          client->getObject("traintastic.world",
+            [&](const HeadlessClient::ObjectPtr& world)
+            {
+              if(!world || !world->value("name"))
+                return client->close();
+
+              client->onPropertyChanged =
+                [&, world](HeadlessClient::Object& object, uint16_t itemId)
+                {
+                  if(object.handle != world->handle || itemId != world->itemIds.at("name"))
+                    return;
+                  const auto* name = std::get_if<std::string>(object.value("name"));
+                  nameChanged = name && *name == "headless";
+                  client->close();
+                };
+              client->setProperty(*world, "name", "headless");
+            });
+        });
+      ioContext.run_for(std::chrono::seconds(10));
+      return nameChanged;
+    });
+  REQUIRE(passed);
+  REQUIRE(Traintastic::instance->world->name.value() == "headless");
+
+  waitForConnectionsGone(*server);
+  REQUIRE(server->connectionCount() == 0);
+
+  server.reset();
+  Traintastic::instance->world = nullptr;
+  Traintastic::instance.reset();
+  std::filesystem::remove_all(dataDir);
+}
@@ -0,0 +1,108 @@
+/**
+ * server/test/network/propertyids.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <traintastic/enum/interfaceitemtype.hpp>
+#include "client.hpp"
+#include "../../src/traintastic/settings.hpp"
+#include "../../src/traintastic/traintastic.hpp"
+#include "../../src/world/world.hpp"
+
+using namespace TestClient;
+
+TEST_CASE("Server: property ids capability", "[network][session]")
+{
+  EventLoop::threadId = std::this_thread::get_id();
+  EventLoop::ioContext.restart();
+
+  const auto dataDir = std::filesystem::temp_directory_path() / "traintastic-w5n1pt";
+  std::filesystem::remove_all(dataDir);
+  Traintastic::instance = std::make_shared<Traintastic>(dataDir);
+  Traintastic::instance->settings = std::make_shared<Settings>(dataDir);
+  const uint16_t port = freePort();
+  auto server = std::make_shared<Server>(true, port, false);
+
+  bool propertyIds = false;
+  SECTION("names, client without capability")
+  {
+  }
+  SECTION("ids, client with capability")
+  {
+    propertyIds = true;
+  }
+  const uint16_t worldId = Traintastic::instance->world.id();
+
+  const bool passed = run(
+    [port, propertyIds, worldId]()
+    {
+      boost::asio::io_context ioContext;
+      auto ws = connect(ioContext, port);
+
+      auto response = login(*ws, propertyIds ? Message::Capabilities::PropertyIds : Message::Capabilities::None);
+      if(response->isError() || response->read<Message::Capabilities>() != (propertyIds ? Message::Capabilities::PropertyIds : Message::Capabilities::None))
+        return false;
+
+      send(*ws, *Message::newRequest(Message::Command::NewSession));
+      response = receive(*ws);
+      if(response->isError())
+        return false;
+      response->read<boost::uuids::uuid>();
+      response->readBlock(); // object
+      const auto handle = response->read<uint32_t>();
+      response->read<std::string_view>(); // class id
+      response->readBlock(); // items
+      response->readBlock(); // item
+      response->read<std::string_view>(); // name
+      if(propertyIds)
+        response->read<uint16_t>(); // id
+      const auto type = response->read<InterfaceItemType>();
+      if(type != InterfaceItemType::Property && type != InterfaceItemType::Method)
+        return false;
+
+      // world property changes:
+      EventLoop::call(
+        []()
+        {
+          Traintastic::instance->newWorld();
+        });
+      do
+      {
+        response = receive(*ws);
+      }
+      while(response->command() != Message::Command::ObjectPropertyChanged || response->read<uint32_t>() != handle);
+
+      const bool isWorld = propertyIds ? (response->read<uint16_t>() == worldId) : (response->read<std::string_view>() == "world");
+
+      ws->close(boost::beast::websocket::close_code::normal);
+      return isWorld;
+    });
+  REQUIRE(passed);
+
+  waitForConnectionsGone(*server);
+  REQUIRE(server->connectionCount() == 0);
+
+  server.reset();
+  Traintastic::instance->world = nullptr;
+  Traintastic::instance.reset();
+  std::filesystem::remove_all(dataDir);
+}
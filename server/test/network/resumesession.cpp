@@ -0,0 +1,120 @@
+/**
+ * server/test/network/resumesession.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "client.hpp"
+#include "../../src/traintastic/traintastic.hpp"
+
+using namespace TestClient;
+
+static std::unique_ptr<Message> resumeSession(WebSocket& ws, const boost::uuids::uuid& uuid, uint32_t receiveCount)
+{
+  auto request = Message::newRequest(Message::Command::ResumeSession);
+  request->write(uuid);
+  request->write(receiveCount);
+  send(ws, *request);
+  return receive(ws);
+}
+
+TEST_CASE("Server: resume session", "[network][session]")
+{
+  EventLoop::threadId = std::this_thread::get_id();
+  EventLoop::ioContext.restart();
+
+  const auto dataDir = std::filesystem::temp_directory_path() / "traintastic-3kq8vz";
+  Traintastic::instance = std::make_shared<Traintastic>(dataDir);
+  const uint16_t port = freePort();
+  auto server = std::make_shared<Server>(true, port, false);
+
+  const bool passed = run(
+    [port]()
+    {
+      boost::asio::io_context ioContext;
+
+      // create a session:
+      auto ws1 = connect(ioContext, port);
+      if(login(*ws1)->isError())
+        return false;
+      send(*ws1, *Message::newRequest(Message::Command::NewSession));
+      auto response = receive(*ws1);
+      if(response->command() != Message::Command::NewSession || response->isError())
+        return false;
+      const auto uuid = response->read<boost::uuids::uuid>();
+      const uint32_t receiveCount = 1; // the NewSession response
+
+      // connection is lost, server detaches the session:
+      boost::system::error_code ec;
+      ws1->next_layer().close(ec);
+
+      // resume detached session:
+      auto ws2 = connect(ioContext, port);
+      if(login(*ws2)->isError())
+        return false;
+      response = resumeSession(*ws2, uuid, receiveCount);
+      if(response->command() != Message::Command::ResumeSession || response->isError())
+        return false;
+
+      // connection is lost, but server doesn't know it yet:
+      auto ws3 = connect(ioContext, port);
+      if(login(*ws3)->isError())
+        return false;
+      auto request = Message::newRequest(Message::Command::ResumeSession);
+      request->write(uuid);
+      request->write(receiveCount + 1); // the ResumeSession response
+      send(*ws3, *request);
+
+      // server takes over the session and closes the old connection:
+      boost::beast::flat_buffer buffer;
+      ws2->async_read(buffer,
+        [&ec](const boost::system::error_code& readError, std::size_t /*bytesReceived*/)
+        {
+          ec = readError;
+        });
+      ioContext.run_for(std::chrono::seconds(5));
+      if(ec != boost::beast::websocket::error::closed)
+        return false;
+
+      response = receive(*ws3);
+      if(response->command() != Message::Command::ResumeSession || response->isError())
+        return false;
+
+      // unknown session:
+      auto ws4 = connect(ioContext, port);
+      if(login(*ws4)->isError())
+        return false;
+      response = resumeSession(*ws4, boost::uuids::uuid{}, 0);
+      if(!response->isError())
+        return false;
+
+      ws3->close(boost::beast::websocket::close_code::normal);
+      ws4->close(boost::beast::websocket::close_code::normal);
+      return true;
+    });
+  REQUIRE(passed);
+
+  waitForConnectionsGone(*server);
+  REQUIRE(server->connectionCount() == 0);
+
+  server.reset();
+  Traintastic::instance.reset();
+  std::filesystem::remove_all(dataDir);
+}
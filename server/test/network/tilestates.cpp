@@ -0,0 +1,138 @@
+/**
+ * server/test/network/tilestates.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <traintastic/board/tiledata.hpp>
+#include "client.hpp"
+#include "../../src/board/board.hpp"
+#include "../../src/board/boardlist.hpp"
+#include "../../src/board/tile/rail/straightrailtile.hpp"
+#include "../../src/core/method.tpp"
+#include "../../src/traintastic/settings.hpp"
+#include "../../src/traintastic/traintastic.hpp"
+#include "../../src/world/world.hpp"
+
+using namespace TestClient;
+
+TEST_CASE("Server: tile states capability", "[network][session]")
+{
+  EventLoop::threadId = std::this_thread::get_id();
+  EventLoop::ioContext.restart();
+
+  const auto dataDir = std::filesystem::temp_directory_path() / "traintastic-t7k2rw";
+  std::filesystem::remove_all(dataDir);
+  Traintastic::instance = std::make_shared<Traintastic>(dataDir);
+  Traintastic::instance->settings = std::make_shared<Settings>(dataDir);
+  Traintastic::instance->newWorld();
+  auto board = Traintastic::instance->world->boards->create();
+  REQUIRE(board->addTile(0, 0, TileRotate::Deg90, StraightRailTile::classId, false));
+  REQUIRE(board->addTile(1, 0, TileRotate::Deg90, StraightRailTile::classId, false));
+  const uint16_t port = freePort();
+  auto server = std::make_shared<Server>(true, port, false);
+
+  bool tileStates = false;
+  SECTION("tile data, client without capability")
+  {
+  }
+  SECTION("tile states, client with capability")
+  {
+    tileStates = true;
+  }
+
+  const bool passed = run(
+    [port, tileStates, boardId=board->id.value()]()
+    {
+      boost::asio::io_context ioContext;
+      auto ws = connect(ioContext, port);
+
+      auto response = login(*ws, tileStates ? Message::Capabilities::TileStates : Message::Capabilities::None);
+      if(response->isError() || response->read<Message::Capabilities>() != (tileStates ? Message::Capabilities::TileStates : Message::Capabilities::None))
+        return false;
+
+      send(*ws, *Message::newRequest(Message::Command::NewSession));
+      if(receive(*ws)->isError())
+        return false;
+
+      auto request = Message::newRequest(Message::Command::GetObject);
+      request->write(boardId);
+      send(*ws, *request);
+      response = receive(*ws);
+      if(response->isError())
+        return false;
+      response->readBlock(); // object
+      const auto handle = response->read<uint32_t>();
+
+      // reserve two tiles and release the first, in one event loop iteration:
+      EventLoop::call(
+        [boardId]()
+        {
+          auto b = std::dynamic_pointer_cast<Board>(Traintastic::instance->world->getObjectById(boardId));
+          std::static_pointer_cast<StraightRailTile>(b->getTile({0, 0}))->reserve();
+          std::static_pointer_cast<StraightRailTile>(b->getTile({1, 0}))->reserve();
+          std::static_pointer_cast<StraightRailTile>(b->getTile({0, 0}))->release();
+        });
+
+      const auto receiveTileChange =
+        [&ws, handle]()
+        {
+          std::unique_ptr<Message> message;
+          do
+          {
+            message = receive(*ws);
+          }
+          while((message->command() != Message::Command::BoardTileDataChanged && message->command() != Message::Command::BoardTileStatesChanged) || message->read<uint32_t>() != handle);
+          return message;
+        };
+
+      bool result = true;
+      if(tileStates)
+      {
+        // one message, merged:
+        auto message = receiveTileChange();
+        result = message->command() == Message::Command::BoardTileStatesChanged && message->read<uint32_t>() == 2;
+        for(const auto& [location, state] : {std::pair<TileLocation, uint8_t>{{0, 0}, 0}, {{1, 0}, 1}})
+          result = result && message->read<TileLocation>() == location && message->read<uint8_t>() == state;
+      }
+      else
+      {
+        // one message per change:
+        for(const auto& [location, state] : {std::pair<TileLocation, uint8_t>{{0, 0}, 1}, {{1, 0}, 1}, {{0, 0}, 0}})
+        {
+          auto message = receiveTileChange();
+          result = result && message->command() == Message::Command::BoardTileDataChanged && message->read<TileLocation>() == location && message->read<TileData>().state == state;
+        }
+      }
+
+      ws->close(boost::beast::websocket::close_code::normal);
+      return result;
+    });
+  REQUIRE(passed);
+
+  waitForConnectionsGone(*server);
+  REQUIRE(server->connectionCount() == 0);
+
+  server.reset();
+  board.reset();
+  Traintastic::instance->world = nullptr;
+  Traintastic::instance.reset();
+  std::filesystem::remove_all(dataDir);
+}
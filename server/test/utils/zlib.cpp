@@ -0,0 +1,67 @@
+/**
+ * server/test/utils/zlib.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include "../../src/utils/zlib.hpp"
+
+static std::string locomotiveListText(size_t count)
+{
+  std::string text = "[lokomotive]\nversion\n .minor=3\n";
+  for(size_t i = 0; i < count; i++)
+  {
+    text.append("lokomotive\n .name=BR 86 ").append(std::to_string(i)).append("\n .adresse=0x3\n .typ=mm2_prg\n");
+    for(int nr = 0; nr < 16; nr++)
+      text.append(" .funktionen\n ..nr=").append(std::to_string(nr)).append("\n ..typ=1\n");
+  }
+  return text;
+}
+
+TEST_CASE("ZLib: uncompress stream", "[zlib]")
+{
+  const std::string text = locomotiveListText(100);
+
+  std::vector<std::byte> compressed;
+  REQUIRE(ZLib::compress(text.data(), text.size(), compressed));
+  REQUIRE(compressed.size() < text.size() / 8);
+
+  for(size_t chunkSize : {1, 2, 3, 8, 64, 4096})
+  {
+    ZLib::Uncompress::Stream stream;
+    std::string out;
+    for(size_t i = 0; i < compressed.size(); i += chunkSize)
+    {
+      REQUIRE(stream.write(compressed.data() + i, std::min(chunkSize, compressed.size() - i), out));
+    }
+    REQUIRE(stream.end());
+    REQUIRE(out == text);
+  }
+}
+
+TEST_CASE("ZLib: uncompress stream, invalid data", "[zlib]")
+{
+  const std::string data = "this is not zlib compressed data";
+  ZLib::Uncompress::Stream stream;
+  std::string out;
+  REQUIRE_FALSE(stream.write(data.data(), data.size(), out));
+  REQUIRE_FALSE(stream.end());
+}
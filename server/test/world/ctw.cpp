@@ -0,0 +1,90 @@
+/**
+ * server/test/world/ctw.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/world/ctwreader.hpp"
+#include "../../src/world/ctwwriter.hpp"
+
+using nlohmann::json;
+
+static void testWriteRead(WorldCompression compression)
+{
+  json data = json::object();
+  data["uuid"] = "6d1e2a0c-5fb8-4b4b-9a0e-3c4b2a6e7f10";
+  data["objects"] = json::array();
+  for(int i = 0; i < 10000; i++) // larger than the read buffer
+    data["objects"].push_back({{"id", "object_" + std::to_string(i)}, {"value", i}});
+  const json state = {{"states", json::object()}};
+  const std::string script = "log.info('hello')";
+
+  std::vector<std::byte> memory;
+  {
+    CTWWriter ctw(memory, compression);
+    ctw.writeFile("traintastic.json", data);
+    ctw.writeFile("traintastic.state.json", state);
+    ctw.writeFile("lua/script_1.lua", script);
+  }
+
+  SECTION("in order")
+  {
+    CTWReader ctw(memory);
+    json json;
+    REQUIRE(ctw.readFile("traintastic.json", json));
+    REQUIRE(json == data);
+    REQUIRE(ctw.readFile("traintastic.state.json", json));
+    REQUIRE(json == state);
+    std::string text;
+    REQUIRE(ctw.readFile("lua/script_1.lua", text));
+    REQUIRE(text == script);
+    REQUIRE_FALSE(ctw.readFile("lua/script_2.lua", text));
+  }
+
+  SECTION("out of order")
+  {
+    CTWReader ctw(memory);
+    std::string text;
+    REQUIRE_FALSE(ctw.readFile("traintastic.bin", text));
+    REQUIRE(ctw.readFile("lua/script_1.lua", text));
+    REQUIRE(text == script);
+    json json;
+    REQUIRE(ctw.readFile("traintastic.state.json", json));
+    REQUIRE(json == state);
+    REQUIRE(ctw.readFile("traintastic.json", json));
+    REQUIRE(json == data);
+  }
+}
+
+TEST_CASE("CTW: write => read, uncompressed", "[world][ctw]")
+{
+  testWriteRead(WorldCompression::None);
+}
+
+TEST_CASE("CTW: write => read, xz", "[world][ctw]")
+{
+  testWriteRead(WorldCompression::XZ);
+}
+
+TEST_CASE("CTW: write => read, zstd", "[world][ctw]")
+{
+  testWriteRead(WorldCompression::Zstd);
+}
@@ -0,0 +1,111 @@
+/**
+ * server/test/world/worldbinary.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include "../../src/world/worldbinary.hpp"
+
+using nlohmann::json;
+
+TEST_CASE("WorldBinary: write => read", "[world][world-binary]")
+{
+  json document = json::object();
+  document["uuid"] = "6d1e2a0c-5fb8-4b4b-9a0e-3c4b2a6e7f10";
+  document["name"] = "Test";
+  document["objects"] = json::array();
+  for(int i = 0; i < 100; i++)
+  {
+    json object = json::object();
+    object["id"] = "object_" + std::to_string(i);
+    object["class_id"] = "test";
+    object["value"] = i;
+    object["items"] = json::array({1.5, "two", true});
+    document["objects"].push_back(std::move(object));
+  }
+
+  const std::string data = WorldBinary::write(document);
+  REQUIRE(WorldBinary::isBinary(data));
+  REQUIRE_FALSE(WorldBinary::isBinary(document.dump()));
+
+  WorldBinary::Reader reader(data);
+  REQUIRE(reader.header()["uuid"] == document["uuid"]);
+  REQUIRE(reader.header()["name"] == document["name"]);
+  REQUIRE_FALSE(reader.header().contains("objects"));
+
+  REQUIRE(reader.objects().size() == document["objects"].size());
+  for(size_t i = 0; i < reader.objects().size(); i++)
+  {
+    REQUIRE(reader.objects()[i].id == document["objects"][i]["id"].get<std::string>());
+    REQUIRE(WorldBinary::Reader::parse(reader.objects()[i]) == document["objects"][i]);
+  }
+}
+
+TEST_CASE("WorldBinary: parse all objects", "[world][world-binary]")
+{
+  json document = json::object();
+  document["objects"] = json::array();
+  for(int i = 0; i < 5000; i++) // enough to use multiple threads
+  {
+    json object = json::object();
+    object["id"] = "object_" + std::to_string(i);
+    object["class_id"] = "test";
+    object["value"] = i;
+    document["objects"].push_back(std::move(object));
+  }
+
+  WorldBinary::Reader reader(WorldBinary::write(document));
+  const auto objects = reader.parseObjects();
+  REQUIRE(objects.size() == document["objects"].size());
+  for(size_t i = 0; i < objects.size(); i++)
+    REQUIRE(objects[i] == document["objects"][i]);
+}
+
+TEST_CASE("WorldBinary: write => read, no objects", "[world][world-binary]")
+{
+  json document = json::object();
+  document["uuid"] = "6d1e2a0c-5fb8-4b4b-9a0e-3c4b2a6e7f10";
+
+  WorldBinary::Reader reader(WorldBinary::write(document));
+  REQUIRE(reader.header() == document);
+  REQUIRE(reader.objects().empty());
+}
+
+TEST_CASE("WorldBinary: invalid data", "[world][world-binary]")
+{
+  REQUIRE_THROWS(WorldBinary::Reader(""));
+  REQUIRE_THROWS(WorldBinary::Reader("{\"uuid\": \"\"}"));
+
+  json document = json::object();
+  document["objects"] = json::array({json::object({{"id", "a"}, {"class_id", "test"}})});
+  const std::string data = WorldBinary::write(document);
+
+  for(size_t size = 0; size < data.size(); size++) // every truncation must be detected
+    REQUIRE_THROWS(WorldBinary::Reader(data.substr(0, size)));
+
+  std::string wrongVersion = data;
+  wrongVersion[WorldBinary::magic.size()]++;
+  REQUIRE_THROWS(WorldBinary::Reader(wrongVersion));
+
+  std::string hugeCount = data;
+  std::fill_n(hugeCount.begin() + WorldBinary::magic.size() + 4, 4, '\xFF'); // object count
+  REQUIRE_THROWS_WITH(WorldBinary::Reader(hugeCount), "binary world data truncated");
+}
@@ -0,0 +1,181 @@
+/**
+ * server/test/world/worldjournal.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <fstream>
+#include "../../src/world/worldjournal.hpp"
+#include "../../src/world/world.hpp"
+#include "../../src/world/worldlist.hpp"
+#include "../../src/world/worldsaver.hpp"
+#include "../../src/clock/clock.hpp"
+#include "../../src/core/objectproperty.tpp"
+#include "../../src/core/eventloop.hpp"
+#include "../../src/traintastic/settings.hpp"
+#include "../../src/traintastic/traintastic.hpp"
+
+using nlohmann::json;
+
+static constexpr std::string_view uuid = "6d1e2a0c-5fb8-4b4b-9a0e-3c4b2a6e7f10";
+
+static void writeFile(const std::filesystem::path& filename, std::string_view data)
+{
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  file.write(data.data(), data.size());
+}
+
+TEST_CASE("WorldJournal: path", "[world][world-journal]")
+{
+  REQUIRE(WorldJournal::path("worlds/abc") == std::filesystem::path("worlds/abc.journal"));
+  REQUIRE(WorldJournal::path("worlds/abc.ctw") == std::filesystem::path("worlds/abc.journal"));
+}
+
+TEST_CASE("WorldJournal: read", "[world][world-journal]")
+{
+  const auto filename = std::filesystem::temp_directory_path() / "traintastic-p4xw0e.journal";
+
+  writeFile(filename,
+    "{\"uuid\":\"6d1e2a0c-5fb8-4b4b-9a0e-3c4b2a6e7f10\"}\n"
+    "{\"id\":\"a\",\"sequence\":1,\"state\":{\"value\":1}}\n"
+    "{\"id\":\"b\",\"sequence\":2,\"state\":{\"value\":2}}\n"
+    "{\"id\":\"a\",\"sequence\":3,\"state\":{\"value\":3}}\n");
+
+  SECTION("all")
+  {
+    const auto records = WorldJournal::read(filename, uuid, 0);
+    REQUIRE(records.size() == 3);
+    REQUIRE(records[0]["id"] == "a");
+    REQUIRE(records[2]["state"]["value"] == 3);
+  }
+
+  SECTION("after sequence")
+  {
+    const auto records = WorldJournal::read(filename, uuid, 2);
+    REQUIRE(records.size() == 1);
+    REQUIRE(records[0]["sequence"] == 3);
+  }
+
+  SECTION("other world")
+  {
+    REQUIRE(WorldJournal::read(filename, "00000000-0000-0000-0000-000000000000", 0).empty());
+  }
+
+  SECTION("no file")
+  {
+    REQUIRE(WorldJournal::read(filename.parent_path() / "traintastic-doesnotexist.journal", uuid, 0).empty());
+  }
+
+  std::filesystem::remove(filename);
+}
+
+TEST_CASE("WorldJournal: read, interrupted append", "[world][world-journal]")
+{
+  const auto filename = std::filesystem::temp_directory_path() / "traintastic-9vkq2m.journal";
+
+  writeFile(filename,
+    "{\"uuid\":\"6d1e2a0c-5fb8-4b4b-9a0e-3c4b2a6e7f10\"}\n"
+    "{\"id\":\"a\",\"sequence\":1,\"state\":{\"value\":1}}\n"
+    "{\"id\":\"b\",\"sequence\":2,\"state\":{\"val");
+
+  const auto records = WorldJournal::read(filename, uuid, 0);
+  REQUIRE(records.size() == 1);
+  REQUIRE(records[0]["id"] == "a");
+
+  std::filesystem::remove(filename);
+}
+
+TEST_CASE("WorldJournal: record => read => saved", "[world][world-journal]")
+{
+  const auto filename = std::filesystem::temp_directory_path() / "traintastic-r7d3ua.journal";
+  std::filesystem::remove(filename);
+
+  auto world = World::create();
+  const std::string clockId = world->clock->getObjectId();
+
+  {
+    WorldJournal journal(*world, filename, 10);
+    REQUIRE(journal.sequence() == 10);
+
+    world->clock->hour = 12;
+    journal.changed(*world->clock);
+    journal.flush();
+    REQUIRE(journal.sequence() == 11);
+  } // writes and syncs on destruction
+
+  auto records = WorldJournal::read(filename, world->uuid.value(), 10);
+  REQUIRE(records.size() == 1);
+  REQUIRE(records[0]["id"] == clockId);
+  REQUIRE(records[0]["sequence"] == 11);
+  REQUIRE(records[0]["state"]["hour"] == 12);
+
+  // continue, as after loading the world:
+  {
+    WorldJournal journal(*world, filename, 10, std::move(records));
+    REQUIRE(journal.sequence() == 11);
+
+    world->clock->hour = 13;
+    journal.changed(*world->clock);
+    journal.flush();
+    REQUIRE(journal.sequence() == 12);
+
+    journal.saved(11); // hour 13 isn't included in the save
+  }
+
+  records = WorldJournal::read(filename, world->uuid.value(), 0);
+  REQUIRE(records.size() == 1);
+  REQUIRE(records[0]["sequence"] == 12);
+  REQUIRE(records[0]["state"]["hour"] == 13);
+
+  std::filesystem::remove(filename);
+}
+
+TEST_CASE("WorldJournal: load same world again", "[world][world-journal]")
+{
+  EventLoop::threadId = std::this_thread::get_id();
+
+  const auto dataDir = std::filesystem::temp_directory_path() / "traintastic-m2c8wd";
+  std::filesystem::remove_all(dataDir);
+
+  Traintastic::instance = std::make_shared<Traintastic>(dataDir);
+  auto& traintastic = Traintastic::instance;
+  traintastic->settings = std::make_shared<Settings>(dataDir);
+
+  std::string worldUUID;
+  {
+    auto world = World::create();
+    worldUUID = world->uuid.value();
+    WorldSaver(*world).write(traintastic->worldDir() / worldUUID, WorldSaver::Format::JSON, WorldCompression::None);
+    world->destroy();
+  }
+  traintastic->worldList = std::make_shared<WorldList>(traintastic->worldDir());
+
+  traintastic->loadWorld(worldUUID);
+  REQUIRE(traintastic->world);
+  traintastic->world->clock->hour = 12; // journaled, not flushed yet
+
+  traintastic->loadWorld(worldUUID);
+  REQUIRE(traintastic->world);
+  REQUIRE(traintastic->world->clock->hour.value() == 12);
+
+  traintastic->world = nullptr;
+  traintastic.reset();
+  std::filesystem::remove_all(dataDir);
+}
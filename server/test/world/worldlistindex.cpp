@@ -0,0 +1,136 @@
+/**
+ * server/test/world/worldlistindex.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <fstream>
+#include <boost/uuid/string_generator.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include "../../src/world/worldlist.hpp"
+#include "../../src/core/tablemodel.hpp"
+#include "../../src/world/ctwwriter.hpp"
+#include "../../src/world/world.hpp"
+#include "../../src/world/worldsaver.hpp"
+
+using nlohmann::json;
+
+static const auto uuidA = boost::uuids::string_generator()("0b0f6a1c-1d2e-4b6f-9c3a-5e7d8f9a0b1c");
+static const auto uuidB = boost::uuids::string_generator()("7c2e4d6f-8a9b-4c1d-a3e5-f7091b2c3d4e");
+
+static void writeCTW(const std::filesystem::path& filename, const boost::uuids::uuid& uuid, std::string_view name)
+{
+  CTWWriter ctw(filename);
+  ctw.writeFile(World::filename, json::object({{"uuid", to_string(uuid)}, {"name", name}}));
+}
+
+static json readIndex(const std::filesystem::path& path)
+{
+  std::ifstream file(path / WorldList::indexFilename);
+  return json::parse(file);
+}
+
+static void writeIndex(const std::filesystem::path& path, const json& index)
+{
+  std::ofstream file(path / WorldList::indexFilename, std::ios::trunc);
+  file << index.dump();
+}
+
+TEST_CASE("WorldList: index", "[worldlist]")
+{
+  const auto path = std::filesystem::temp_directory_path() / "traintastic-k3v8qz";
+  std::filesystem::remove_all(path);
+  std::filesystem::create_directories(path / "b");
+
+  writeCTW(path / "a.ctw", uuidA, "World A");
+  {
+    std::ofstream file(path / "b" / World::filename);
+    file << json::object({{"uuid", to_string(uuidB)}, {"name", "World B"}}).dump();
+  }
+
+  {
+    auto worldList = std::make_shared<WorldList>(path);
+    REQUIRE(worldList->find(uuidA));
+    REQUIRE(worldList->find(uuidA)->name == "World A");
+    REQUIRE(worldList->find(uuidB));
+    REQUIRE(worldList->find(uuidB)->name == "World B");
+  }
+
+  auto index = readIndex(path);
+  REQUIRE(index["worlds"].size() == 2);
+  REQUIRE(index["worlds"]["a.ctw"]["name"] == "World A");
+
+  SECTION("unmodified world is not read")
+  {
+    index["worlds"]["a.ctw"]["name"] = "Cached";
+    writeIndex(path, index);
+
+    auto worldList = std::make_shared<WorldList>(path);
+    REQUIRE(worldList->find(uuidA));
+    REQUIRE(worldList->find(uuidA)->name == "Cached");
+  }
+
+  SECTION("modified world is read")
+  {
+    const auto mtime = std::filesystem::last_write_time(path / "a.ctw");
+    writeCTW(path / "a.ctw", uuidA, "World A2");
+    std::filesystem::last_write_time(path / "a.ctw", mtime + std::chrono::seconds(10));
+
+    auto worldList = std::make_shared<WorldList>(path);
+    REQUIRE(worldList->find(uuidA));
+    REQUIRE(worldList->find(uuidA)->name == "World A2");
+    REQUIRE(readIndex(path)["worlds"]["a.ctw"]["name"] == "World A2");
+  }
+
+  SECTION("removed world")
+  {
+    auto worldList = std::make_shared<WorldList>(path);
+    std::filesystem::remove_all(path / "b");
+
+    auto model = worldList->getModel(); // rescans
+    REQUIRE(model->rowCount() == 1);
+    REQUIRE_FALSE(worldList->find(uuidB));
+    REQUIRE_FALSE(readIndex(path)["worlds"].contains("b"));
+  }
+
+  SECTION("invalid index")
+  {
+    std::ofstream(path / WorldList::indexFilename, std::ios::trunc) << "{";
+
+    auto worldList = std::make_shared<WorldList>(path);
+    REQUIRE(worldList->find(uuidA));
+    REQUIRE(worldList->find(uuidB));
+    REQUIRE(readIndex(path)["worlds"].size() == 2);
+  }
+
+  SECTION("world being saved")
+  {
+    std::filesystem::copy(path / "b", std::filesystem::path(path / "b") += WorldSaver::dotTmp);
+    std::filesystem::copy(path / "b", std::filesystem::path(path / "b") += WorldSaver::dotOld);
+
+    auto worldList = std::make_shared<WorldList>(path);
+    auto model = worldList->getModel();
+    REQUIRE(model->rowCount() == 2);
+    REQUIRE(readIndex(path)["worlds"].size() == 2);
+    REQUIRE_FALSE(std::filesystem::exists(std::filesystem::path(path / WorldList::indexFilename) += WorldSaver::dotTmp));
+  }
+
+  std::filesystem::remove_all(path);
+}
@@ -0,0 +1,52 @@
+/**
+ * server/test/world/worldsaver.cpp
+ *
+ * This file is part of the traintastic test suite.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/world/world.hpp"
+#include "../../src/world/worldsaver.hpp"
+
+TEST_CASE("WorldSaver: write directory => replace", "[world][world-saver]")
+{
+  auto world = World::create();
+  const auto directory = std::filesystem::temp_directory_path() / std::string(world->uuid.value());
+  const auto tmpPath = std::filesystem::path(directory) += ".tmp";
+  std::filesystem::remove_all(directory);
+
+  WorldSaver(*world).write(directory, WorldSaver::Format::JSON, WorldCompression::None);
+  REQUIRE(std::filesystem::is_regular_file(directory / World::filename));
+
+  {
+    WorldSaver saver(*world);
+    REQUIRE(saver.writeTemporary(directory, WorldSaver::Format::Binary, WorldCompression::None) == tmpPath);
+    REQUIRE(std::filesystem::is_regular_file(tmpPath / World::filenameBinary));
+    REQUIRE(std::filesystem::is_regular_file(directory / World::filename)); // not touched yet
+
+    WorldSaver::replace(tmpPath, directory);
+    REQUIRE_FALSE(std::filesystem::exists(tmpPath));
+    REQUIRE_FALSE(std::filesystem::exists(std::filesystem::path(directory) += ".old"));
+    REQUIRE(std::filesystem::is_regular_file(directory / World::filenameBinary));
+    REQUIRE_FALSE(std::filesystem::exists(directory / World::filename));
+  }
+
+  std::filesystem::remove_all(directory);
+}
@@ -95,6 +95,8 @@ enum class LogMessage : uint32_t
   I1007_X = LogMessageOffset::info + 1007, //!< nlohmann::json version
   I1008_X = LogMessageOffset::info + 1008, //!< LibArchive version
   I1009_ZLIB_X = LogMessageOffset::info + 1009, //!< zlib version
+  I1010_STARTUP_PHASE_X_TOOK_X_MS_X_ALLOCATIONS = LogMessageOffset::info + 1010,
+  I1011_STARTUP_TOOK_X_MS_X_ALLOCATIONS = LogMessageOffset::info + 1011,
   I2001_UNKNOWN_LOCO_ADDRESS_X = LogMessageOffset::info + 2001,
   I2002_HARDWARE_TYPE_X = LogMessageOffset::info + 2002,
   I2003_FIRMWARE_VERSION_X = LogMessageOffset::info + 2003,
@@ -136,6 +138,7 @@ enum class LogMessage : uint32_t
   N1026_IMPORTED_WORLD_SUCCESSFULLY = LogMessageOffset::notice + 1026,
   N1027_LOADED_WORLD_X = LogMessageOffset::notice + 1027,
   N1028_CLOSED_WORLD = LogMessageOffset::notice + 1028,
+  N1029_RESTORED_X_STATE_CHANGES_FROM_JOURNAL = LogMessageOffset::notice + 1029,
   N2001_SIMULATION_NOT_SUPPORTED = LogMessageOffset::notice + 2001,
   N2002_NO_RESPONSE_FROM_LNCV_MODULE_X_WITH_ADDRESS_X = LogMessageOffset::notice + 2002,
   N2003_STOPPED_SENDING_FAST_CLOCK_SYNC = LogMessageOffset::notice + 2003,
@@ -157,6 +160,7 @@ enum class LogMessage : uint32_t
   W1002_SETTING_X_DOESNT_EXIST = LogMessageOffset::warning + 1002,
   W1003_READING_WORLD_X_FAILED_LIBARCHIVE_ERROR_X_X = LogMessageOffset::warning + 1003,
   W1004_SETTING_FILE_EMPTY_OR_CORRUPT_USING_DEFAULTS = LogMessageOffset::warning + 1004,
+  W1005_CLIENT_CANT_KEEP_UP_X_BYTES_QUEUED = LogMessageOffset::warning + 1005,
   W2001_RECEIVED_MALFORMED_DATA_DROPPED_X_BYTES = LogMessageOffset::warning + 2001,
   W2002_COMMAND_STATION_DOESNT_SUPPORT_FUNCTIONS_ABOVE_FX = LogMessageOffset::warning + 2002,
   W2003_RECEIVED_MALFORMED_DATA_DROPPED_X_BYTES_X = LogMessageOffset::warning + 2003,
@@ -183,6 +187,8 @@ enum class LogMessage : uint32_t
   E1006_SOCKET_WRITE_FAILED_X = LogMessageOffset::error + 1006,
   E1007_SOCKET_READ_FAILED_X = LogMessageOffset::error + 1007,
   E1008_SOCKET_ACCEPTOR_CANCEL_FAILED_X = LogMessageOffset::error + 1008,
+  E1009_CLIENT_WRITE_QUEUE_FULL_X_BYTES_DISCONNECTING = LogMessageOffset::error + 1009,
+  E1010_WRITING_WORLD_JOURNAL_X_FAILED_X = LogMessageOffset::error + 1010,
   E2001_SERIAL_WRITE_FAILED_X = LogMessageOffset::error + 2001,
   E2002_SERIAL_READ_FAILED_X = LogMessageOffset::error + 2002,
   E2003_MAKE_ADDRESS_FAILED_X = LogMessageOffset::error + 2003,
@@ -241,6 +247,7 @@ enum class LogMessage : uint32_t
   C1018_EXCEPTION_X = LogMessageOffset::critical + 1018,
   C1019_OBJECT_NOT_A_TABLE = LogMessageOffset::critical + 1019,
   C1020_LOADING_SETTINGS_FAILED_X = LogMessageOffset::critical + 1020,
+  C1021_UNKNOWN_SESSION = LogMessageOffset::critical + 1021,
   C2001_ADDRESS_ALREADY_USED_AT_X = LogMessageOffset::critical + 2001,
   C2004_CANT_GET_FREE_SLOT = LogMessageOffset::critical + 2004,
   C2005_SOCKETCAN_IS_ONLY_AVAILABLE_ON_LINUX = LogMessageOffset::critical + 2005,
@@ -0,0 +1,44 @@
+/**
+ * shared/src/traintastic/enum/worldcompression.hpp
+ *
+ * This file is part of the traintastic source code.
+ *
+ * Copyright (C) 2026 Reinder Feenstra
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef TRAINTASTIC_SHARED_TRAINTASTIC_ENUM_WORLDCOMPRESSION_HPP
+#define TRAINTASTIC_SHARED_TRAINTASTIC_ENUM_WORLDCOMPRESSION_HPP
+
+#include <cstdint>
+#include "enum.hpp"
+
+enum class WorldCompression : uint8_t
+{
+  None = 0, //!< Uncompressed tar, fastest
+  XZ = 1,   //!< Smallest, readable by all versions
+  Zstd = 2, //!< Fast compression, small
+};
+
+TRAINTASTIC_ENUM(WorldCompression, "world_compression", 3,
+{
+  {WorldCompression::None, "none"},
+  {WorldCompression::XZ, "xz"},
+  {WorldCompression::Zstd, "zstd"},
+});
+
+#endif
@@ -23,10 +23,13 @@
 #ifndef TRAINTASTIC_SHARED_TRAINTASTIC_NETWORK_MESSAGE_HPP
 #define TRAINTASTIC_SHARED_TRAINTASTIC_NETWORK_MESSAGE_HPP
 
+#include <algorithm>
 #include <vector>
+#include <array>
 #include <string>
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <stack>
 #include <cstdint>
 #include <cstring>
@@ -47,6 +50,7 @@ class Message
       Ping = 1,
       Login = 2,
       NewSession = 3,
+      ResumeSession = 49,
       ServerLog = 5,
       ImportWorld = 9,
       ExportWorld = 10,
@@ -76,6 +80,7 @@ class Message
       BoardGetTileData = 37,
       BoardTileDataChanged = 38,
       BoardGetTileInfo = 43,
+      BoardTileStatesChanged = 48,
 
       ObjectGetObjectPropertyObject = 44,
       ObjectGetObjectVectorPropertyObject = 45,
@@ -92,6 +97,16 @@ class Message
       Response = 2,
       Event = 3,
     };
+
+    //! Client capabilities, optional field at the end of the login request, the login response contains the ones the server uses
+    enum class Capabilities : uint32_t
+    {
+      None = 0,
+      MultiMessageFrame = 1 << 0, //!< client can process multiple messages in one WebSocket frame
+      CompressedMessages = 1 << 1, //!< client can process compressed messages: 32 bit big endian uncompressed size + zlib data
+      PropertyIds = 1 << 2, //!< properties and attributes are referenced by interface item id instead of name
+      TileStates = 1 << 3, //!< client can process BoardTileStatesChanged, else tile state changes are sent as BoardTileDataChanged
+    };
 #ifdef _MSC_VER
   #pragma pack(push, 1)
 #endif
@@ -100,7 +115,8 @@ class Message
       Command command;
       struct Flags
       {
-        uint8_t reserved : 5; // must be zero
+        uint8_t reserved : 4; // must be zero
+        uint8_t compressed : 1; //!< data is compressed, see Capabilities::CompressedMessages
         uint8_t error : 1;
         uint8_t type : 2;
       } flags;
@@ -117,12 +133,82 @@ class Message
     static_assert(sizeof(Header) == 8);
 
   private:
+    /**
+     * @brief Pool of message buffers
+     *
+     * Buffers of destroyed messages are kept per size class and reused for
+     * new messages, so sending messages doesn't allocate in steady state.
+     * Messages are created and destroyed in different threads, so it is
+     * guarded by a mutex.
+     */
+    class BufferPool
+    {
+      private:
+        static constexpr std::array<size_t, 5> sizeClasses{{256, 1024, 4096, 16384, 65536}};
+        static constexpr size_t buffersPerClassMax = 64;
+
+        std::mutex m_mutex;
+        std::array<std::vector<std::vector<uint8_t>>, sizeClasses.size()> m_buffers;
+
+      public:
+        std::vector<uint8_t> get(size_t capacity)
+        {
+          for(size_t i = 0; i < sizeClasses.size(); i++)
+          {
+            if(capacity <= sizeClasses[i])
+            {
+              {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if(!m_buffers[i].empty())
+                {
+                  std::vector<uint8_t> buffer = std::move(m_buffers[i].back());
+                  m_buffers[i].pop_back();
+                  return buffer;
+                }
+              }
+              capacity = sizeClasses[i];
+              break;
+            }
+          }
+          std::vector<uint8_t> buffer;
+          buffer.reserve(capacity);
+          return buffer;
+        }
+
+        void release(std::vector<uint8_t>&& buffer)
+        {
+          for(size_t i = sizeClasses.size(); i-- > 0;)
+          {
+            if(buffer.capacity() >= sizeClasses[i])
+            {
+              if(buffer.capacity() <= 2 * sizeClasses[i]) // don't keep (very) large buffers
+              {
+                buffer.clear();
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if(m_buffers[i].size() < buffersPerClassMax)
+                  m_buffers[i].emplace_back(std::move(buffer));
+              }
+              return;
+            }
+          }
+        }
+    };
+
     inline static std::atomic<uint16_t> s_requestId{0};
+    inline static BufferPool s_bufferPool;
+    inline static std::array<std::atomic<uint32_t>, 256> s_sizeHint{}; //!< recent message size per command
+
+    static std::vector<uint8_t> allocate(size_t size, size_t capacity)
+    {
+      auto buffer = s_bufferPool.get(std::max(size, capacity));
+      buffer.resize(size);
+      return buffer;
+    }
 
   protected:
     std::vector<uint8_t> m_data;
     mutable uint32_t m_readPosition;
-    mutable std::stack<uint32_t> m_block;
+    mutable std::stack<uint32_t, std::vector<uint32_t>> m_block;
 
     const Header& header() const { return *reinterpret_cast<const Header*>(m_data.data()); }
     Header& header() { return *reinterpret_cast<Header*>(m_data.data()); }
@@ -183,35 +269,46 @@ class Message
     }
 
     Message(const Header& _header) :
-      m_data(sizeof(Header) + _header.dataSize, 0),
+      m_data{allocate(sizeof(Header) + _header.dataSize, 0)},
       m_readPosition{0}
     {
       header() = _header;
     }
 
+    /**
+     * @param[in] capacity Expected data size, if zero the size of recent
+     *                     messages with the same command is used.
+     */
     Message(Command command, Type type, uint16_t requestId, size_t capacity = 0) :
-      m_data(sizeof(Header), 0),
+      m_data{allocate(sizeof(Header), sizeof(Header) + (capacity != 0 ? capacity : s_sizeHint[static_cast<uint8_t>(command)].load(std::memory_order_relaxed)))},
       m_readPosition{0}
     {
       header().command = command;
       header().flags.reserved = 0;
+      header().flags.compressed = 0;
       header().flags.error = 0;
       header().flags.type = static_cast<uint8_t>(type);
       header().requestId = requestId;
       header().dataSize = 0;
-
-      if(capacity > 0)
-        m_data.reserve(sizeof(Header) + capacity);
     }
 
     Message(uint32_t size) :
-      m_data(size, 0),
+      m_data{allocate(size, 0)},
       m_readPosition{0}
     {
     }
 
     ~Message()
     {
+      if(m_data.size() >= sizeof(Header))
+      {
+        // update size hint, follows increases directly and decreases slowly:
+        auto& hint = s_sizeHint[static_cast<uint8_t>(command())];
+        const uint32_t size = dataSize();
+        const uint32_t current = hint.load(std::memory_order_relaxed);
+        hint.store(std::max(size, current - current / 16), std::memory_order_relaxed);
+      }
+      s_bufferPool.release(std::move(m_data));
     }
 
     inline std::unique_ptr<Message> response(size_t capacity = 0) const
@@ -244,6 +341,7 @@ class Message
     inline bool isResponse() const  { return type() == Type::Response; }
     inline bool isEvent() const { return type() == Type::Event; }
     inline bool isError() const { return header().flags.error; }
+    inline bool isCompressed() const { return header().flags.compressed; }
     inline uint16_t requestId() const { return header().requestId; }
 
     const void* operator*() const { return m_data.data(); }
@@ -358,7 +456,13 @@ class Message
       const size_t oldSize = m_data.size();
 
 #ifdef QT_CORE_LIB
-      if constexpr(std::is_same_v<T,QByteArray>)
+      if constexpr(std::is_same_v<T,QUuid>)
+      {
+        const QByteArray bytes = value.toRfc4122();
+        m_data.resize(oldSize + bytes.size());
+        memcpy(m_data.data() + oldSize, bytes.data(), bytes.size());
+      }
+      else if constexpr(std::is_same_v<T,QByteArray>)
       {
         m_data.resize(oldSize + sizeof(Length) + value.size());
         const Length length = value.size();